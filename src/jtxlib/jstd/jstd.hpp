@@ -1,7 +1,15 @@
 #pragma once
 #include "jtxlib.hpp"
+#include <jtxlib/util/assert.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace jstd {
 template <typename T>
@@ -65,10 +73,10 @@ public:
     const T &operator[](size_t i) const { return _data[i]; }
 
     JTX_HOSTDEV
-    T *data() { return data; }
+    T *data() { return _data; }
 
     JTX_HOSTDEV
-    const T *data() const { return data; }
+    const T *data() const { return _data; }
 
 private:
     T _data[N] = {};
@@ -225,11 +233,11 @@ public:
     JTX_HOSTDEV
     explicit span(V &v) noexcept : span(v.data(), v.size()) {};
 
-    template <typename V>
+    template <typename V, typename = std::enable_if_t<std::is_convertible_v<V *, T *>>>
     JTX_HOST
     span(std::vector<V> &v) noexcept : span(v.data(), v.size()) {};
 
-    template <typename V>
+    template <typename V, typename = std::enable_if_t<std::is_convertible_v<const V *, T *>>>
     JTX_HOST
     span(const std::vector<V> &v) noexcept : span(v.data(), v.size()) {};
 
@@ -10,4 +10,5 @@
 #include "math/transform.hpp"
 #include "math/vector.hpp"
 #include "math/dist.hpp"
-#include "math/quaternion.hpp"
\ No newline at end of file
+#include "math/quaternion.hpp"
+#include "math/half.hpp"
\ No newline at end of file
@@ -29,7 +29,7 @@ public:
     }
 
     //region Constructors
-    JTX_HOSTDEV AABB3() {
+    JTX_HOSTDEV constexpr AABB3() {
 #if defined(JTXLIB_CUDA_ENABLED)
         T minval = cuda::std::numeric_limits<T>::lowest();
         T maxval = cuda::std::numeric_limits<T>::max();
@@ -42,15 +42,15 @@ public:
         pmax = {minval, minval, minval};
     }
 
-    JTX_HOSTDEV AABB3(const Point3<T> &a, const Point3<T> &b) {
+    JTX_HOSTDEV constexpr AABB3(const Point3<T> &a, const Point3<T> &b) {
         pmin = jtx::min(a, b);
         pmax = jtx::Max(a, b);
     }
 
-    JTX_HOSTDEV explicit AABB3(const Point3<T> &p) : pmin(p), pmax(p) {
+    JTX_HOSTDEV constexpr explicit AABB3(const Point3<T> &p) : pmin(p), pmax(p) {
     }
 
-    JTX_HOSTDEV AABB3(const AABB3 &other) {
+    JTX_HOSTDEV constexpr AABB3(const AABB3 &other) {
         pmin = Point3<T>(other.pmin);
         pmax = Point3<T>(other.pmax);
     }
@@ -69,87 +69,87 @@ public:
     //endregion
 
     //region Operators
-    JTX_HOSTDEV bool operator==(const AABB3 &other) const {
+    JTX_HOSTDEV constexpr bool operator==(const AABB3 &other) const {
         return pmin == other.pmin && pmax == other.pmax;
     }
 
-    JTX_HOSTDEV bool operator!=(const AABB3 &other) const {
+    JTX_HOSTDEV constexpr bool operator!=(const AABB3 &other) const {
         return pmin != other.pmin || pmax != other.pmax;
     }
     //endregion
 
     //region Member functions
     JTX_HOSTDEV bool equals(const AABB3 &other, T epsilon) const {
-        return pmin.Equals(other.pmin, epsilon) && pmax.Equals(other.pmax, epsilon);
+        return pmin.equals(other.pmin, epsilon) && pmax.equals(other.pmax, epsilon);
     }
 
     // Modified from https://pbr-book.org/4ed/Geometry_and_Transformations/Bounding_Boxes
-    [[nodiscard]] JTX_HOSTDEV Point3<T> corner(const int i) const {
+    [[nodiscard]] JTX_HOSTDEV constexpr Point3<T> corner(const int i) const {
         ASSERT(i >= 0 && i < 8);
         return Point3<T>(i & 1 ? pmax.x : pmin.x,
                          i & 2 ? pmax.y : pmin.y,
                          i & 4 ? pmax.z : pmin.z);
     }
 
-    JTX_HOSTDEV AABB3 &merge(const Point3<T> &p) {
+    JTX_HOSTDEV constexpr AABB3 &merge(const Point3<T> &p) {
         pmin = jtx::min(pmin, p);
         pmax = jtx::Max(pmax, p);
         return *this;
     }
 
-    JTX_HOSTDEV AABB3 &merge(const AABB3 &b) {
+    JTX_HOSTDEV constexpr AABB3 &merge(const AABB3 &b) {
         pmin = jtx::min(pmin, b.pmin);
         pmax = jtx::Max(pmax, b.pmax);
         return *this;
     }
 
-    JTX_HOSTDEV bool overlaps(const AABB3 &b) const {
+    JTX_HOSTDEV constexpr bool overlaps(const AABB3 &b) const {
         return pmin.x <= b.pmax.x && pmax.x >= b.pmin.x &&
                pmin.y <= b.pmax.y && pmax.y >= b.pmin.y &&
                pmin.z <= b.pmax.z && pmax.z >= b.pmin.z;
     }
 
-    JTX_HOSTDEV bool inside(const Point3<T> &p) const {
+    JTX_HOSTDEV constexpr bool inside(const Point3<T> &p) const {
         return p.x >= pmin.x && p.x <= pmax.x &&
                p.y >= pmin.y && p.y <= pmax.y &&
                p.z >= pmin.z && p.z <= pmax.z;
     }
 
-    JTX_HOSTDEV bool insideExclusive(const Point3<T> &pt) const {
+    JTX_HOSTDEV constexpr bool insideExclusive(const Point3<T> &pt) const {
         return pt.x > pmin.x && pt.x < pmax.x &&
                pt.y > pmin.y && pt.y < pmax.y &&
                pt.z > pmin.z && pt.z < pmax.z;
     }
 
-    JTX_HOSTDEV AABB3 &expand(T delta) {
+    JTX_HOSTDEV constexpr AABB3 &expand(T delta) {
         ASSERT(delta >= 0);
         pmin -= delta;
         pmax += delta;
         return *this;
     }
 
-    JTX_HOSTDEV AABB3 &shrink(T delta) {
+    JTX_HOSTDEV constexpr AABB3 &shrink(T delta) {
         ASSERT(delta >= 0);
         pmin += delta;
         pmax -= delta;
         return *this;
     }
 
-    JTX_HOSTDEV Vec3<T> diagonal() const {
+    JTX_HOSTDEV constexpr Vec3<T> diagonal() const {
         return pmax - pmin;
     }
 
-    JTX_HOSTDEV T surfaceArea() const {
+    JTX_HOSTDEV constexpr T surfaceArea() const {
         Vec3<T> d = diagonal();
         return 2 * (d.x * d.y + d.x * d.z + d.y * d.z);
     }
 
-    JTX_HOSTDEV T volume() const {
+    JTX_HOSTDEV constexpr T volume() const {
         Vec3<T> d = diagonal();
         return d.x * d.y * d.z;
     }
 
-    [[nodiscard]] JTX_HOSTDEV int maxDim() const {
+    [[nodiscard]] JTX_HOSTDEV constexpr int maxDim() const {
         if (Vec3<T> d = diagonal(); d.x > d.y && d.x > d.z) return 0;
         else if (d.y > d.z)
             return 1;
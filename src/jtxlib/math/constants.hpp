@@ -8,20 +8,20 @@ namespace jtx {
     // TODO: expand as needed
     // Structure from https://github.com/behindthepixels/EDXUtil/
     struct Zero {
-        JTX_HOSTDEV explicit operator uint32_t() const { return 0; }
-        JTX_HOSTDEV explicit operator uint64_t() const { return 0; }
-        JTX_HOSTDEV explicit operator int32_t() const { return 0; }
-        JTX_HOSTDEV explicit operator int64_t() const { return 0; }
-        JTX_HOSTDEV explicit operator float() const { return 0.0f; }
-        JTX_HOSTDEV explicit operator double() const { return 0.0; }
+        JTX_HOSTDEV constexpr explicit operator uint32_t() const { return 0; }
+        JTX_HOSTDEV constexpr explicit operator uint64_t() const { return 0; }
+        JTX_HOSTDEV constexpr explicit operator int32_t() const { return 0; }
+        JTX_HOSTDEV constexpr explicit operator int64_t() const { return 0; }
+        JTX_HOSTDEV constexpr explicit operator float() const { return 0.0f; }
+        JTX_HOSTDEV constexpr explicit operator double() const { return 0.0; }
 
         template<typename T>
-        JTX_HOSTDEV bool operator==(const T &other) const {
+        JTX_HOSTDEV constexpr bool operator==(const T &other) const {
             return static_cast<T>(*this) == other;
         }
 
         template<typename T>
-        JTX_HOSTDEV bool operator!=(const T &other) const {
+        JTX_HOSTDEV constexpr bool operator!=(const T &other) const {
             return static_cast<T>(*this) != other;
         }
     };
@@ -48,5 +48,9 @@ namespace jtx {
     constexpr double JTX_NEG_INFINITY_D = -std::numeric_limits<double>::infinity();
     constexpr float JTX_EPSILON = 0.00001f;
     constexpr float JTX_ONE_MINUS_EPSILON = 0x1.fffffep-1;
+    constexpr float JTX_MAX_F = std::numeric_limits<float>::max();
+    constexpr float JTX_LOWEST_F = std::numeric_limits<float>::lowest();
+    constexpr float JTX_MIN_NORMAL_F = std::numeric_limits<float>::min();
+    constexpr float JTX_NAN_F = std::numeric_limits<float>::quiet_NaN();
 #endif
 }
@@ -0,0 +1,223 @@
+/**
+ * 16-bit floating point storage types
+ *
+ * Half is IEEE binary16 (1 sign, 5 exponent, 10 mantissa bits): ~3 decimal digits over [6e-8, 65504], good for
+ * normals, colors and most vertex attributes. BFloat16 keeps the full float exponent range with 7 mantissa bits,
+ * so it never overflows but is much coarser.
+ *
+ * Neither type does arithmetic, convert to float first. Conversions round to nearest even and keep infinities.
+ * NaNs stay NaN with the top payload bits; like F16C, half conversions also quiet signaling NaNs. The batch
+ * conversions go through simdKernels(), which uses F16C when the CPU has it and produces the same bits as the
+ * scalar conversions either way.
+ */
+#pragma once
+
+#include <jtxlib/jstd/jstd.hpp>
+#include <jtxlib/math/numerical.hpp>
+#include <jtxlib/math/vec3.hpp>
+#include <jtxlib/math/vec4.hpp>
+#include <jtxlib/simd/kernels.hpp>
+
+#include <cstdint>
+
+namespace jtx {
+//region Bit conversions
+// From "float->half variants" by Fabian Giesen, https://gist.github.com/rygorous/2156668
+// simd/simdhalf.hpp does the same steps lane-wise
+JTX_HOST JTX_INLINE uint16_t floatToHalfBits(float f) {
+    uint32_t bits = floatToBits(f);
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t h;
+    if (bits >= 0x47800000u) {
+        // Overflows a half (>= 65536), NaNs keep the top of their payload
+        h = bits > 0x7F800000u ? 0x7E00u | ((bits >> 13) & 0x3FFu) : 0x7C00u;
+    } else if (bits < 0x38800000u) {
+        // Denormal or zero half (< 2^-14): adding 0.5 lines the mantissa up so the FPU rounds for us
+        h = floatToBits(bitsToFloat(bits) + 0.5f) - 0x3F000000u;
+    } else {
+        // Rebias the exponent and round to nearest even, a carry out of the mantissa bumps the exponent
+        const uint32_t mantissaOdd = (bits >> 13) & 1u;
+        bits += 0xC8000FFFu + mantissaOdd;
+        h = bits >> 13;
+    }
+    return static_cast<uint16_t>(h | (sign >> 16));
+}
+
+JTX_HOST JTX_INLINE float halfBitsToFloat(uint16_t h) {
+    uint32_t bits = static_cast<uint32_t>(h & 0x7FFFu) << 13;
+    const uint32_t exponent = bits & 0x0F800000u;
+    bits += 0x38000000u;
+    if (exponent == 0x0F800000u) {
+        // Inf or NaN
+        bits += 0x38000000u;
+        if (h & 0x3FFu) bits |= 0x00400000u;
+    } else if (exponent == 0) {
+        // Denormal half, renormalize through the FPU
+        bits = floatToBits(bitsToFloat(bits + 0x00800000u) - bitsToFloat(0x38800000u));
+    }
+    return bitsToFloat(bits | (static_cast<uint32_t>(h & 0x8000u) << 16));
+}
+
+JTX_HOST JTX_INLINE uint16_t floatToBFloat16Bits(float f) {
+    uint32_t bits = floatToBits(f);
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        return static_cast<uint16_t>((bits >> 16) | 0x40u);
+    }
+    bits += 0x7FFFu + ((bits >> 16) & 1u);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+JTX_HOST JTX_INLINE float bfloat16BitsToFloat(uint16_t b) {
+    return bitsToFloat(static_cast<uint32_t>(b) << 16);
+}
+//endregion
+
+class Half {
+public:
+    Half() = default;
+
+    JTX_HOST explicit Half(float f) : h(floatToHalfBits(f)) {}
+
+    JTX_HOST static Half fromBits(uint16_t bits) {
+        Half res;
+        res.h = bits;
+        return res;
+    }
+
+    [[nodiscard]] JTX_HOST uint16_t bits() const { return h; }
+
+    JTX_HOST explicit operator float() const { return halfBitsToFloat(h); }
+
+    // Same semantics as float: NaN != NaN and -0 == +0
+    JTX_HOST bool operator==(const Half &other) const { return float(*this) == float(other); }
+
+    JTX_HOST bool operator!=(const Half &other) const { return !(*this == other); }
+
+    JTX_HOST Half operator-() const { return fromBits(h ^ 0x8000u); }
+
+    [[nodiscard]] JTX_HOST bool isNaN() const { return (h & 0x7FFFu) > 0x7C00u; }
+
+    [[nodiscard]] JTX_HOST bool isInf() const { return (h & 0x7FFFu) == 0x7C00u; }
+
+private:
+    uint16_t h = 0;
+};
+
+class BFloat16 {
+public:
+    BFloat16() = default;
+
+    JTX_HOST explicit BFloat16(float f) : b(floatToBFloat16Bits(f)) {}
+
+    JTX_HOST static BFloat16 fromBits(uint16_t bits) {
+        BFloat16 res;
+        res.b = bits;
+        return res;
+    }
+
+    [[nodiscard]] JTX_HOST uint16_t bits() const { return b; }
+
+    JTX_HOST explicit operator float() const { return bfloat16BitsToFloat(b); }
+
+    JTX_HOST bool operator==(const BFloat16 &other) const { return float(*this) == float(other); }
+
+    JTX_HOST bool operator!=(const BFloat16 &other) const { return !(*this == other); }
+
+    JTX_HOST BFloat16 operator-() const { return fromBits(b ^ 0x8000u); }
+
+    [[nodiscard]] JTX_HOST bool isNaN() const { return (b & 0x7FFFu) > 0x7F80u; }
+
+    [[nodiscard]] JTX_HOST bool isInf() const { return (b & 0x7FFFu) == 0x7F80u; }
+
+private:
+    uint16_t b = 0;
+};
+
+// Storage only, convert to Vec3f/Vec4f to do math
+struct Vec3h {
+    Half x, y, z;
+
+    Vec3h() = default;
+
+    JTX_HOST Vec3h(Half x, Half y, Half z) : x(x), y(y), z(z) {}
+
+    JTX_HOST explicit Vec3h(const Vec3f &v) : x(v.x), y(v.y), z(v.z) {}
+
+    JTX_HOST explicit operator Vec3f() const { return {float(x), float(y), float(z)}; }
+
+    JTX_HOST bool operator==(const Vec3h &other) const { return x == other.x && y == other.y && z == other.z; }
+
+    JTX_HOST bool operator!=(const Vec3h &other) const { return !(*this == other); }
+};
+
+struct Vec4h {
+    Half x, y, z, w;
+
+    Vec4h() = default;
+
+    JTX_HOST Vec4h(Half x, Half y, Half z, Half w) : x(x), y(y), z(z), w(w) {}
+
+    JTX_HOST explicit Vec4h(const Vec4f &v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+    JTX_HOST explicit operator Vec4f() const { return {float(x), float(y), float(z), float(w)}; }
+
+    JTX_HOST bool operator==(const Vec4h &other) const {
+        return x == other.x && y == other.y && z == other.z && w == other.w;
+    }
+
+    JTX_HOST bool operator!=(const Vec4h &other) const { return !(*this == other); }
+};
+
+static_assert(sizeof(Half) == 2 && sizeof(BFloat16) == 2, "16-bit types must be tightly packed");
+static_assert(sizeof(Vec3h) == 3 * sizeof(Half) && sizeof(Vec4h) == 4 * sizeof(Half),
+              "Batch conversions treat Vec3h/Vec4h arrays as arrays of Half");
+
+//region Batch conversions
+// out must be at least as long as in
+JTX_HOST JTX_INLINE void toHalf(jstd::span<const float> in, jstd::span<Half> out) {
+    ASSERT(out.size() >= in.size());
+    simdKernels().floatToHalf(in.data(), reinterpret_cast<uint16_t *>(out.data()), in.size());
+}
+
+JTX_HOST JTX_INLINE void toFloat(jstd::span<const Half> in, jstd::span<float> out) {
+    ASSERT(out.size() >= in.size());
+    simdKernels().halfToFloat(reinterpret_cast<const uint16_t *>(in.data()), out.data(), in.size());
+}
+
+JTX_HOST JTX_INLINE void toHalf(jstd::span<const Vec3f> in, jstd::span<Vec3h> out) {
+    ASSERT(out.size() >= in.size());
+    auto src = reinterpret_cast<const float *>(in.data());
+    simdKernels().floatToHalf(src, reinterpret_cast<uint16_t *>(out.data()), 3 * in.size());
+}
+
+JTX_HOST JTX_INLINE void toFloat(jstd::span<const Vec3h> in, jstd::span<Vec3f> out) {
+    ASSERT(out.size() >= in.size());
+    auto src = reinterpret_cast<const uint16_t *>(in.data());
+    simdKernels().halfToFloat(src, reinterpret_cast<float *>(out.data()), 3 * in.size());
+}
+
+JTX_HOST JTX_INLINE void toHalf(jstd::span<const Vec4f> in, jstd::span<Vec4h> out) {
+    ASSERT(out.size() >= in.size());
+    auto src = reinterpret_cast<const float *>(in.data());
+    simdKernels().floatToHalf(src, reinterpret_cast<uint16_t *>(out.data()), 4 * in.size());
+}
+
+JTX_HOST JTX_INLINE void toFloat(jstd::span<const Vec4h> in, jstd::span<Vec4f> out) {
+    ASSERT(out.size() >= in.size());
+    auto src = reinterpret_cast<const uint16_t *>(in.data());
+    simdKernels().halfToFloat(src, reinterpret_cast<float *>(out.data()), 4 * in.size());
+}
+
+JTX_HOST JTX_INLINE void toBFloat16(jstd::span<const float> in, jstd::span<BFloat16> out) {
+    ASSERT(out.size() >= in.size());
+    simdKernels().floatToBFloat16(in.data(), reinterpret_cast<uint16_t *>(out.data()), in.size());
+}
+
+JTX_HOST JTX_INLINE void toFloat(jstd::span<const BFloat16> in, jstd::span<float> out) {
+    ASSERT(out.size() >= in.size());
+    simdKernels().bfloat16ToFloat(reinterpret_cast<const uint16_t *>(in.data()), out.data(), in.size());
+}
+//endregion
+}// namespace jtx
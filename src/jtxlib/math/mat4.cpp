@@ -3,26 +3,32 @@
 #include <jtxlib/math/vec3.hpp>
 #include <jtxlib/math/vecmath.hpp>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#define JTX_MAT4_SSE
+#include <immintrin.h>
+#endif
+
 namespace jtx {
-    JTX_HOSTDEV float jtx::Mat4::determinant() const {
-        float s0 = jtx::dop(data[0][0], data[1][1], data[1][0], data[0][1]);
-        float s1 = jtx::dop(data[0][0], data[1][2], data[1][0], data[0][2]);
-        float s2 = jtx::dop(data[0][0], data[1][3], data[1][0], data[0][3]);
+    template<typename P>
+    JTX_HOSTDEV float Mat4::determinant() const {
+        float s0 = jtx::differenceOfProducts<P>(data[0][0], data[1][1], data[1][0], data[0][1]);
+        float s1 = jtx::differenceOfProducts<P>(data[0][0], data[1][2], data[1][0], data[0][2]);
+        float s2 = jtx::differenceOfProducts<P>(data[0][0], data[1][3], data[1][0], data[0][3]);
 
-        float s3 = jtx::dop(data[0][1], data[1][2], data[1][1], data[0][2]);
-        float s4 = jtx::dop(data[0][1], data[1][3], data[1][1], data[0][3]);
-        float s5 = jtx::dop(data[0][2], data[1][3], data[1][2], data[0][3]);
+        float s3 = jtx::differenceOfProducts<P>(data[0][1], data[1][2], data[1][1], data[0][2]);
+        float s4 = jtx::differenceOfProducts<P>(data[0][1], data[1][3], data[1][1], data[0][3]);
+        float s5 = jtx::differenceOfProducts<P>(data[0][2], data[1][3], data[1][2], data[0][3]);
 
-        float c0 = jtx::dop(data[2][0], data[3][1], data[3][0], data[2][1]);
-        float c1 = jtx::dop(data[2][0], data[3][2], data[3][0], data[2][2]);
-        float c2 = jtx::dop(data[2][0], data[3][3], data[3][0], data[2][3]);
+        float c0 = jtx::differenceOfProducts<P>(data[2][0], data[3][1], data[3][0], data[2][1]);
+        float c1 = jtx::differenceOfProducts<P>(data[2][0], data[3][2], data[3][0], data[2][2]);
+        float c2 = jtx::differenceOfProducts<P>(data[2][0], data[3][3], data[3][0], data[2][3]);
 
-        float c3 = jtx::dop(data[2][1], data[3][2], data[3][1], data[2][2]);
-        float c4 = jtx::dop(data[2][1], data[3][3], data[3][1], data[2][3]);
-        float c5 = jtx::dop(data[2][2], data[3][3], data[3][2], data[2][3]);
+        float c3 = jtx::differenceOfProducts<P>(data[2][1], data[3][2], data[3][1], data[2][2]);
+        float c4 = jtx::differenceOfProducts<P>(data[2][1], data[3][3], data[3][1], data[2][3]);
+        float c5 = jtx::differenceOfProducts<P>(data[2][2], data[3][3], data[3][2], data[2][3]);
 
-        return jtx::dop(s0, c5, s1, c4) + jtx::dop(s2, c3, -s3, c2) +
-               jtx::dop(s5, c0, s4, c1);
+        return jtx::differenceOfProducts<P>(s0, c5, s1, c4) + jtx::differenceOfProducts<P>(s2, c3, -s3, c2) +
+               jtx::differenceOfProducts<P>(s5, c0, s4, c1);
     }
 
     float Mat4::determinant3x3() const {
@@ -34,94 +40,249 @@ namespace jtx {
 
     // Avoid using this if possible
 #if defined(JTXLIB_CUDA_ENABLED)
-    JTX_HOSTDEV cuda::std::optional<Mat4> inverse() const {
-        float s0 = jtx::dop(data[0][0], data[1][1], data[1][0], data[0][1]);
-        float s1 = jtx::dop(data[0][0], data[1][2], data[1][0], data[0][2]);
-        float s2 = jtx::dop(data[0][0], data[1][3], data[1][0], data[0][3]);
+    template<typename P>
+    JTX_HOSTDEV cuda::std::optional<Mat4> Mat4::inverse() const {
+        float s0 = jtx::differenceOfProducts<P>(data[0][0], data[1][1], data[1][0], data[0][1]);
+        float s1 = jtx::differenceOfProducts<P>(data[0][0], data[1][2], data[1][0], data[0][2]);
+        float s2 = jtx::differenceOfProducts<P>(data[0][0], data[1][3], data[1][0], data[0][3]);
 
-        float s3 = jtx::dop(data[0][1], data[1][2], data[1][1], data[0][2]);
-        float s4 = jtx::dop(data[0][1], data[1][3], data[1][1], data[0][3]);
-        float s5 = jtx::dop(data[0][2], data[1][3], data[1][2], data[0][3]);
+        float s3 = jtx::differenceOfProducts<P>(data[0][1], data[1][2], data[1][1], data[0][2]);
+        float s4 = jtx::differenceOfProducts<P>(data[0][1], data[1][3], data[1][1], data[0][3]);
+        float s5 = jtx::differenceOfProducts<P>(data[0][2], data[1][3], data[1][2], data[0][3]);
 
-        float c0 = jtx::dop(data[2][0], data[3][1], data[3][0], data[2][1]);
-        float c1 = jtx::dop(data[2][0], data[3][2], data[3][0], data[2][2]);
-        float c2 = jtx::dop(data[2][0], data[3][3], data[3][0], data[2][3]);
+        float c0 = jtx::differenceOfProducts<P>(data[2][0], data[3][1], data[3][0], data[2][1]);
+        float c1 = jtx::differenceOfProducts<P>(data[2][0], data[3][2], data[3][0], data[2][2]);
+        float c2 = jtx::differenceOfProducts<P>(data[2][0], data[3][3], data[3][0], data[2][3]);
 
-        float c3 = jtx::dop(data[2][1], data[3][2], data[3][1], data[2][2]);
-        float c4 = jtx::dop(data[2][1], data[3][3], data[3][1], data[2][3]);
-        float c5 = jtx::dop(data[2][2], data[3][3], data[3][2], data[2][3]);
+        float c3 = jtx::differenceOfProducts<P>(data[2][1], data[3][2], data[3][1], data[2][2]);
+        float c4 = jtx::differenceOfProducts<P>(data[2][1], data[3][3], data[3][1], data[2][3]);
+        float c5 = jtx::differenceOfProducts<P>(data[2][2], data[3][3], data[3][2], data[2][3]);
 
-        float det = jtx::dop(s0, c5, s1, c4) + jtx::dop(s2, c3, -s3, c2) +
-                    jtx::dop(s5, c0, s4, c1);
+        float det = jtx::differenceOfProducts<P>(s0, c5, s1, c4) + jtx::differenceOfProducts<P>(s2, c3, -s3, c2) +
+                    jtx::differenceOfProducts<P>(s5, c0, s4, c1);
         if (det == 0.0f) {
             return {};
         }
 
         float invDet = 1.0f / det;
 
-        return {{invDet * jtx::innerProd(data[1][1], c5, data[1][3], c3, -data[1][2], c4),
-                 invDet * jtx::innerProd(-data[0][1], c5, data[0][2], c4, -data[0][3], c3),
-                 invDet * jtx::innerProd(data[3][1], s5, data[3][3], s3, -data[3][2], s4),
-                 invDet * jtx::innerProd(-data[2][1], s5, data[2][2], s4, -data[2][3], s3),
-                 invDet * jtx::innerProd(-data[1][0], c5, data[1][2], c2, -data[1][3], c1),
-                 invDet * jtx::innerProd(data[0][0], c5, data[0][3], c1, -data[0][2], c2),
-                 invDet * jtx::innerProd(-data[3][0], s5, data[3][2], s2, -data[3][3], s1),
-                 invDet * jtx::innerProd(data[2][0], s5, data[2][3], s1, -data[2][2], s2),
-                 invDet * jtx::innerProd(data[1][0], c4, data[1][3], c0, -data[1][1], c2),
-                 invDet * jtx::innerProd(-data[0][0], c4, data[0][1], c2, -data[0][3], c0),
-                 invDet * jtx::innerProd(data[3][0], s4, data[3][3], s0, -data[3][1], s2),
-                 invDet * jtx::innerProd(-data[2][0], s4, data[2][1], s2, -data[2][3], s0),
-                 invDet * jtx::innerProd(-data[1][0], c3, data[1][1], c1, -data[1][2], c0),
-                 invDet * jtx::innerProd(data[0][0], c3, data[0][2], c0, -data[0][1], c1),
-                 invDet * jtx::innerProd(-data[3][0], s3, data[3][1], s1, -data[3][2], s0),
-                 invDet * jtx::innerProd(data[2][0], s3, data[2][2], s0, -data[2][1], s1)}};
+        return {{invDet * jtx::sumOfProducts<P>(data[1][1], c5, data[1][3], c3, -data[1][2], c4),
+                 invDet * jtx::sumOfProducts<P>(-data[0][1], c5, data[0][2], c4, -data[0][3], c3),
+                 invDet * jtx::sumOfProducts<P>(data[3][1], s5, data[3][3], s3, -data[3][2], s4),
+                 invDet * jtx::sumOfProducts<P>(-data[2][1], s5, data[2][2], s4, -data[2][3], s3),
+                 invDet * jtx::sumOfProducts<P>(-data[1][0], c5, data[1][2], c2, -data[1][3], c1),
+                 invDet * jtx::sumOfProducts<P>(data[0][0], c5, data[0][3], c1, -data[0][2], c2),
+                 invDet * jtx::sumOfProducts<P>(-data[3][0], s5, data[3][2], s2, -data[3][3], s1),
+                 invDet * jtx::sumOfProducts<P>(data[2][0], s5, data[2][3], s1, -data[2][2], s2),
+                 invDet * jtx::sumOfProducts<P>(data[1][0], c4, data[1][3], c0, -data[1][1], c2),
+                 invDet * jtx::sumOfProducts<P>(-data[0][0], c4, data[0][1], c2, -data[0][3], c0),
+                 invDet * jtx::sumOfProducts<P>(data[3][0], s4, data[3][3], s0, -data[3][1], s2),
+                 invDet * jtx::sumOfProducts<P>(-data[2][0], s4, data[2][1], s2, -data[2][3], s0),
+                 invDet * jtx::sumOfProducts<P>(-data[1][0], c3, data[1][1], c1, -data[1][2], c0),
+                 invDet * jtx::sumOfProducts<P>(data[0][0], c3, data[0][2], c0, -data[0][1], c1),
+                 invDet * jtx::sumOfProducts<P>(-data[3][0], s3, data[3][1], s1, -data[3][2], s0),
+                 invDet * jtx::sumOfProducts<P>(data[2][0], s3, data[2][2], s0, -data[2][1], s1)}};
     }
 
 #else
 
-    JTX_HOST std::optional<jtx::Mat4> jtx::Mat4::inverse() const {
-        float s0 = jtx::dop(data[0][0], data[1][1], data[1][0], data[0][1]);
-        float s1 = jtx::dop(data[0][0], data[1][2], data[1][0], data[0][2]);
-        float s2 = jtx::dop(data[0][0], data[1][3], data[1][0], data[0][3]);
+    template<typename P>
+    JTX_HOST std::optional<Mat4> Mat4::inverse() const {
+        float s0 = jtx::differenceOfProducts<P>(data[0][0], data[1][1], data[1][0], data[0][1]);
+        float s1 = jtx::differenceOfProducts<P>(data[0][0], data[1][2], data[1][0], data[0][2]);
+        float s2 = jtx::differenceOfProducts<P>(data[0][0], data[1][3], data[1][0], data[0][3]);
 
-        float s3 = jtx::dop(data[0][1], data[1][2], data[1][1], data[0][2]);
-        float s4 = jtx::dop(data[0][1], data[1][3], data[1][1], data[0][3]);
-        float s5 = jtx::dop(data[0][2], data[1][3], data[1][2], data[0][3]);
+        float s3 = jtx::differenceOfProducts<P>(data[0][1], data[1][2], data[1][1], data[0][2]);
+        float s4 = jtx::differenceOfProducts<P>(data[0][1], data[1][3], data[1][1], data[0][3]);
+        float s5 = jtx::differenceOfProducts<P>(data[0][2], data[1][3], data[1][2], data[0][3]);
 
-        float c0 = jtx::dop(data[2][0], data[3][1], data[3][0], data[2][1]);
-        float c1 = jtx::dop(data[2][0], data[3][2], data[3][0], data[2][2]);
-        float c2 = jtx::dop(data[2][0], data[3][3], data[3][0], data[2][3]);
+        float c0 = jtx::differenceOfProducts<P>(data[2][0], data[3][1], data[3][0], data[2][1]);
+        float c1 = jtx::differenceOfProducts<P>(data[2][0], data[3][2], data[3][0], data[2][2]);
+        float c2 = jtx::differenceOfProducts<P>(data[2][0], data[3][3], data[3][0], data[2][3]);
 
-        float c3 = jtx::dop(data[2][1], data[3][2], data[3][1], data[2][2]);
-        float c4 = jtx::dop(data[2][1], data[3][3], data[3][1], data[2][3]);
-        float c5 = jtx::dop(data[2][2], data[3][3], data[3][2], data[2][3]);
+        float c3 = jtx::differenceOfProducts<P>(data[2][1], data[3][2], data[3][1], data[2][2]);
+        float c4 = jtx::differenceOfProducts<P>(data[2][1], data[3][3], data[3][1], data[2][3]);
+        float c5 = jtx::differenceOfProducts<P>(data[2][2], data[3][3], data[3][2], data[2][3]);
 
-        float det = jtx::dop(s0, c5, s1, c4) + jtx::dop(s2, c3, -s3, c2) +
-                    jtx::dop(s5, c0, s4, c1);
+        float det = jtx::differenceOfProducts<P>(s0, c5, s1, c4) + jtx::differenceOfProducts<P>(s2, c3, -s3, c2) +
+                    jtx::differenceOfProducts<P>(s5, c0, s4, c1);
         if (det == 0.0f) {
             return {};
         }
 
         float invDet = 1.0f / det;
 
-        return {{invDet * jtx::innerProd(data[1][1], c5, data[1][3], c3, -data[1][2], c4),
-                 invDet * jtx::innerProd(-data[0][1], c5, data[0][2], c4, -data[0][3], c3),
-                 invDet * jtx::innerProd(data[3][1], s5, data[3][3], s3, -data[3][2], s4),
-                 invDet * jtx::innerProd(-data[2][1], s5, data[2][2], s4, -data[2][3], s3),
-                 invDet * jtx::innerProd(-data[1][0], c5, data[1][2], c2, -data[1][3], c1),
-                 invDet * jtx::innerProd(data[0][0], c5, data[0][3], c1, -data[0][2], c2),
-                 invDet * jtx::innerProd(-data[3][0], s5, data[3][2], s2, -data[3][3], s1),
-                 invDet * jtx::innerProd(data[2][0], s5, data[2][3], s1, -data[2][2], s2),
-                 invDet * jtx::innerProd(data[1][0], c4, data[1][3], c0, -data[1][1], c2),
-                 invDet * jtx::innerProd(-data[0][0], c4, data[0][1], c2, -data[0][3], c0),
-                 invDet * jtx::innerProd(data[3][0], s4, data[3][3], s0, -data[3][1], s2),
-                 invDet * jtx::innerProd(-data[2][0], s4, data[2][1], s2, -data[2][3], s0),
-                 invDet * jtx::innerProd(-data[1][0], c3, data[1][1], c1, -data[1][2], c0),
-                 invDet * jtx::innerProd(data[0][0], c3, data[0][2], c0, -data[0][1], c1),
-                 invDet * jtx::innerProd(-data[3][0], s3, data[3][1], s1, -data[3][2], s0),
-                 invDet * jtx::innerProd(data[2][0], s3, data[2][2], s0, -data[2][1], s1)}};
+        return {{invDet * jtx::sumOfProducts<P>(data[1][1], c5, data[1][3], c3, -data[1][2], c4),
+                 invDet * jtx::sumOfProducts<P>(-data[0][1], c5, data[0][2], c4, -data[0][3], c3),
+                 invDet * jtx::sumOfProducts<P>(data[3][1], s5, data[3][3], s3, -data[3][2], s4),
+                 invDet * jtx::sumOfProducts<P>(-data[2][1], s5, data[2][2], s4, -data[2][3], s3),
+                 invDet * jtx::sumOfProducts<P>(-data[1][0], c5, data[1][2], c2, -data[1][3], c1),
+                 invDet * jtx::sumOfProducts<P>(data[0][0], c5, data[0][3], c1, -data[0][2], c2),
+                 invDet * jtx::sumOfProducts<P>(-data[3][0], s5, data[3][2], s2, -data[3][3], s1),
+                 invDet * jtx::sumOfProducts<P>(data[2][0], s5, data[2][3], s1, -data[2][2], s2),
+                 invDet * jtx::sumOfProducts<P>(data[1][0], c4, data[1][3], c0, -data[1][1], c2),
+                 invDet * jtx::sumOfProducts<P>(-data[0][0], c4, data[0][1], c2, -data[0][3], c0),
+                 invDet * jtx::sumOfProducts<P>(data[3][0], s4, data[3][3], s0, -data[3][1], s2),
+                 invDet * jtx::sumOfProducts<P>(-data[2][0], s4, data[2][1], s2, -data[2][3], s0),
+                 invDet * jtx::sumOfProducts<P>(-data[1][0], c3, data[1][1], c1, -data[1][2], c0),
+                 invDet * jtx::sumOfProducts<P>(data[0][0], c3, data[0][2], c0, -data[0][1], c1),
+                 invDet * jtx::sumOfProducts<P>(-data[3][0], s3, data[3][1], s1, -data[3][2], s0),
+                 invDet * jtx::sumOfProducts<P>(data[2][0], s3, data[2][2], s0, -data[2][1], s1)}};
+    }
+#endif
+
+    template float Mat4::determinant<Precise>() const;
+    template float Mat4::determinant<Fast>() const;
+#if defined(JTXLIB_CUDA_ENABLED)
+    template cuda::std::optional<Mat4> Mat4::inverse<Precise>() const;
+    template cuda::std::optional<Mat4> Mat4::inverse<Fast>() const;
+#else
+    template std::optional<Mat4> Mat4::inverse<Precise>() const;
+    template std::optional<Mat4> Mat4::inverse<Fast>() const;
+#endif
+
+#if defined(JTX_MAT4_SSE)
+    namespace {
+        JTX_INLINE __m128 loadRow(const float *row) {
+#if defined(JTXLIB_ALIGN_MAT4)
+            return _mm_load_ps(row);
+#else
+            return _mm_loadu_ps(row);
+#endif
+        }
+
+        JTX_INLINE void storeRow(float *row, __m128 v) {
+#if defined(JTXLIB_ALIGN_MAT4)
+            _mm_store_ps(row, v);
+#else
+            _mm_storeu_ps(row, v);
+#endif
+        }
+
+        JTX_INLINE __m128 madd(__m128 a, __m128 b, __m128 c) {
+#if defined(__FMA__)
+            return _mm_fmadd_ps(a, b, c);
+#else
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+        }
+
+        // (a[x], a[y], b[z], b[w])
+        template<int x, int y, int z, int w>
+        JTX_INLINE __m128 shuffle(__m128 a, __m128 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x)); }
+
+        template<int x, int y, int z, int w>
+        JTX_INLINE __m128 swizzle(__m128 v) { return shuffle<x, y, z, w>(v, v); }
+
+        // 2x2 blocks are packed row-major into one register as (m00, m01, m10, m11)
+
+        // A * B
+        JTX_INLINE __m128 mat2Mul(__m128 a, __m128 b) {
+            return madd(a, swizzle<0, 3, 0, 3>(b), _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+        }
+
+        // adj(A) * B
+        JTX_INLINE __m128 mat2AdjMul(__m128 a, __m128 b) {
+            return _mm_sub_ps(_mm_mul_ps(swizzle<3, 3, 0, 0>(a), b),
+                              _mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+        }
+
+        // A * adj(B)
+        JTX_INLINE __m128 mat2MulAdj(__m128 a, __m128 b) {
+            return _mm_sub_ps(_mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)),
+                              _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+        }
+    }// namespace
+#endif
+
+    JTX_HOST Mat4 Mat4::mulFast(const Mat4 &mat) const {
+        Mat4 res;
+#if defined(JTX_MAT4_SSE)
+        const __m128 b0 = loadRow(mat.data[0]);
+        const __m128 b1 = loadRow(mat.data[1]);
+        const __m128 b2 = loadRow(mat.data[2]);
+        const __m128 b3 = loadRow(mat.data[3]);
+        for (int i = 0; i < 4; ++i) {
+            // Row i of the product is a linear combination of the rows of mat
+            __m128 r = _mm_mul_ps(_mm_set1_ps(data[i][0]), b0);
+            r = madd(_mm_set1_ps(data[i][1]), b1, r);
+            r = madd(_mm_set1_ps(data[i][2]), b2, r);
+            r = madd(_mm_set1_ps(data[i][3]), b3, r);
+            storeRow(res.data[i], r);
+        }
+#else
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                float r = data[i][0] * mat.data[0][j];
+                r = jtx::mulAdd(data[i][1], mat.data[1][j], r);
+                r = jtx::mulAdd(data[i][2], mat.data[2][j], r);
+                res.data[i][j] = jtx::mulAdd(data[i][3], mat.data[3][j], r);
+            }
+        }
+#endif
+        return res;
     }
+
+    /**
+     * Block-wise adjugate inverse. With M = [A B; C D] split into 2x2 blocks, every block of adj(M) and det(M)
+     * can be built from 2x2 products and adjugates, which map onto a handful of shuffles each. See
+     * https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+     */
+    JTX_HOST std::optional<Mat4> Mat4::inverseFast() const {
+#if defined(JTX_MAT4_SSE)
+        const __m128 r0 = loadRow(data[0]);
+        const __m128 r1 = loadRow(data[1]);
+        const __m128 r2 = loadRow(data[2]);
+        const __m128 r3 = loadRow(data[3]);
+
+        const __m128 A = _mm_movelh_ps(r0, r1);
+        const __m128 B = _mm_movehl_ps(r1, r0);
+        const __m128 C = _mm_movelh_ps(r2, r3);
+        const __m128 D = _mm_movehl_ps(r3, r2);
+
+        // (|A|, |B|, |C|, |D|)
+        const __m128 detSub = _mm_sub_ps(_mm_mul_ps(shuffle<0, 2, 0, 2>(r0, r2), shuffle<1, 3, 1, 3>(r1, r3)),
+                                         _mm_mul_ps(shuffle<1, 3, 1, 3>(r0, r2), shuffle<0, 2, 0, 2>(r1, r3)));
+        const __m128 detA = swizzle<0, 0, 0, 0>(detSub);
+        const __m128 detB = swizzle<1, 1, 1, 1>(detSub);
+        const __m128 detC = swizzle<2, 2, 2, 2>(detSub);
+        const __m128 detD = swizzle<3, 3, 3, 3>(detSub);
+
+        const __m128 D_C = mat2AdjMul(D, C);
+        const __m128 A_B = mat2AdjMul(A, B);
+
+        // Adjugates of the blocks of the inverse
+        __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, D_C));
+        __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, A_B));
+        __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, A_B));
+        __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, D_C));
+
+        // |M| = |A||D| + |B||C| - tr(adj(A) B adj(D) C)
+        __m128 tr = _mm_mul_ps(A_B, swizzle<0, 2, 1, 3>(D_C));
+        tr = _mm_add_ps(tr, swizzle<1, 0, 3, 2>(tr));
+        tr = _mm_add_ps(tr, swizzle<2, 3, 0, 1>(tr));
+        const __m128 detM = _mm_sub_ps(madd(detA, detD, _mm_mul_ps(detB, detC)), tr);
+        if (_mm_cvtss_f32(detM) == 0.0f) {
+            return {};
+        }
+
+        // The sign pattern turns each block adjugate back into the block itself
+        const __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+        X = _mm_mul_ps(X, rDetM);
+        Y = _mm_mul_ps(Y, rDetM);
+        Z = _mm_mul_ps(Z, rDetM);
+        W = _mm_mul_ps(W, rDetM);
+
+        Mat4 res;
+        storeRow(res.data[0], shuffle<3, 1, 3, 1>(X, Y));
+        storeRow(res.data[1], shuffle<2, 0, 2, 0>(X, Y));
+        storeRow(res.data[2], shuffle<3, 1, 3, 1>(Z, W));
+        storeRow(res.data[3], shuffle<2, 0, 2, 0>(Z, W));
+        return res;
+#else
+        return inverse<Fast>();
 #endif
+    }
 
 
     JTX_HOSTDEV Mat4 rotate(float sinTheta, float cosTheta, const Vec3f &axis) {
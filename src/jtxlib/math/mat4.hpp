@@ -16,12 +16,19 @@
 #include <cuda/std/span>
 #endif
 
+// Every translation unit has to agree on this, so it's set through the JTXLIB_ALIGN_MAT4 CMake option
+#if defined(JTXLIB_ALIGN_MAT4)
+#define JTX_MAT4_ALIGN alignas(16)
+#else
+#define JTX_MAT4_ALIGN
+#endif
+
 namespace jtx {
-class Mat4 {
+class JTX_MAT4_ALIGN Mat4 {
 public:
     float data[4][4];
     //region Constructors
-    JTX_HOSTDEV Mat4() {
+    JTX_HOSTDEV constexpr Mat4() {
         for (auto &i: data) {
             for (float &j: i) {
                 j = 0.0f;
@@ -29,7 +36,7 @@ public:
         }
     }
 
-    JTX_HOSTDEV explicit Mat4(const float diag) {
+    JTX_HOSTDEV constexpr explicit Mat4(const float diag) {
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
                 data[i][j] = (i == j) ? diag : 0.0f;
@@ -37,7 +44,7 @@ public:
         }
     }
 
-    JTX_HOSTDEV Mat4(const Mat4 &mat) {
+    JTX_HOSTDEV constexpr Mat4(const Mat4 &mat) {
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
                 data[i][j] = mat[i][j];
@@ -45,7 +52,7 @@ public:
         }
     }
 
-    JTX_HOSTDEV Mat4(const float m00, const float m01, const float m02, const float m03,
+    JTX_HOSTDEV constexpr Mat4(const float m00, const float m01, const float m02, const float m03,
                      const float m10, const float m11, const float m12, const float m13,
                      const float m20, const float m21, const float m22, const float m23,
                      const float m30, const float m31, const float m32, const float m33) {
@@ -67,7 +74,7 @@ public:
         data[3][3] = m33;
     }
 
-    JTX_HOSTDEV explicit Mat4(const float mat[4][4]) {
+    JTX_HOSTDEV constexpr explicit Mat4(const float mat[4][4]) {
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
                 data[i][j] = mat[i][j];
@@ -75,18 +82,18 @@ public:
         }
     }
 
-    JTX_HOSTDEV explicit Mat4(const Frame &f) : Mat4(f.x.x, f.y.x, f.z.x, 0.0f,
+    JTX_HOSTDEV constexpr explicit Mat4(const Frame &f) : Mat4(f.x.x, f.y.x, f.z.x, 0.0f,
                                                      f.x.y, f.y.y, f.z.y, 0.0f,
                                                      f.x.z, f.y.z, f.z.z, 0.0f,
                                                      0.0f, 0.0f, 0.0f, 1.0f) {}
 
     ~Mat4() = default;
 
-    JTX_HOSTDEV static Mat4 identity() {
+    JTX_HOSTDEV static constexpr Mat4 identity() {
         return Mat4(1.0f);
     }
 
-    JTX_HOSTDEV static Mat4 diagonal(const float d0, const float d1, const float d2, const float d3) {
+    JTX_HOSTDEV static constexpr Mat4 diagonal(const float d0, const float d1, const float d2, const float d3) {
         Mat4 m;
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
@@ -103,24 +110,24 @@ public:
 
     //region Binary operators
 #if defined(JTXLIB_CUDA_ENABLED)
-    JTX_HOSTDEV cuda::std::span<const float> operator[](int i) const {
+    JTX_HOSTDEV constexpr cuda::std::span<const float> operator[](int i) const {
         return {data[i]};
     }
 
-    JTX_HOSTDEV cuda::std::span<float> operator[](int i) {
+    JTX_HOSTDEV constexpr cuda::std::span<float> operator[](int i) {
         return {data[i]};
     }
 #else
-    JTX_HOST std::span<const float> operator[](int i) const {
+    JTX_HOST constexpr std::span<const float> operator[](int i) const {
         return {data[i]};
     }
 
-    JTX_HOST std::span<float> operator[](int i) {
+    JTX_HOST constexpr std::span<float> operator[](int i) {
         return {data[i]};
     }
 #endif
 
-    JTX_HOSTDEV Mat4 operator+(const Mat4 &other) const {
+    JTX_HOSTDEV constexpr Mat4 operator+(const Mat4 &other) const {
         Mat4 res = *this;
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
@@ -130,7 +137,7 @@ public:
         return res;
     }
 
-    JTX_HOSTDEV Mat4 operator+(const float scalar) const {
+    JTX_HOSTDEV constexpr Mat4 operator+(const float scalar) const {
         Mat4 res = *this;
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
@@ -140,11 +147,11 @@ public:
         return res;
     }
 
-    JTX_HOSTDEV friend Mat4 operator+(const float scalar, const Mat4 &mat) {
+    JTX_HOSTDEV friend constexpr Mat4 operator+(const float scalar, const Mat4 &mat) {
         return mat + scalar;
     }
 
-    JTX_HOSTDEV Mat4 operator-(const Mat4 &other) const {
+    JTX_HOSTDEV constexpr Mat4 operator-(const Mat4 &other) const {
         Mat4 res = *this;
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
@@ -154,7 +161,7 @@ public:
         return res;
     }
 
-    JTX_HOSTDEV Mat4 operator-(const float scalar) const {
+    JTX_HOSTDEV constexpr Mat4 operator-(const float scalar) const {
         Mat4 res = *this;
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
@@ -164,7 +171,7 @@ public:
         return res;
     }
 
-    JTX_HOSTDEV Mat4 operator*(const float scalar) const {
+    JTX_HOSTDEV constexpr Mat4 operator*(const float scalar) const {
         Mat4 res = *this;
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
@@ -174,11 +181,11 @@ public:
         return res;
     }
 
-    JTX_HOSTDEV friend Mat4 operator*(const float scalar, const Mat4 &mat) {
+    JTX_HOSTDEV friend constexpr Mat4 operator*(const float scalar, const Mat4 &mat) {
         return mat * scalar;
     }
 
-    JTX_HOSTDEV Mat4 operator/(const float scalar) const {
+    JTX_HOSTDEV constexpr Mat4 operator/(const float scalar) const {
         ASSERT(scalar != 0.0f);
         Mat4 res = *this;
         for (int i = 0; i < 4; ++i) {
@@ -189,7 +196,7 @@ public:
         return res;
     }
 
-    JTX_HOSTDEV bool operator==(const Mat4 &other) const {
+    JTX_HOSTDEV constexpr bool operator==(const Mat4 &other) const {
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
                 if (data[i][j] != other[i][j]) {
@@ -200,7 +207,7 @@ public:
         return true;
     }
 
-    JTX_HOSTDEV bool operator!=(const Mat4 &other) const {
+    JTX_HOSTDEV constexpr bool operator!=(const Mat4 &other) const {
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
                 if (data[i][j] != other[i][j]) {
@@ -224,7 +231,7 @@ public:
         return true;
     }
 
-    [[nodiscard]] JTX_HOSTDEV bool isIdentity() const {
+    [[nodiscard]] JTX_HOSTDEV constexpr bool isIdentity() const {
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
                 if (i == j) {
@@ -250,33 +257,39 @@ public:
 
     // Use .mul() for higher precision
     // Use .apply() when not required (they're faster)
-    [[nodiscard]] JTX_HOSTDEV Vec4f mul(const Vec4f &vec) const {
+    // P is a rounding policy, see policy.hpp. mul<Fast>() is the scalar counterpart of mulFast()
+    template<typename P = Precise>
+    [[nodiscard]] JTX_HOSTDEV constexpr Vec4f mul(const Vec4f &vec) const {
         Vec4f res;
         for (int i = 0; i < 4; ++i) {
-            res[i] = jtx::innerProdf(data[i][0], vec[0], data[i][1], vec[1], data[i][2], vec[2], data[i][3],
-                                     vec[3]);
+            res[i] = jtx::sumOfProducts<P>(data[i][0], vec[0], data[i][1], vec[1], data[i][2], vec[2], data[i][3],
+                                           vec[3]);
         }
         return res;
     }
 
-    [[nodiscard]] JTX_HOSTDEV Mat4 mul(const Mat4 &mat) const {
+    template<typename P = Precise>
+    [[nodiscard]] JTX_HOSTDEV constexpr Mat4 mul(const Mat4 &mat) const {
         Mat4 res;
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
-                res[i][j] = jtx::innerProdf(data[i][0], mat[0][j], data[i][1], mat[1][j], data[i][2], mat[2][j],
-                                            data[i][3],
-                                            mat[3][j]);
+                res[i][j] = jtx::sumOfProducts<P>(data[i][0], mat[0][j], data[i][1], mat[1][j], data[i][2],
+                                                  mat[2][j], data[i][3], mat[3][j]);
             }
         }
         return res;
     }
 
-    JTX_HOSTDEV Mat4 operator*(const Mat4 &other) const {
+    JTX_HOSTDEV constexpr Mat4 operator*(const Mat4 &other) const {
         return this->mul(other);
     }
 
+    // Plain FMA product, vectorized with SSE when available. No error-free transformations, so expect a few
+    // ULPs of difference from mul() on ill-conditioned inputs
+    [[nodiscard]] JTX_HOST Mat4 mulFast(const Mat4 &mat) const;
+
     JTX_NUM_ONLY_T
-    [[nodiscard]] JTX_HOSTDEV Point3<T> applyToPoint(const Point3<T> &p) const {
+    [[nodiscard]] JTX_HOSTDEV constexpr Point3<T> applyToPoint(const Point3<T> &p) const {
         T xp = data[0][0] * p.x + data[0][1] * p.y + data[0][2] * p.z + data[0][3];
         T yp = data[1][0] * p.x + data[1][1] * p.y + data[1][2] * p.z + data[1][3];
         T zp = data[2][0] * p.x + data[2][1] * p.y + data[2][2] * p.z + data[2][3];
@@ -291,14 +304,14 @@ public:
     }
 
     JTX_NUM_ONLY_T
-    [[nodiscard]] JTX_HOSTDEV Vec3<T> applyToVec(const Vec3<T> &v) const {
+    [[nodiscard]] JTX_HOSTDEV constexpr Vec3<T> applyToVec(const Vec3<T> &v) const {
         return {data[0][0] * v.x + data[0][1] * v.y + data[0][2] * v.z,
                 data[1][0] * v.x + data[1][1] * v.y + data[1][2] * v.z,
                 data[2][0] * v.x + data[2][1] * v.y + data[2][2] * v.z};
     }
 
     JTX_NUM_ONLY_T
-    [[nodiscard]] JTX_HOSTDEV Vec4<T> applyToVec(const Vec4<T> &v) const {
+    [[nodiscard]] JTX_HOSTDEV constexpr Vec4<T> applyToVec(const Vec4<T> &v) const {
         return {data[0][0] * v.x + data[0][1] * v.y + data[0][2] * v.z + data[0][3] * v.w,
                 data[1][0] * v.x + data[1][1] * v.y + data[1][2] * v.z + data[1][3] * v.w,
                 data[2][0] * v.x + data[2][1] * v.y + data[2][2] * v.z + data[2][3] * v.w,
@@ -306,7 +319,7 @@ public:
     }
 
     JTX_NUM_ONLY_T
-    [[nodiscard]] JTX_HOSTDEV Normal3<T> applyToNormal(const Normal3<T> &n) const {
+    [[nodiscard]] JTX_HOSTDEV constexpr Normal3<T> applyToNormal(const Normal3<T> &n) const {
         return {data[0][0] * n.x + data[1][0] * n.y + data[2][0] * n.z,
                 data[0][1] * n.x + data[1][1] * n.y + data[2][1] * n.z,
                 data[0][2] * n.x + data[1][2] * n.y + data[2][2] * n.z};
@@ -331,15 +344,44 @@ public:
         return ret;
     }
 
+    // Last row is (0, 0, 0, 1)
+    [[nodiscard]] JTX_HOSTDEV constexpr bool isAffine() const {
+        return data[3][0] == 0.0f && data[3][1] == 0.0f && data[3][2] == 0.0f && data[3][3] == 1.0f;
+    }
+
+    // Affine matrices use Arvo's method ("Transforming Axis-Aligned Bounding Boxes", Graphics Gems, 1990):
+    // each output axis adds up the smaller and larger of the two products per input axis, which is the same
+    // box as transforming all 8 corners. Projective matrices still go through the corners.
+    // Degenerate (e.g. default constructed) boxes are returned as is.
     [[nodiscard]] JTX_HOSTDEV BBox3f applyToBBox(const BBox3f &bbox) const {
+        if (bbox.pmin.x > bbox.pmax.x || bbox.pmin.y > bbox.pmax.y || bbox.pmin.z > bbox.pmax.z) {
+            return bbox;
+        }
+
         BBox3f ret;
-        for (int i = 0; i < 8; i++) {
-            ret = ret.merge(applyToPoint(bbox.corner(i)));
+        if (!isAffine()) {
+            for (int i = 0; i < 8; i++) {
+                ret = ret.merge(applyToPoint(bbox.corner(i)));
+            }
+            return ret;
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            float lo = data[i][3];
+            float hi = data[i][3];
+            for (int j = 0; j < 3; ++j) {
+                float a = data[i][j] * bbox.pmin[j];
+                float b = data[i][j] * bbox.pmax[j];
+                lo += jtx::min(a, b);
+                hi += jtx::Max(a, b);
+            }
+            ret.pmin[i] = lo;
+            ret.pmax[i] = hi;
         }
         return ret;
     }
 
-    [[nodiscard]] JTX_HOSTDEV Mat4 transpose() const {
+    [[nodiscard]] JTX_HOSTDEV constexpr Mat4 transpose() const {
         Mat4 res;
         for (int i = 0; i < 4; ++i) {
             for (int j = 0; j < 4; ++j) {
@@ -349,32 +391,45 @@ public:
         return res;
     }
 
+    // Instantiated for Precise and Fast in mat4.cpp
+    template<typename P = Precise>
     [[nodiscard]] JTX_HOSTDEV float determinant() const;
 
     [[nodiscard]] JTX_HOSTDEV float determinant3x3() const;
 
 #if defined(__CUDA_ARCH__)
 
+    template<typename P = Precise>
     [[nodiscard]] JTX_HOSTDEV cuda::std::optional<Mat4> inverse() const;
 
 #else
 
+    template<typename P = Precise>
     [[nodiscard]] JTX_HOST std::optional<Mat4> inverse() const;
 
     [[nodiscard]] JTX_HOST std::optional<Mat4> inverseHP() const;
 
+    // Adjugate inverse with SSE, same contract as inverse() but without the dop/innerProd error compensation.
+    // Falls back to inverse<Fast>() without SSE
+    [[nodiscard]] JTX_HOST std::optional<Mat4> inverseFast() const;
+
 #endif
     //endregion
 };
 
-JTX_HOSTDEV JTX_INLINE Vec4f mul(const Mat4 &mat, const Vec4f &vec) { return mat.mul(vec); }
+template<typename P = Precise>
+JTX_HOSTDEV JTX_INLINE constexpr Vec4f mul(const Mat4 &mat, const Vec4f &vec) { return mat.mul<P>(vec); }
+
+template<typename P = Precise>
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 mul(const Mat4 &a, const Mat4 &b) { return a.mul<P>(b); }
 
-JTX_HOSTDEV JTX_INLINE Mat4 mul(const Mat4 &a, const Mat4 &b) { return a.mul(b); }
+JTX_HOST JTX_INLINE Mat4 mulFast(const Mat4 &a, const Mat4 &b) { return a.mulFast(b); }
 
-JTX_HOSTDEV JTX_INLINE Mat4 transpose(const Mat4 &mat) { return mat.transpose(); }
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 transpose(const Mat4 &mat) { return mat.transpose(); }
 
 #if defined(__CUDA_ARCH__)
-JTX_HOSTDEV JTX_INLINE cuda::std::optional<Mat4> inverse(const Mat4 &mat) { return mat.inverse(); }
+template<typename P = Precise>
+JTX_HOSTDEV JTX_INLINE cuda::std::optional<Mat4> inverse(const Mat4 &mat) { return mat.inverse<P>(); }
 
 JTX_HOSTDEV JTX_INLINE cuda::std::optional<Mat4> linearLS(const Mat4 &A, const Mat4 &B) {
     Mat4 AtA = Mat4{};
@@ -395,7 +450,10 @@ JTX_HOSTDEV JTX_INLINE cuda::std::optional<Mat4> linearLS(const Mat4 &A, const M
 }
 #else
 
-JTX_HOSTDEV JTX_INLINE std::optional<Mat4> inverse(const Mat4 &mat) { return mat.inverse(); }
+template<typename P = Precise>
+JTX_HOSTDEV JTX_INLINE std::optional<Mat4> inverse(const Mat4 &mat) { return mat.inverse<P>(); }
+
+JTX_HOST JTX_INLINE std::optional<Mat4> inverseFast(const Mat4 &mat) { return mat.inverseFast(); }
 
 JTX_HOSTDEV JTX_INLINE std::optional<Mat4> linearLS(const Mat4 &A, const Mat4 &B) {
     auto AtA = Mat4{};
@@ -424,7 +482,7 @@ JTX_HOSTDEV JTX_INLINE Mat4 invert(const Mat4 &mat) {
 }
 
 //region Matrix Transformations
-JTX_HOSTDEV JTX_INLINE Mat4 translate(const float delta) {
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 translate(const float delta) {
     return {
             1.0f, 0.0f, 0.0f, delta,
             0.0f, 1.0f, 0.0f, delta,
@@ -432,7 +490,7 @@ JTX_HOSTDEV JTX_INLINE Mat4 translate(const float delta) {
             0.0f, 0.0f, 0.0f, 1.0f};
 }
 
-JTX_HOSTDEV JTX_INLINE Mat4 translate(float x, float y, float z) {
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 translate(float x, float y, float z) {
     return {
             1.0f, 0.0f, 0.0f, x,
             0.0f, 1.0f, 0.0f, y,
@@ -440,25 +498,25 @@ JTX_HOSTDEV JTX_INLINE Mat4 translate(float x, float y, float z) {
             0.0f, 0.0f, 0.0f, 1.0f};
 }
 
-JTX_HOSTDEV JTX_INLINE Mat4 translate(const jtx::Vec3f &v) {
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 translate(const jtx::Vec3f &v) {
     return translate(v.x, v.y, v.z);
 }
 
-JTX_HOSTDEV JTX_INLINE Mat4 scale(float s) {
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 scale(float s) {
     return Mat4::diagonal(s, s, s, 1.0f);
 }
 
-JTX_HOSTDEV JTX_INLINE Mat4 scale(float x, float y, float z) {
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 scale(float x, float y, float z) {
     return Mat4::diagonal(x, y, z, 1.0f);
 }
 
-JTX_HOSTDEV JTX_INLINE Mat4 scale(const jtx::Vec3f &v) {
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 scale(const jtx::Vec3f &v) {
     return Mat4::diagonal(v.x, v.y, v.z, 1.0f);
 }
 
-JTX_HOSTDEV JTX_INLINE Mat4 rotateX(float theta) {
-    float sinTheta = jtx::sin(jtx::Radians(theta));
-    float cosTheta = jtx::cos(jtx::Radians(theta));
+// The sin/cos overloads of rotateX/Y/Z are constexpr, use them with precomputed values for rotations that should
+// fold at compile time. theta is in degrees
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 rotateX(float sinTheta, float cosTheta) {
     return {
             1.0f, 0.0f, 0.0f, 0.0f,
             0.0f, cosTheta, -sinTheta, 0.0f,
@@ -466,9 +524,11 @@ JTX_HOSTDEV JTX_INLINE Mat4 rotateX(float theta) {
             0.0f, 0.0f, 0.0f, 1.0f};
 }
 
-JTX_HOSTDEV JTX_INLINE Mat4 rotateY(float theta) {
-    float sinTheta = jtx::sin(jtx::Radians(theta));
-    float cosTheta = jtx::cos(jtx::Radians(theta));
+JTX_HOSTDEV JTX_INLINE Mat4 rotateX(float theta) {
+    return rotateX(jtx::sin(jtx::Radians(theta)), jtx::cos(jtx::Radians(theta)));
+}
+
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 rotateY(float sinTheta, float cosTheta) {
     return {
             cosTheta, 0.0f, sinTheta, 0.0f,
             0.0f, 1.0f, 0.0f, 0.0f,
@@ -476,9 +536,11 @@ JTX_HOSTDEV JTX_INLINE Mat4 rotateY(float theta) {
             0.0f, 0.0f, 0.0f, 1.0f};
 }
 
-JTX_HOSTDEV JTX_INLINE Mat4 rotateZ(float theta) {
-    float sinTheta = jtx::sin(jtx::Radians(theta));
-    float cosTheta = jtx::cos(jtx::Radians(theta));
+JTX_HOSTDEV JTX_INLINE Mat4 rotateY(float theta) {
+    return rotateY(jtx::sin(jtx::Radians(theta)), jtx::cos(jtx::Radians(theta)));
+}
+
+JTX_HOSTDEV JTX_INLINE constexpr Mat4 rotateZ(float sinTheta, float cosTheta) {
     return {
             cosTheta, -sinTheta, 0.0f, 0.0f,
             sinTheta, cosTheta, 0.0f, 0.0f,
@@ -486,6 +548,10 @@ JTX_HOSTDEV JTX_INLINE Mat4 rotateZ(float theta) {
             0.0f, 0.0f, 0.0f, 1.0f};
 }
 
+JTX_HOSTDEV JTX_INLINE Mat4 rotateZ(float theta) {
+    return rotateZ(jtx::sin(jtx::Radians(theta)), jtx::cos(jtx::Radians(theta)));
+}
+
 JTX_HOSTDEV Mat4 rotate(float sinTheta, float cosTheta, const Vec3f &axis);
 
 JTX_HOSTDEV Mat4 rotate(float theta, const jtx::Vec3f &axis);
@@ -517,7 +583,8 @@ JTX_HOSTDEV JTX_INLINE Mat4 perspective(float fov, float aspect, float near, flo
             0.0f, 0.0f, -1.0f, 0.0f};
 }
 
-JTX_HOSTDEV JTX_INLINE Mat4 orthographic(float left, float right, float top, float bottom, float near, float far) {
+JTX_HOSTDEV JTX_INLINE constexpr Mat4
+orthographic(float left, float right, float top, float bottom, float near, float far) {
     return {
             2.0f / (right - left), 0.0f, 0.0f, -(right + left) / (right - left),
             0.0f, 2.0f / (top - bottom), 0.0f, -(top + bottom) / (top - bottom),
@@ -1,12 +1,20 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstdint>
 #include <jtxlib.hpp>
 #include <jtxlib/math/constants.hpp>
 #include <jtxlib/math/numerical.hpp>
+#include <jtxlib/math/policy.hpp>
 #include <jtxlib/util/assert.hpp>
 
+#if !defined(__CUDA_ARCH__) && (defined(__SSE__) || defined(_M_X64))
+#include <xmmintrin.h>
+#define JTX_HAS_RSQRT_ESTIMATE
+#endif
+
 namespace jtx {
 JTX_NUM_ONLY_T
 JTX_HOSTDEV T Abs(T v) {
@@ -159,13 +167,61 @@ JTX_HOSTDEV T Abs(T v) {
 // clang-format on
 //endregion
 
+namespace detail {
+// Single-rounding float fma for constant evaluation. a * b is exact in double, and the double sum is rounded
+// to odd (its last bit is set when the addition was inexact) so the final rounding to float can't round twice
+JTX_HOSTDEV constexpr float fmafConstexpr(float a, float b, float c) {
+    double p = double(a) * double(b);
+    double s = p + double(c);
+    if (s - s != 0) return float(s);
+
+    double bb = s - p;
+    double err = (p - (s - bb)) + (double(c) - bb);
+    auto bits = std::bit_cast<uint64_t>(s);
+    if (err != 0 && (bits & 1) == 0) {
+        bits = ((err > 0) == (s > 0)) ? bits + 1 : bits - 1;
+    }
+    return float(std::bit_cast<double>(bits));
+}
+}// namespace detail
+
+// a * b + c with a single rounding. Only one instruction when the target has FMA (-mfma, -march=haswell or
+// newer); without it every call goes out of line to libm and costs several times a multiply and an add, so use
+// it where the single rounding is needed for correctness (dop() and the EFTs below) and mulAdd everywhere else.
+// Floats can also be evaluated at compile time, which lets Mat4 products and cross products fold into constants
+template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+JTX_HOSTDEV JTX_INLINE constexpr T fma(T a, T b, T c) {
+    if constexpr (std::is_same_v<T, float>) {
+        if (std::is_constant_evaluated()) return detail::fmafConstexpr(a, b, c);
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+#if defined(JTXLIB_CUDA_ENABLED)
+        return ::fma(a, b, c);
+#else
+        return std::fma(a, b, c);
+#endif
+    } else {
+        return a * b + c;
+    }
+}
+
+#if defined(JTXLIB_CUDA_ENABLED) || defined(__FMA__) || defined(FP_FAST_FMAF)
+#define JTX_HAS_FAST_FMA
+#endif
+
+// a * b + c, fused when the target has FMA and a plain multiply and add otherwise. For code that only wants
+// the speed, so the rounding depends on the build
 template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
-JTX_HOSTDEV JTX_INLINE T fma(T a, T b, T c) {
+JTX_HOSTDEV JTX_INLINE constexpr T mulAdd(T a, T b, T c) {
+#if defined(JTX_HAS_FAST_FMA)
+    return jtx::fma(a, b, c);
+#else
     return a * b + c;
+#endif
 }
 
 template<typename T>
-JTX_HOSTDEV std::enable_if_t<std::is_floating_point_v<T>, T>
+JTX_HOSTDEV constexpr std::enable_if_t<std::is_floating_point_v<T>, T>
 dop(T a, T b, T c, T d) {
     auto cd = c * d;
     auto alpha = jtx::fma(a, b, -cd);
@@ -174,7 +230,7 @@ dop(T a, T b, T c, T d) {
 }
 
 template<typename T>
-JTX_HOSTDEV std::enable_if_t<std::is_integral_v<T>, T>
+JTX_HOSTDEV constexpr std::enable_if_t<std::is_integral_v<T>, T>
 dop(T a, T b, T c, T d) {
     return a * b - c * d;
 }
@@ -244,8 +300,25 @@ JTX_HOSTDEV JTX_INLINE T SafeSqrt(T v) {
     return jtx::Sqrt(jtx::Max(0.0f, v));
 }
 
+// 1 / sqrt(v), see policy.hpp for the accuracy of Approx. Approx is undefined for v == 0
+template<typename P = Exact, typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+JTX_HOSTDEV JTX_INLINE T Rsqrt(T v) {
+    static_assert(IsPrecisionPolicy<P>, "P must be Exact or Approx");
+    if constexpr (IsApprox<P> && std::is_same_v<T, float>) {
+#if defined(__CUDA_ARCH__)
+        return ::rsqrtf(v);
+#elif defined(JTX_HAS_RSQRT_ESTIMATE)
+        float r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(v)));
+        // One Newton-Raphson step: 0.5 * r * (3 - v * r * r)
+        return 0.5f * r * (3.0f - v * r * r);
+#endif
+    }
+    return 1 / jtx::Sqrt(v);
+}
+
+// (1 - t) * a + t * b, exact at t = 0 and t = 1
 JTX_HOSTDEV JTX_INLINE float Lerp(float a, float b, float t) {
-    return a * (1 - t) + b * t;
+    return jtx::mulAdd(t, b, jtx::mulAdd(-t, a, a));
 }
 
 
@@ -257,9 +330,61 @@ inline constexpr T evalPolynomial(T t, C c) {
 template<typename T, typename C, typename... Coeffs,
          typename = std::enable_if_t<std::is_arithmetic_v<T> && std::is_arithmetic_v<C>>>
 inline constexpr T evalPolynomial(T t, C c, Coeffs... coeffs) {
-    return jtx::fma(t, evalPolynomial(t, coeffs...), c);
+    return jtx::mulAdd(t, evalPolynomial(t, coeffs...), T(c));
+}
+
+// Horner evaluation with the coefficients in an array, e.g. a constexpr table shared with the SIMD code.
+// Plain arrays rather than std::array so the per-ISA SIMD kernels don't instantiate any std:: code
+template<typename T, typename C, size_t K, typename = std::enable_if_t<std::is_arithmetic_v<T> && std::is_arithmetic_v<C>>>
+inline constexpr T evalPolynomial(T t, const C (&c)[K]) {
+    T r = T(c[K - 1]);
+    for (size_t i = K - 1; i-- > 0;) r = jtx::mulAdd(t, r, T(c[i]));
+    return r;
+}
+
+namespace detail {
+// Pairs up c0 + c1 * t, c2 + c3 * t, ... and recurses on t^2. The pairs don't depend on each other, so a
+// degree n polynomial is about log2(n) multiply-adds deep instead of Horner's n
+template<typename T, size_t K>
+inline constexpr T estrin(T t, const T (&c)[K]) {
+    if constexpr (K == 1) {
+        return c[0];
+    } else {
+        T pairs[(K + 1) / 2] = {};
+        for (size_t i = 0; i < K / 2; ++i) pairs[i] = jtx::mulAdd(t, c[2 * i + 1], c[2 * i]);
+        if constexpr (K % 2 == 1) pairs[K / 2] = c[K - 1];
+        return estrin(t * t, pairs);
+    }
+}
+}// namespace detail
+
+/**
+ * Estrin evaluation of the same polynomial as evalPolynomial. Takes the same coefficients, but the shorter
+ * dependency chain lets the multiply-adds overlap. That pays off for longer polynomials like the 7-term
+ * EQUAL_AREA_ATAN_COEFFS, short ones are better off with Horner. Rounds in a different order, so results
+ * can differ from Horner by an ulp or so
+ */
+template<typename T, typename C, typename... Coeffs,
+         typename = std::enable_if_t<std::is_arithmetic_v<T> && std::is_arithmetic_v<C>>>
+inline constexpr T evalPolynomialEstrin(T t, C c, Coeffs... coeffs) {
+    const T all[] = {T(c), T(coeffs)...};
+    return detail::estrin(t, all);
 }
 
+template<typename T, typename C, size_t K, typename = std::enable_if_t<std::is_arithmetic_v<T> && std::is_arithmetic_v<C>>>
+inline constexpr T evalPolynomialEstrin(T t, const C (&c)[K]) {
+    T coeffs[K] = {};
+    for (size_t i = 0; i < K; ++i) coeffs[i] = T(c[i]);
+    return detail::estrin(t, coeffs);
+}
+
+// atan(x) * 2 / pi on [0, 1], lowest order first. Used by EqualAreaSphereToSquare and its SIMD version
+// https://github.com/mmp/pbrt-v4/blob/39e01e61f8de07b99859df04b271a02a53d9aeb2/src/pbrt/util/math.cpp#L292
+inline constexpr float EQUAL_AREA_ATAN_COEFFS[7] = {
+        0.406758566246788489601959989e-5f, 0.636226545274016134946890922156f, 0.61572017898280213493197203466e-2f,
+        -0.247333733281268944196501420480f, 0.881770664775316294736387951347e-1f,
+        0.419038818029165735901852432784e-1f, -0.251390972343483509333252996350e-1f};
+
 JTX_HOSTDEV JTX_INLINE float exp(float n) {
 #if defined(JTXLIB_CUDA_ENABLED)
     return ::expf(n);
@@ -301,36 +426,36 @@ public:
     float v;
     float err;
 
-    FloatEFT(float v, float err) : v(v), err(err) {}
+    constexpr FloatEFT(float v, float err) : v(v), err(err) {}
 
-    explicit operator float() const { return v + err; }
+    constexpr explicit operator float() const { return v + err; }
 
-    float operator*(float a) const {
+    constexpr float operator*(float a) const {
         return a * float(*this);
     }
 
-    friend float operator*(float a, const FloatEFT &b) {
+    friend constexpr float operator*(float a, const FloatEFT &b) {
         return a * float(b);
     }
 };
 
-inline FloatEFT twoProd(float a, float b) {
+constexpr FloatEFT twoProd(float a, float b) {
     float ab = a * b;
     return {ab, jtx::fma(a, b, -ab)};
 }
 
-inline FloatEFT twoSum(float a, float b) {
+constexpr FloatEFT twoSum(float a, float b) {
     float s = a + b;
     float delta = s - a;
     return {s, (a - (s - delta)) + (b - delta)};
 }
 
-inline FloatEFT innerProd(float a, float b) {
+constexpr FloatEFT innerProd(float a, float b) {
     return twoProd(a, b);
 }
 
 template<typename... T>
-inline FloatEFT innerProd(float a, float b, T... terms) {
+constexpr FloatEFT innerProd(float a, float b, T... terms) {
     FloatEFT ab = twoProd(a, b);
     FloatEFT tp = innerProd(terms...);
     FloatEFT sum = twoSum(ab.v, tp.v);
@@ -338,11 +463,40 @@ inline FloatEFT innerProd(float a, float b, T... terms) {
 }
 
 template<typename... T>
-float innerProdf(float a, float b, T... terms) {
+constexpr float innerProdf(float a, float b, T... terms) {
     return static_cast<float>(innerProd(a, b, terms...));
 }
 //endregion
 
+//region Rounding policies
+// a * b - c * d under a rounding policy (see policy.hpp), Precise is dop()
+template<typename P, typename T>
+JTX_HOSTDEV constexpr T differenceOfProducts(T a, T b, T c, T d) {
+    static_assert(IsRoundingPolicy<P>, "P must be Precise or Fast");
+    if constexpr (IsPrecise<P>) {
+        return jtx::dop(a, b, c, d);
+    } else {
+        return a * b - c * d;
+    }
+}
+
+// a0 * b0 + a1 * b1 + ... under a rounding policy, Precise is innerProdf()
+template<typename P, typename... T>
+JTX_HOSTDEV constexpr float sumOfProducts(float a, float b, T... terms) {
+    static_assert(IsRoundingPolicy<P>, "P must be Precise or Fast");
+    if constexpr (IsPrecise<P>) {
+        return jtx::innerProdf(a, b, terms...);
+    } else {
+        const float v[] = {a, b, float(terms)...};
+        float sum = v[0] * v[1];
+        for (size_t i = 2; i < sizeof(v) / sizeof(float); i += 2) {
+            sum += v[i] * v[i + 1];
+        }
+        return sum;
+    }
+}
+//endregion
+
 JTX_HOSTDEV
 JTX_INLINE float erf(float val) {
 #ifdef USE_CUDA
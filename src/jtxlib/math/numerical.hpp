@@ -11,6 +11,7 @@
 #include <jtxlib/math/constants.hpp>
 #include <algorithm>
 #include <stdexcept>
+#include <type_traits>
 
 #define JTX_NUM_ONLY(TypeName) template<typename TypeName = T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
 
@@ -24,6 +25,10 @@
 #define JTX_ENABLE_INT_T typename std::enable_if_t<std::is_integral_v<T>, T>
 
 namespace jtx {
+// Type of lengths and other non-integral results for T: T itself for floating point types, float otherwise
+template<typename T>
+using FloatType = std::conditional_t<std::is_floating_point_v<T>, T, float>;
+
 template<typename T>
 JTX_HOSTDEV JTX_INLINE
         JTX_ENABLE_FP_BOOL
@@ -0,0 +1,50 @@
+/**
+ * Precision policies
+ *
+ * Functions with a faster, less accurate variant take the policy as their first template argument, e.g.
+ * Normalize<Approx>(v) or q.normalized<Approx>(). Exact is always the default, so existing call sites keep
+ * their results and the fast path is opted into per call.
+ *  - Exact: correctly rounded sqrt and division
+ *  - Approx: hardware reciprocal square root estimate refined with one Newton-Raphson step, < 3e-7 relative
+ *            error for floats. Doubles and targets without an estimate instruction use the Exact path
+ */
+#pragma once
+
+#include <type_traits>
+
+namespace jtx {
+struct Exact {};
+struct Approx {};
+
+template<typename P>
+inline constexpr bool IsApprox = std::is_same_v<P, Approx>;
+
+template<typename P>
+inline constexpr bool IsPrecisionPolicy = std::is_same_v<P, Exact> || std::is_same_v<P, Approx>;
+
+/**
+ * Rounding policies
+ *
+ * Products prone to cancellation take one of these the same way, e.g. Cross<Precise>(a, b) or m.inverse<Fast>().
+ *  - Precise: error-free transformations (dop, innerProd), so the result is rounded about once
+ *  - Fast: plain products and sums
+ * Cross and Dot default to DefaultRounding, which is Precise when built with JTXLIB_MINIMIZE_FP_ERROR and Fast
+ * otherwise. The flag used to only affect Cross, it now also moves the default Dot onto innerProdf; call
+ * Dot<Fast> where the plain dot product is wanted. Mat4::mul, determinant and inverse default to Precise, as
+ * they always have
+ */
+struct Precise {};
+struct Fast {};
+
+#if defined(JTXLIB_MINIMIZE_FP_ERROR)
+using DefaultRounding = Precise;
+#else
+using DefaultRounding = Fast;
+#endif
+
+template<typename P>
+inline constexpr bool IsPrecise = std::is_same_v<P, Precise>;
+
+template<typename P>
+inline constexpr bool IsRoundingPolicy = std::is_same_v<P, Precise> || std::is_same_v<P, Fast>;
+}// namespace jtx
@@ -11,76 +11,92 @@ public:
     /**
      * Returns an identity quaternion
      */
-    JTX_HOSTDEV Quaternion() : w(1), v(0, 0, 0) {}
-    JTX_HOSTDEV Quaternion(const float w, const Vec3f &v) : w(w), v(v) {}
-    JTX_HOSTDEV Quaternion(const float w, const float x, const float y, const float z) : w(w), v(x, y, z) {}
-
-    JTX_HOSTDEV static Quaternion pure(const Vec3f &v) { return {0, v}; }
-    JTX_HOSTDEV static Quaternion real(float w) { return {w, 0, 0, 0}; }
-
-    JTX_HOSTDEV Quaternion operator+(const Quaternion &q) const { return {w + q.w, v + q.v}; }
-    JTX_HOSTDEV Quaternion operator-(const Quaternion &q) const { return {w - q.w, v - q.v}; }
-    JTX_HOSTDEV Quaternion operator-() const { return {-w, -v}; }
-    JTX_HOSTDEV Quaternion operator*(const Quaternion &q) const { return {w * q.w - v.Dot(q.v), w * q.v + q.w * v + v.cross(q.v)}; }
-    JTX_HOSTDEV Quaternion operator*(const float s) const { return {w * s, v * s}; }
-    JTX_HOSTDEV Quaternion operator/(const float s) const {
+    JTX_HOSTDEV constexpr Quaternion() : w(1), v(0, 0, 0) {}
+    JTX_HOSTDEV constexpr Quaternion(const float w, const Vec3f &v) : w(w), v(v) {}
+    JTX_HOSTDEV constexpr Quaternion(const float w, const float x, const float y, const float z) : w(w), v(x, y, z) {}
+
+    JTX_HOSTDEV static constexpr Quaternion pure(const Vec3f &v) { return {0, v}; }
+    JTX_HOSTDEV static constexpr Quaternion real(float w) { return {w, 0, 0, 0}; }
+
+    JTX_HOSTDEV constexpr Quaternion operator+(const Quaternion &q) const { return {w + q.w, v + q.v}; }
+    JTX_HOSTDEV constexpr Quaternion operator-(const Quaternion &q) const { return {w - q.w, v - q.v}; }
+    JTX_HOSTDEV constexpr Quaternion operator-() const { return {-w, -v}; }
+    JTX_HOSTDEV constexpr Quaternion operator*(const Quaternion &q) const {
+        return {w * q.w - v.Dot(q.v), w * q.v + q.w * v + v.cross(q.v)};
+    }
+    JTX_HOSTDEV constexpr Quaternion operator*(const float s) const { return {w * s, v * s}; }
+    JTX_HOSTDEV constexpr Quaternion operator/(const float s) const {
         ASSERT(jtx::abs(s) > JTX_EPSILON);
         return {w / s, v / s};
     }
 
-    JTX_HOSTDEV Quaternion &operator+=(const Quaternion &q) {
+    JTX_HOSTDEV constexpr Quaternion &operator+=(const Quaternion &q) {
         w += q.w;
         v += q.v;
         return *this;
     }
-    JTX_HOSTDEV Quaternion &operator-=(const Quaternion &q) {
+    JTX_HOSTDEV constexpr Quaternion &operator-=(const Quaternion &q) {
         w -= q.w;
         v -= q.v;
         return *this;
     }
-    JTX_HOSTDEV Quaternion &operator*=(const Quaternion &q) {
+    JTX_HOSTDEV constexpr Quaternion &operator*=(const Quaternion &q) {
         *this = *this * q;
         return *this;
     }
 
-    JTX_HOSTDEV Quaternion &operator*=(const float s) {
+    JTX_HOSTDEV constexpr Quaternion &operator*=(const float s) {
         w *= s;
         v *= s;
         return *this;
     }
-    JTX_HOSTDEV Quaternion &operator/=(const float s) {
+    JTX_HOSTDEV constexpr Quaternion &operator/=(const float s) {
         ASSERT(s > 0.0f);
         w /= s;
         v /= s;
         return *this;
     }
 
-    JTX_HOSTDEV friend Quaternion operator*(const float s, const Quaternion &q) { return q * s; }
+    JTX_HOSTDEV friend constexpr Quaternion operator*(const float s, const Quaternion &q) { return q * s; }
+
+    JTX_HOSTDEV constexpr bool operator==(const Quaternion &q) const { return w == q.w && v == q.v; }
 
-    JTX_HOSTDEV bool operator==(const Quaternion &q) const { return w == q.w && v == q.v; }
+    [[nodiscard]] JTX_HOSTDEV constexpr float dot(const Quaternion &q) const { return w * q.w + v.Dot(q.v); }
+    // P is a precision policy, see policy.hpp
+    template<typename P = Exact>
+    [[nodiscard]] JTX_HOSTDEV float len() const {
+        const float l2 = this->dot(*this);
+        if constexpr (IsApprox<P>) {
+            return l2 == 0 ? 0 : l2 * jtx::Rsqrt<P>(l2);
+        } else {
+            return jtx::Sqrt(l2);
+        }
+    }
 
-    [[nodiscard]] JTX_HOSTDEV float dot(const Quaternion &q) const { return w * q.w + v.Dot(q.v); }
-    [[nodiscard]] JTX_HOSTDEV float len() const { return jtx::Sqrt(this->dot(*this)); }
     /**
      * Normalizes this quaternion
      */
+    template<typename P = Exact>
     JTX_HOSTDEV void normalize() {
-        const float l = len();
-        w /= l;
-        v /= l;
+        *this = normalized<P>();
     }
 
     /**
      * Returns a normalized copy of this quaternion
      * @return Normalized quaternion
      */
-    JTX_HOSTDEV Quaternion normalized() const {
-        const float l = len();
-        return {w / l, v / l};
+    template<typename P = Exact>
+    [[nodiscard]] JTX_HOSTDEV Quaternion normalized() const {
+        if constexpr (IsApprox<P>) {
+            return *this * jtx::Rsqrt<P>(this->dot(*this));
+        } else {
+            const float l = len();
+            return {w / l, v / l};
+        }
     }
 
-    [[nodiscard]] JTX_HOSTDEV Quaternion conjugate() const { return {w, -v}; }
-    [[nodiscard]] JTX_HOSTDEV Quaternion inverse() const { return conjugate() / dot(*this); }
+    [[nodiscard]] JTX_HOSTDEV constexpr Quaternion conjugate() const { return {w, -v}; }
+    [[nodiscard]] JTX_HOSTDEV constexpr Quaternion inverse() const { return conjugate() / dot(*this); }
 
     /**
          * Calculates the angle between this and another quaternion
@@ -102,7 +118,14 @@ public:
 };
 
 JTX_HOSTDEV JTX_INLINE float Dot(const Quaternion &q1, const Quaternion &q2) { return q1.dot(q2); }
-JTX_HOSTDEV JTX_INLINE Quaternion Normalize(const Quaternion &q) { return q / q.len(); }
+template<typename P = Exact>
+JTX_HOSTDEV JTX_INLINE Quaternion Normalize(const Quaternion &q) {
+    if constexpr (IsApprox<P>) {
+        return q.normalized<P>();
+    } else {
+        return q / q.len();
+    }
+}
 JTX_HOSTDEV JTX_INLINE float angle(const Quaternion &q1, const Quaternion &q2) { return q1.angle(q2); }
 
 JTX_HOSTDEV JTX_INLINE Quaternion slerp(const Quaternion &q1, const Quaternion &q2, float t) {
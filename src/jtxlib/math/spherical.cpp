@@ -28,15 +28,7 @@ namespace jtx{
         float b = jtx::min(x, y);
         b = a == 0 ? 0 : b / a;
 
-        // https://github.com/mmp/pbrt-v4/blob/39e01e61f8de07b99859df04b271a02a53d9aeb2/src/pbrt/util/math.cpp#L292
-        const float t1 = 0.406758566246788489601959989e-5;
-        const float t2 = 0.636226545274016134946890922156;
-        const float t3 = 0.61572017898280213493197203466e-2;
-        const float t4 = -0.247333733281268944196501420480;
-        const float t5 = 0.881770664775316294736387951347e-1;
-        const float t6 = 0.419038818029165735901852432784e-1;
-        const float t7 = -0.251390972343483509333252996350e-1;
-        float phi = jtx::evalPolynomial(b, t1, t2, t3, t4, t5, t6, t7);
+        float phi = jtx::evalPolynomialEstrin(b, EQUAL_AREA_ATAN_COEFFS);
 
         if (x < y) phi = 1 - phi;
         float v = phi * r;
@@ -1,10 +1,14 @@
 #pragma once
 
 #include<cstdint>
+#include <limits>
+#include <type_traits>
+#include <jtxlib/jstd/jstd.hpp>
 #include <jtxlib/math/vec3.hpp>
 #include <jtxlib/math/vecmath.hpp>
 #include <jtxlib/math/mat4.hpp>
 #include <jtxlib/math/constants.hpp>
+#include <jtxlib/simd/kernels.hpp>
 #include <jtxlib/util/assert.hpp>
 #include "./bounds.hpp"
 
@@ -95,10 +99,22 @@ JTX_INLINE float CosDPhi(const Vec3f &wa, const Vec3f &wb) {
 //endregion
 
 //region Octahedral
-class OctahedralVec {
+/**
+ * Unit vector packed as two T (uint16_t or uint8_t) with an octahedral mapping
+ * The 16-bit version is accurate to ~7e-5 radians, the 8-bit one to ~2e-2 (about a degree)
+ */
+template<typename T>
+class OctahedralVecT {
 public:
+    static_assert(std::is_unsigned_v<T> && sizeof(T) <= 2, "Octahedral vectors are stored as 8 or 16 bit integers");
+
+    // Largest encoded value, [0, MAX] maps to [-1, 1]
+    static constexpr float MAX = static_cast<float>(std::numeric_limits<T>::max());
+
+    OctahedralVecT() = default;
+
     // WARNING: PBRT modified the input vector, but this version doesn't
-    explicit OctahedralVec(const Vec3f &v) {
+    explicit OctahedralVecT(const Vec3f &v) {
         ASSERT(jtx::equals(v.lenSqr(), 1.0f, 1e-6f));
         auto vec = v / v.l1norm();
         if (vec.z >= 0) {
@@ -112,8 +128,8 @@ public:
 
     explicit operator Vec3f() const {
         Vec3f v;
-        v.x = -1 + 2 * (static_cast<float>(x) / JTX_BITS_16);
-        v.y = -1 + 2 * (static_cast<float>(y) / JTX_BITS_16);
+        v.x = -1 + 2 * (static_cast<float>(x) / MAX);
+        v.y = -1 + 2 * (static_cast<float>(y) / MAX);
         v.z = 1 - jtx::Abs(v.x) - jtx::Abs(v.y);
         if (v.z < 0) {
             auto xo = v.x;
@@ -123,15 +139,53 @@ public:
         return v.Normalize();
     }
 
+    bool operator==(const OctahedralVecT &other) const { return x == other.x && y == other.y; }
+
+    bool operator!=(const OctahedralVecT &other) const { return !(*this == other); }
+
 private:
     static JTX_INLINE float Sign(float f) { return jtx::CopySign(1.0f, f); }
 
-    static JTX_INLINE uint16_t Encode(float f) {
-        return static_cast<uint16_t>(jtx::round(jtx::Clamp((f + 1) / 2, 0, 1) * JTX_BITS_16));
+    static JTX_INLINE T Encode(float f) {
+        return static_cast<T>(jtx::round(jtx::Clamp((f + 1) / 2, 0, 1) * MAX));
     }
 
-    uint16_t x, y;
+    T x = 0, y = 0;
 };
+
+using OctahedralVec = OctahedralVecT<uint16_t>;
+using OctahedralVec8 = OctahedralVecT<uint8_t>;
+
+static_assert(sizeof(OctahedralVec) == 2 * sizeof(uint16_t) && sizeof(OctahedralVec8) == 2 * sizeof(uint8_t),
+              "The batch kernels treat octahedral vectors as packed (x, y) pairs");
+
+/**
+ * Batch versions of the OctahedralVecT conversions, out must be at least as long as in
+ * Encoding gives the same bits as the scalar constructor, decoding matches it to within a few ULP
+ */
+JTX_HOST JTX_INLINE void EncodeOctahedral(jstd::span<const Vec3f> in, jstd::span<OctahedralVec> out) {
+    ASSERT(out.size() >= in.size());
+    auto dst = reinterpret_cast<uint16_t *>(out.data());
+    simdKernels().encodeOctahedral16(reinterpret_cast<const float *>(in.data()), dst, in.size());
+}
+
+JTX_HOST JTX_INLINE void EncodeOctahedral(jstd::span<const Vec3f> in, jstd::span<OctahedralVec8> out) {
+    ASSERT(out.size() >= in.size());
+    auto dst = reinterpret_cast<uint8_t *>(out.data());
+    simdKernels().encodeOctahedral8(reinterpret_cast<const float *>(in.data()), dst, in.size());
+}
+
+JTX_HOST JTX_INLINE void DecodeOctahedral(jstd::span<const OctahedralVec> in, jstd::span<Vec3f> out) {
+    ASSERT(out.size() >= in.size());
+    auto src = reinterpret_cast<const uint16_t *>(in.data());
+    simdKernels().decodeOctahedral16(src, reinterpret_cast<float *>(out.data()), in.size());
+}
+
+JTX_HOST JTX_INLINE void DecodeOctahedral(jstd::span<const OctahedralVec8> in, jstd::span<Vec3f> out) {
+    ASSERT(out.size() >= in.size());
+    auto src = reinterpret_cast<const uint8_t *>(in.data());
+    simdKernels().decodeOctahedral8(src, reinterpret_cast<float *>(out.data()), in.size());
+}
 //endregion
 
 //region Square-Sphere
@@ -156,6 +210,32 @@ JTX_INLINE Point2f WrapEqualAreaSquare(Point2f p) {
     }
     return p;
 }
+
+static_assert(sizeof(Point2f) == 2 * sizeof(float), "The batch mappings assume Point2f is two packed floats");
+
+/**
+ * Batch versions of the mappings above, out must be at least as long as in
+ * Results match the scalar functions to within a few ULP
+ */
+JTX_HOST JTX_INLINE void EqualAreaSquareToSphere(jstd::span<const Point2f> in, jstd::span<Vec3f> out) {
+    ASSERT(out.size() >= in.size());
+    auto src = reinterpret_cast<const float *>(in.data());
+    simdKernels().equalAreaSquareToSphere(src, reinterpret_cast<float *>(out.data()), in.size());
+}
+
+JTX_HOST JTX_INLINE void EqualAreaSphereToSquare(jstd::span<const Vec3f> in, jstd::span<Point2f> out) {
+    ASSERT(out.size() >= in.size());
+    auto src = reinterpret_cast<const float *>(in.data());
+    simdKernels().equalAreaSphereToSquare(src, reinterpret_cast<float *>(out.data()), in.size());
+}
+
+// in and out may be the same span
+JTX_HOST JTX_INLINE void WrapEqualAreaSquare(jstd::span<const Point2f> in, jstd::span<Point2f> out) {
+    ASSERT(out.size() >= in.size());
+    auto src = reinterpret_cast<const float *>(in.data());
+    simdKernels().wrapEqualAreaSquare(src, reinterpret_cast<float *>(out.data()), in.size());
+}
+
 //endregion
 
 //region DirectionCone
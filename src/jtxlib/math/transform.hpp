@@ -8,27 +8,20 @@
 #include <jtxlib/math/vecmath.hpp>
 #include <jtxlib/math/ray.hpp>
 #include <jtxlib/math/bounds.hpp>
+#include <jtxlib/jstd/jstd.hpp>
+#include <jtxlib/simd/kernels.hpp>
 
 
 namespace jtx {
     struct Transform {
         //region Constructors
-        Transform() : m(Mat4(1.0f)), mInv(Mat4(1.0f)) {};
+        constexpr Transform() : m(Mat4(1.0f)), mInv(Mat4(1.0f)) {};
 
-        Transform(const Mat4 &m, const Mat4 &mInv) : m(m), mInv(mInv) {};
+        constexpr Transform(const Mat4 &m, const Mat4 &mInv) : m(m), mInv(mInv) {};
 
         explicit Transform(const Mat4 &m) : m(m) {
             std::optional<Mat4> inv = m.inverse();
-            if (inv.has_value()) {
-                mInv = inv.value();
-            } else {
-                float nan = std::numeric_limits<float>::signaling_NaN();
-                for (int i = 0; i < 4; i++) {
-                    for (int j = 0; j < 4; j++) {
-                        mInv[i][j] = nan;
-                    }
-                }
-            }
+            mInv = inv.has_value() ? inv.value() : nanMatrix();
         }
 
         explicit Transform(const float mat[4][4]) : Transform(Mat4(mat)) {};
@@ -36,40 +29,51 @@ namespace jtx {
         explicit Transform(const Frame &f) : Transform(Mat4(f)) {};
 
         ~Transform() = default;
+
+        // Same as Transform(m), but inverts with Mat4::inverseFast()
+        [[nodiscard]] JTX_HOST static Transform fromMatrixFast(const Mat4 &m) {
+            std::optional<Mat4> inv = m.inverseFast();
+            return {m, inv.has_value() ? inv.value() : nanMatrix()};
+        }
         //endregion
 
         //region Getters
-        [[nodiscard]] const Mat4 &getMatrix() const {
+        [[nodiscard]] constexpr const Mat4 &getMatrix() const {
             return m;
         }
 
-        [[nodiscard]] const Mat4 &getInverseMatrix() const {
+        [[nodiscard]] constexpr const Mat4 &getInverseMatrix() const {
             return mInv;
         }
         //endregion
 
         //region Operators
-        bool operator==(const Transform &other) const {
+        constexpr bool operator==(const Transform &other) const {
             return m == other.m;
         }
 
-        bool operator!=(const Transform &other) const {
+        constexpr bool operator!=(const Transform &other) const {
             return m != other.m;
         }
 
-        JTX_INLINE Transform operator*(const Transform &other) const {
+        JTX_INLINE constexpr Transform operator*(const Transform &other) const {
             return {m * other.m, other.mInv * mInv};
         }
+
+        // Composes with Mat4::mulFast(), for when many transforms are chained per frame
+        [[nodiscard]] JTX_HOST Transform mulFast(const Transform &other) const {
+            return {m.mulFast(other.m), other.mInv.mulFast(mInv)};
+        }
         //endregion
 
         //region Methods
-        [[nodiscard]] bool isIdentity() const { return m.isIdentity(); }
+        [[nodiscard]] constexpr bool isIdentity() const { return m.isIdentity(); }
 
-        [[nodiscard]] JTX_INLINE Transform inverse() const {
+        [[nodiscard]] JTX_INLINE constexpr Transform inverse() const {
             return {mInv, m};
         }
 
-        [[nodiscard]] JTX_INLINE Transform transpose() const {
+        [[nodiscard]] JTX_INLINE constexpr Transform transpose() const {
             return {m.transpose(), mInv.transpose()};
 
         }
@@ -77,35 +81,69 @@ namespace jtx {
         // Need to differentiate because points and normals are just typedefs
 
         JTX_NUM_ONLY_T
-        [[nodiscard]] JTX_INLINE Point3<T> applyToPoint(const Point3<T> &p) const {
+        [[nodiscard]] JTX_INLINE constexpr Point3<T> applyToPoint(const Point3<T> &p) const {
             return m.applyToPoint(p);
         }
 
         JTX_NUM_ONLY_T
-        [[nodiscard]] JTX_INLINE Point3<T> applyInverseToPoint(const Point3<T> &p) const {
+        [[nodiscard]] JTX_INLINE constexpr Point3<T> applyInverseToPoint(const Point3<T> &p) const {
             return mInv.applyToPoint(p);
         }
 
         JTX_NUM_ONLY_T
-        [[nodiscard]] JTX_INLINE Vec3<T> applyToVec(const Vec3<T> &v) const {
+        [[nodiscard]] JTX_INLINE constexpr Vec3<T> applyToVec(const Vec3<T> &v) const {
             return m.applyToVec(v);
         }
 
         JTX_NUM_ONLY_T
-        [[nodiscard]] JTX_INLINE Vec3<T> applyInverseToVec(const Vec3<T> &v) const {
+        [[nodiscard]] JTX_INLINE constexpr Vec3<T> applyInverseToVec(const Vec3<T> &v) const {
             return mInv.applyToVec(v);
         }
 
         JTX_NUM_ONLY_T
-        [[nodiscard]] JTX_INLINE Normal3<T> applyToNormal(const Normal3<T> &n) const {
+        [[nodiscard]] JTX_INLINE constexpr Normal3<T> applyToNormal(const Normal3<T> &n) const {
             return mInv.applyToNormal(n);
         }
 
         JTX_NUM_ONLY_T
-        [[nodiscard]] JTX_INLINE Normal3<T> applyInverseToNormal(const Normal3<T> &n) const {
+        [[nodiscard]] JTX_INLINE constexpr Normal3<T> applyInverseToNormal(const Normal3<T> &n) const {
             return m.applyToNormal(n);
         }
 
+        // Batch versions of the above, vectorized through simdKernels(). out must be as long as in and may be the
+        // same span. Disjoint ranges can be handed to different threads
+        JTX_HOST void applyToPoints(jstd::span<const Point3f> in, jstd::span<Point3f> out) const {
+            ASSERT(out.size() >= in.size());
+            jtx::batchTransformPoints(m, in.data(), out.data(), in.size());
+        }
+
+        JTX_HOST void applyToVecs(jstd::span<const Vec3f> in, jstd::span<Vec3f> out) const {
+            ASSERT(out.size() >= in.size());
+            jtx::batchTransformVectors(m, in.data(), out.data(), in.size());
+        }
+
+        // Normals go through the transposed inverse, see applyToNormal
+        JTX_HOST void applyToNormals(jstd::span<const Normal3f> in, jstd::span<Normal3f> out) const {
+            ASSERT(out.size() >= in.size());
+            jtx::batchTransformVectors(mInv.transpose(), in.data(), out.data(), in.size());
+        }
+
+        // SoA overloads, each component array holds n floats
+        JTX_HOST void applyToPoints(const float *x, const float *y, const float *z,
+                                    float *outX, float *outY, float *outZ, size_t n) const {
+            jtx::batchTransformPoints(m, x, y, z, outX, outY, outZ, n);
+        }
+
+        JTX_HOST void applyToVecs(const float *x, const float *y, const float *z,
+                                  float *outX, float *outY, float *outZ, size_t n) const {
+            jtx::batchTransformVectors(m, x, y, z, outX, outY, outZ, n);
+        }
+
+        JTX_HOST void applyToNormals(const float *x, const float *y, const float *z,
+                                     float *outX, float *outY, float *outZ, size_t n) const {
+            jtx::batchTransformVectors(mInv.transpose(), x, y, z, outX, outY, outZ, n);
+        }
+
         // TODO: add edge of error corrections
         [[nodiscard]] JTX_INLINE Rayf applyToRay(const Rayf &ray) const {
             return m.applyToRay(ray);
@@ -131,33 +169,55 @@ namespace jtx {
             return mInv.applyToBBox(bbox);
         }
 
+        // Batch version of applyToBBox, out must be as long as in and may be the same span
+        JTX_HOST void applyToBBoxes(jstd::span<const BBox3f> in, jstd::span<BBox3f> out) const {
+            ASSERT(out.size() >= in.size());
+            jtx::batchTransformBoxes(m, in.data(), out.data(), in.size());
+        }
+
         [[nodiscard]] JTX_INLINE bool swapsHandedness() const {
             return m.determinant3x3() < 0;
         }
         //endregion
 
         //region Static methods
-        static Transform translate(const float delta) {
+        static constexpr Transform translate(const float delta) {
             return {jtx::translate(delta), jtx::translate(-delta)};
         }
 
-        static Transform translate(float x, float y, float z) {
+        static constexpr Transform translate(float x, float y, float z) {
             return {jtx::translate(x, y, z), jtx::translate(-x, -y, -z)};
         }
 
-        static Transform translate(const Vec3f &v) {
+        static constexpr Transform translate(const Vec3f &v) {
             return {jtx::translate(v.x, v.y, v.z), jtx::translate(-v.x, -v.y, -v.z)};
         }
 
-        static Transform scale(float sx, float sy, float sz) {
+        static constexpr Transform scale(float sx, float sy, float sz) {
             ASSERT(sx != 0 && sy != 0 && sz != 0);
             return {jtx::scale(sx, sy, sz), jtx::scale(1 / sx, 1 / sy, 1 / sz)};
         }
 
-        static Transform scale(const Vec3f &s) {
+        static constexpr Transform scale(const Vec3f &s) {
             return scale(s.x, s.y, s.z);
         }
 
+        // Constexpr, for rotations whose sine and cosine are known up front
+        static constexpr Transform rotateX(float sinTheta, float cosTheta) {
+            auto m = jtx::rotateX(sinTheta, cosTheta);
+            return {m, m.transpose()};
+        }
+
+        static constexpr Transform rotateY(float sinTheta, float cosTheta) {
+            auto m = jtx::rotateY(sinTheta, cosTheta);
+            return {m, m.transpose()};
+        }
+
+        static constexpr Transform rotateZ(float sinTheta, float cosTheta) {
+            auto m = jtx::rotateZ(sinTheta, cosTheta);
+            return {m, m.transpose()};
+        }
+
         static Transform rotateX(float theta) {
             auto m = jtx::rotateX(theta);
             return {m, m.transpose()};
@@ -207,13 +267,26 @@ namespace jtx {
 
         Mat4 m;
         Mat4 mInv;
+
+    private:
+        // Stands in for the inverse of a singular matrix
+        static constexpr Mat4 nanMatrix() {
+            float nan = std::numeric_limits<float>::signaling_NaN();
+            Mat4 res;
+            for (int i = 0; i < 4; i++) {
+                for (int j = 0; j < 4; j++) {
+                    res[i][j] = nan;
+                }
+            }
+            return res;
+        }
     };
 
-    JTX_INLINE Transform inverse(const Transform &t) {
+    JTX_INLINE constexpr Transform inverse(const Transform &t) {
         return t.inverse();
     }
 
-    JTX_INLINE Transform transpose(const Transform &t) {
+    JTX_INLINE constexpr Transform transpose(const Transform &t) {
         return t.transpose();
     }
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <jtxlib/math/constants.hpp>
 #include <jtxlib/math/math.hpp>
 #include <jtxlib/math/numerical.hpp>
+#include <jtxlib/math/veccore.hpp>
 #include <jtxlib/util/assert.hpp>
 #include <stdexcept>
 #include <string>
@@ -15,7 +16,7 @@ template<typename T>
 class Vec4;
 
 template<typename T>
-class Vec2 {
+class Vec2 : public VecOps<Vec2<T>, T, 2> {
     static_assert(std::is_arithmetic_v<T>, "Vec2 can only be instantiated with arithmetic types");
 
 public:
@@ -27,185 +28,43 @@ public:
     }
 
     //region Constructors
-    JTX_HOSTDEV Vec2() : x(JTX_ZERO), y(JTX_ZERO) {};
+    JTX_HOSTDEV constexpr Vec2() : x(JTX_ZERO), y(JTX_ZERO) {};
 
-    JTX_HOSTDEV Vec2(T x, T y) : x(x), y(y) { ASSERT(valid()); };
+    JTX_HOSTDEV constexpr Vec2(T x, T y) : x(x), y(y) { ASSERT(valid()); };
 
-    JTX_HOSTDEV Vec2(const Vec2 &other) : x(other.x), y(other.y) { ASSERT(valid()); };
+    JTX_HOSTDEV constexpr Vec2(const Vec2 &other) : x(other.x), y(other.y) { ASSERT(valid()); };
 
     template<typename U>
-    JTX_HOSTDEV explicit Vec2(const Vec2<U> &other) : x(T(other.x)), y(T(other.y)) { ASSERT(valid()); };
+    JTX_HOSTDEV constexpr explicit Vec2(const Vec2<U> &other) : x(T(other.x)), y(T(other.y)) { ASSERT(valid()); };
 
-    JTX_HOSTDEV Vec2(const Vec3<T> &other, T z) : x(other.x), y(other.y) { ASSERT(valid()); };
+    JTX_HOSTDEV constexpr Vec2(const Vec3<T> &other, T z) : x(other.x), y(other.y) { ASSERT(valid()); };
 
-    JTX_HOSTDEV Vec2(const Vec4<T> &other) : x(other.x), y(other.y) { ASSERT(valid()); };
+    JTX_HOSTDEV constexpr Vec2(const Vec4<T> &other) : x(other.x), y(other.y) { ASSERT(valid()); };
 
-    JTX_HOSTDEV explicit Vec2(const float *data) : x(data[0]), y(data[1]) { ASSERT(valid()); };
+    JTX_HOSTDEV constexpr explicit Vec2(const float *data) : x(data[0]), y(data[1]) { ASSERT(valid()); };
 
     ~Vec2() = default;
     //endregion
 
-    //region Unary operators
-    JTX_HOSTDEV Vec2 operator-() const {
-        return {-x, -y};
-    }
-
-    JTX_HOSTDEV Vec2 operator+() const {
-        return {+x, +y};
-    }
-
-    JTX_HOSTDEV Vec2 &operator++() {
-        ++x;
-        ++y;
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec2 operator++(int) {
-        Vec2 temp = *this;
-        ++x;
-        ++y;
-        return temp;
-    }
-
-    JTX_HOSTDEV Vec2 &operator--() {
-        --x;
-        --y;
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec2 operator--(int) {
-        Vec2 temp = *this;
-        --x;
-        --y;
-        return temp;
-    }
-    //endregion
-
     //region Binary operators
-    JTX_HOSTDEV Vec2 &operator=(const Vec2 &other) {
+    // Arithmetic and comparison operators are in VecOps, see veccore.hpp
+    JTX_HOSTDEV constexpr Vec2 &operator=(const Vec2 &other) {
         ASSERT(other.valid());
         x = other.x;
         y = other.y;
         return *this;
     }
-
-    JTX_HOSTDEV bool operator==(const Vec2 &other) const {
-        return (x == other.x) && (y == other.y);
-    }
-
-    JTX_HOSTDEV bool operator!=(const Vec2 &other) const {
-        return (x != other.x) || (y != other.y);
-    }
-
-    JTX_HOSTDEV Vec2 operator+(const Vec2 &other) const {
-        return {x + other.x, y + other.y};
-    }
-
-    JTX_HOSTDEV Vec2 operator+(const T scalar) const {
-        return {x + scalar, y + scalar};
-    }
-
-    JTX_HOSTDEV Vec2 operator-(const Vec2 &other) const {
-        return {x - other.x, y - other.y};
-    }
-
-    JTX_HOSTDEV Vec2 operator-(const T scalar) const {
-        return {x - scalar, y - scalar};
-    }
-
-    JTX_HOSTDEV Vec2 operator*(const Vec2 &other) const {
-        return {x * other.x, y * other.y};
-    }
-
-    JTX_HOSTDEV Vec2 operator*(T scalar) const {
-        return {x * scalar, y * scalar};
-    }
-
-    friend JTX_HOSTDEV Vec2 operator*(T scalar, const Vec2 &v) {
-        return v * scalar;
-    }
-
-    JTX_HOSTDEV Vec2 operator/(const Vec2 &other) const {
-        ASSERT(JTX_ZERO != other.x && JTX_ZERO != other.y);
-        return {x / other.x, y / other.y};
-    }
-
-    JTX_HOSTDEV Vec2 operator/(T scalar) const {
-        ASSERT(JTX_ZERO != scalar);
-        return {x / scalar, y / scalar};
-    }
-
-    friend JTX_HOSTDEV Vec2 operator/(T scalar, const Vec2 &v) {
-        ASSERT(JTX_ZERO != scalar);
-        return {scalar / v.x, scalar / v.y};
-    }
     //endregion
 
-    //region In-place Assignment Operators
-    JTX_HOSTDEV Vec2 &operator+=(const Vec2 &other) {
-        x += other.x;
-        y += other.y;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec2 &operator+=(const T scalar) {
-        x += scalar;
-        y += scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec2 &operator-=(const Vec2 &other) {
-        x -= other.x;
-        y -= other.y;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec2 &operator-=(const T scalar) {
-        x -= scalar;
-        y -= scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec2 &operator*=(const Vec2 &other) {
-        x *= other.x;
-        y *= other.y;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec2 &operator*=(T scalar) {
-        x *= scalar;
-        y *= scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec2 &operator/=(const Vec2 &other) {
-        x /= other.x;
-        y /= other.y;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec2 &operator/=(T scalar) {
-        x /= scalar;
-        y /= scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV const T &operator[](int index) const {
+    //region Access
+    JTX_HOSTDEV constexpr const T &operator[](int index) const {
         ASSERT(index >= 0 && index < 2);
-        return (&x)[index];
+        return detail::at<2>(*this, index);
     }
 
-    JTX_HOSTDEV T &operator[](int index) {
+    JTX_HOSTDEV constexpr T &operator[](int index) {
         ASSERT(index >= 0 && index < 2);
-        return (&x)[index];
+        return detail::at<2>(*this, index);
     }
     //endregion
 
@@ -214,11 +73,11 @@ public:
         return jtx::Equals(x, other.x, epsilon) && jtx::Equals(y, other.y, epsilon);
     }
 
-    [[nodiscard]] JTX_HOSTDEV T dot(const Vec2 &other) const {
+    [[nodiscard]] JTX_HOSTDEV constexpr T dot(const Vec2 &other) const {
         return x * other.x + y * other.y;
     }
 
-    [[nodiscard]] JTX_HOSTDEV T dot(const T _x, const T _y) const {
+    [[nodiscard]] JTX_HOSTDEV constexpr T dot(const T _x, const T _y) const {
         return this->x * _x + this->y * _y;
     }
 
@@ -232,16 +91,33 @@ public:
         return jtx::Abs(dot(other));
     }
 
-    JTX_HOSTDEV float len() const { return jtx::Sqrt(x * x + y * y); }
+    // P is a precision policy, see policy.hpp
+    template<typename P = Exact>
+    JTX_HOSTDEV FloatType<T> len() const {
+        FloatType<T> l2 = lenSqr();
+        if constexpr (IsApprox<P>) {
+            return l2 == 0 ? 0 : l2 * jtx::Rsqrt<P>(l2);
+        } else {
+            return jtx::Sqrt(l2);
+        }
+    }
 
-    JTX_HOSTDEV float lenSqr() const {
+    JTX_HOSTDEV constexpr FloatType<T> lenSqr() const {
         return x * x + y * y;
     }
 
+    template<typename P = Exact>
     JTX_HOSTDEV Vec2 &normalize() {
-        float l = len();
-        if (l != 0) {
-            *this /= l;
+        if constexpr (IsApprox<P>) {
+            FloatType<T> l2 = lenSqr();
+            if (l2 != 0) {
+                *this *= jtx::Rsqrt<P>(l2);
+            }
+        } else {
+            FloatType<T> l = len();
+            if (l != 0) {
+                *this /= l;
+            }
         }
         return *this;
     }
@@ -266,7 +142,7 @@ public:
         return jtx::Max(x, y);
     }
 
-    JTX_HOSTDEV T hprod() const {
+    JTX_HOSTDEV constexpr T hprod() const {
         return x * y;
     }
     //endregion
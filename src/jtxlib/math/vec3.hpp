@@ -5,6 +5,7 @@
 #include <jtxlib/math/constants.hpp>
 #include <jtxlib/math/math.hpp>
 #include <jtxlib/math/numerical.hpp>
+#include <jtxlib/math/veccore.hpp>
 #include <jtxlib/util/assert.hpp>
 #include <jtxlib/util/rand.hpp>
 #include <stdexcept>
@@ -16,7 +17,7 @@ template<typename T>
 class Vec4;
 
 template<typename T>
-class Vec3 {
+class Vec3 : public VecOps<Vec3<T>, T, 3> {
     static_assert(std::is_arithmetic_v<T>, "Vec3 can only be instantiated with arithmetic types");
 
 public:
@@ -35,21 +36,21 @@ public:
     }
 
 #pragma region Constructors
-    JTX_HOSTDEV Vec3() : x(JTX_ZERO), y(JTX_ZERO), z(JTX_ZERO) {}
+    JTX_HOSTDEV constexpr Vec3() : x(JTX_ZERO), y(JTX_ZERO), z(JTX_ZERO) {}
 
-    JTX_HOSTDEV explicit Vec3(T v) : x(v), y(v), z(v){};
+    JTX_HOSTDEV constexpr explicit Vec3(T v) : x(v), y(v), z(v){};
 
-    JTX_HOSTDEV Vec3(T x, T y, T z) : x(x), y(y), z(z) {};
+    JTX_HOSTDEV constexpr Vec3(T x, T y, T z) : x(x), y(y), z(z) {};
 
-    JTX_HOSTDEV Vec3(const Vec3 &other) : x(other.x), y(other.y), z(other.z) {};
+    JTX_HOSTDEV constexpr Vec3(const Vec3 &other) : x(other.x), y(other.y), z(other.z) {};
 
     template<typename U>
-    JTX_HOSTDEV explicit Vec3(const Vec3<U> &other) : x(T(other.x)), y(T(other.y)), z(T(other.z)){};
+    JTX_HOSTDEV constexpr explicit Vec3(const Vec3<U> &other) : x(T(other.x)), y(T(other.y)), z(T(other.z)){};
 
-    JTX_HOSTDEV Vec3(const Vec2<T> &other, T z) : x(other.x), y(other.y), z(z) {};
-    JTX_HOSTDEV explicit Vec3(const Vec4<T> &other) : x(other.x), y(other.y), z(other.z){};
+    JTX_HOSTDEV constexpr Vec3(const Vec2<T> &other, T z) : x(other.x), y(other.y), z(z) {};
+    JTX_HOSTDEV constexpr explicit Vec3(const Vec4<T> &other) : x(other.x), y(other.y), z(other.z){};
 
-    JTX_HOSTDEV explicit Vec3(const T *data) : x(data[0]), y(data[1]), z(data[2]){};
+    JTX_HOSTDEV constexpr explicit Vec3(const T *data) : x(data[0]), y(data[1]), z(data[2]){};
 
     JTX_HOSTDEV
     static Vec3 fromXY(Vec2<T> xy, float Y) {
@@ -60,241 +61,81 @@ public:
     ~Vec3() = default;
 #pragma endregion
 
-#pragma region Unary operators
-    JTX_HOSTDEV Vec3 operator-() const {
-        return {-x, -y, -z};
-    }
-
-    JTX_HOSTDEV Vec3 operator+() const {
-        return {+x, +y, +z};
-    }
-
-    JTX_HOSTDEV Vec3 &operator++() {
-        ++x;
-        ++y;
-        ++z;
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec3 operator++(int) {
-        Vec3 temp = *this;
-        ++x;
-        ++y;
-        ++z;
-        return temp;
-    }
-
-    JTX_HOSTDEV Vec3 &operator--() {
-        --x;
-        --y;
-        --z;
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec3 operator--(int) {
-        Vec3 temp = *this;
-        --x;
-        --y;
-        --z;
-        return temp;
-    }
-
+#pragma region Conversion operators
     template<typename U>
-    JTX_HOSTDEV explicit operator Vec3<U>() const {
+    JTX_HOSTDEV constexpr explicit operator Vec3<U>() const {
         return {U(x), U(y), U(z)};
     }
 
-    JTX_HOSTDEV explicit operator bool() const {
+    JTX_HOSTDEV constexpr explicit operator bool() const {
         return x || y || z;
     }
 
 #pragma endregion
 
 #pragma region Binary operators
-    JTX_HOSTDEV Vec3 &operator=(const Vec3 &other) {
+    // Arithmetic and comparison operators are in VecOps, see veccore.hpp
+    JTX_HOSTDEV constexpr Vec3 &operator=(const Vec3 &other) {
         x = other.x;
         y = other.y;
         z = other.z;
         return *this;
     }
 
-    JTX_HOSTDEV bool operator==(const Vec3 &other) const {
-        return (x == other.x) && (y == other.y) && (z == other.z);
-    }
-
-    JTX_HOSTDEV bool operator!=(const Vec3 &other) const {
-        return (x != other.x) || (y != other.y) || (z != other.z);
-    }
-
-    JTX_HOSTDEV Vec3 operator+(const Vec3 &other) const {
-        return {x + other.x, y + other.y, z + other.z};
-    }
-
-    JTX_HOSTDEV Vec3 operator+(const T scalar) const {
-        return {x + scalar, y + scalar, z + scalar};
-    }
-
-    JTX_HOSTDEV friend Vec3 operator+(T scalar, const Vec3 &v) {
-        return v + scalar;
-    }
-
-    JTX_HOSTDEV Vec3 operator-(const Vec3 &other) const {
-        return {x - other.x, y - other.y, z - other.z};
-    }
-
-    JTX_HOSTDEV Vec3 operator-(const T scalar) const {
-        return {x - scalar, y - scalar, z - scalar};
-    }
-
-    JTX_HOSTDEV friend Vec3 operator-(T scalar, const Vec3 &v) {
-        return {scalar - v.x, scalar - v.y, scalar - v.z};
-    }
-
-    JTX_HOSTDEV Vec3 operator*(const Vec3 &other) const {
-        return {x * other.x, y * other.y, z * other.z};
-    }
-
-    JTX_HOSTDEV Vec3 operator*(T scalar) const {
-        return {x * scalar, y * scalar, z * scalar};
-    }
-
-    JTX_HOSTDEV friend Vec3 operator*(T scalar, const Vec3 &v) {
-        return v * scalar;
-    }
-
-    JTX_HOSTDEV Vec3 operator/(const Vec3 &other) const {
-        ASSERT(JTX_ZERO != other.x && JTX_ZERO != other.y && JTX_ZERO != other.z);
-        return {x / other.x, y / other.y, z / other.z};
-    }
-
-    JTX_HOSTDEV Vec3 operator/(T scalar) const {
-        ASSERT(JTX_ZERO != scalar);
-        return {x / scalar, y / scalar, z / scalar};
-    }
-
-    JTX_HOSTDEV friend Vec3 operator/(T scalar, const Vec3 &v) {
-        ASSERT(JTX_ZERO != scalar);
-        return {scalar / v.x, scalar / v.y, scalar / v.z};
-    }
-
-    JTX_HOSTDEV Vec3 operator<<(uint32_t shift) {
+    JTX_HOSTDEV constexpr Vec3 operator<<(uint32_t shift) {
         return {x << shift, y << shift, z << shift};
     }
 
-    JTX_HOSTDEV Vec3 operator>>(uint32_t shift) const {
+    JTX_HOSTDEV constexpr Vec3 operator>>(uint32_t shift) const {
         return {x >> shift, y >> shift, z >> shift};
     }
 
-    JTX_HOSTDEV Vec3 operator^(uint32_t scalar) const {
+    JTX_HOSTDEV constexpr Vec3 operator^(uint32_t scalar) const {
         return {x ^ scalar, y ^ scalar, z ^ scalar};
     }
 
-    JTX_HOSTDEV Vec3 operator^(const Vec3 &p) const {
+    JTX_HOSTDEV constexpr Vec3 operator^(const Vec3 &p) const {
         return {x ^ p.x, y ^ p.y, z ^ p.z};
     }
 #pragma endregion
 
 #pragma region In-place Assignment Operators
-    JTX_HOSTDEV Vec3 &operator+=(const Vec3 &other) {
-        x += other.x;
-        y += other.y;
-        z += other.z;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec3 &operator+=(const T scalar) {
-        x += scalar;
-        y += scalar;
-        z += scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec3 &operator-=(const Vec3 &other) {
-        x -= other.x;
-        y -= other.y;
-        z -= other.z;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec3 &operator-=(const T scalar) {
-        x -= scalar;
-        y -= scalar;
-        z -= scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec3 &operator*=(const Vec3 &other) {
-        x *= other.x;
-        y *= other.y;
-        z *= other.z;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec3 &operator*=(T scalar) {
-        x *= scalar;
-        y *= scalar;
-        z *= scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec3 &operator/=(const Vec3 &other) {
-        x /= other.x;
-        y /= other.y;
-        z /= other.z;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec3 &operator/=(T scalar) {
-        x /= scalar;
-        y /= scalar;
-        z /= scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec3 &operator^=(const Vec3 &other) {
+    JTX_HOSTDEV constexpr Vec3 &operator^=(const Vec3 &other) {
         x ^= other.x;
         y ^= other.y;
         z ^= other.z;
         return *this;
     }
 
-    JTX_HOSTDEV Vec3 &operator^=(const uint32_t scalar) {
+    JTX_HOSTDEV constexpr Vec3 &operator^=(const uint32_t scalar) {
         x ^= scalar;
         y ^= scalar;
         z ^= scalar;
         return *this;
     }
 
-    JTX_HOSTDEV Vec3 &operator>>=(uint32_t shift) {
+    JTX_HOSTDEV constexpr Vec3 &operator>>=(uint32_t shift) {
         x >>= shift;
         y >>= shift;
         z >>= shift;
         return *this;
     }
 
-    JTX_HOSTDEV Vec3 &operator<<=(uint32_t shift) {
+    JTX_HOSTDEV constexpr Vec3 &operator<<=(uint32_t shift) {
         x <<= shift;
         y <<= shift;
         z <<= shift;
         return *this;
     }
 
-    JTX_HOSTDEV const T &operator[](int index) const {
+    JTX_HOSTDEV constexpr const T &operator[](int index) const {
         ASSERT(index >= 0 && index < 3);
-        return (&x)[index];
+        return detail::at<3>(*this, index);
     }
 
-    JTX_HOSTDEV T &operator[](int index) {
+    JTX_HOSTDEV constexpr T &operator[](int index) {
         ASSERT(index >= 0 && index < 3);
-        return (&x)[index];
+        return detail::at<3>(*this, index);
     }
 #pragma endregion
 
@@ -304,24 +145,25 @@ public:
                jtx::Equals(z, other.z, epsilon);
     }
 
-    [[nodiscard]] JTX_HOSTDEV T Dot(const Vec3 &other) const {
-        return x * other.x + y * other.y + z * other.z;
+    // P is a rounding policy, see policy.hpp. Precise only changes float vectors, like jtx::Dot
+    template<typename P = DefaultRounding>
+    [[nodiscard]] JTX_HOSTDEV constexpr T Dot(const Vec3 &other) const {
+        if constexpr (IsPrecise<P> && std::is_same_v<T, float>) {
+            return jtx::sumOfProducts<P>(x, other.x, y, other.y, z, other.z);
+        } else {
+            return x * other.x + y * other.y + z * other.z;
+        }
     }
 
-    [[nodiscard]] JTX_HOSTDEV T Dot(const T _x, const T _y, const T _z) const {
+    [[nodiscard]] JTX_HOSTDEV constexpr T Dot(const T _x, const T _y, const T _z) const {
         return this->x * _x + this->y * _y + this->z * _z;
     }
 
-    [[nodiscard]] JTX_HOSTDEV Vec3 cross(const Vec3 &other) const {
-#ifdef JTXLIB_MINIMIZE_FP_ERROR
-        return {jtx::dop(y, other.z, z, other.y),
-                jtx::dop(z, other.x, x, other.z),
-                jtx::dop(x, other.y, y, other.x)};
-#else
-         return {y * other.z - z * other.y,
-                 z * other.x - x * other.z,
-                 x * other.y - y * other.x};
-#endif
+    template<typename P = DefaultRounding>
+    [[nodiscard]] JTX_HOSTDEV constexpr Vec3 cross(const Vec3 &other) const {
+        return {jtx::differenceOfProducts<P>(y, other.z, z, other.y),
+                jtx::differenceOfProducts<P>(z, other.x, x, other.z),
+                jtx::differenceOfProducts<P>(x, other.y, y, other.x)};
     }
 
 
@@ -336,16 +178,33 @@ public:
         return jtx::Abs(Dot(other));
     }
 
-    [[nodiscard]] JTX_HOSTDEV float LengthSquared() const {
+    [[nodiscard]] JTX_HOSTDEV constexpr FloatType<T> LengthSquared() const {
         return x * x + y * y + z * z;
     }
 
-    [[nodiscard]] JTX_HOSTDEV float Length() const { return jtx::Sqrt(LengthSquared()); }
+    // P is a precision policy, see policy.hpp
+    template<typename P = Exact>
+    [[nodiscard]] JTX_HOSTDEV FloatType<T> Length() const {
+        FloatType<T> l2 = LengthSquared();
+        if constexpr (IsApprox<P>) {
+            return l2 == 0 ? 0 : l2 * jtx::Rsqrt<P>(l2);
+        } else {
+            return jtx::Sqrt(l2);
+        }
+    }
 
+    template<typename P = Exact>
     JTX_HOSTDEV Vec3 &Normalize() {
-        float l = Length();
-        if (l != 0) {
-            (*this) /= l;
+        if constexpr (IsApprox<P>) {
+            FloatType<T> l2 = LengthSquared();
+            if (l2 != 0) {
+                (*this) *= jtx::Rsqrt<P>(l2);
+            }
+        } else {
+            FloatType<T> l = Length();
+            if (l != 0) {
+                (*this) /= l;
+            }
         }
         return *this;
     }
@@ -376,7 +235,7 @@ public:
         return jtx::Max(z, jtx::Max(x, y));
     }
 
-    [[nodiscard]] JTX_HOSTDEV T hprod() const {
+    [[nodiscard]] JTX_HOSTDEV constexpr T hprod() const {
         return x * y * z;
     }
 
@@ -501,6 +360,19 @@ public:
         return {x, y, z};
     }
 
+    /**
+     * Re-orthonormalizes a frame that drifted, e.g. after many incremental rotations: z is renormalized, x is made
+     * orthogonal to it (Gram-Schmidt) and y is recomputed from both. P is a precision policy, see policy.hpp
+     */
+    template<typename P = Exact>
+    [[nodiscard]] JTX_HOSTDEV Frame orthonormalized() const {
+        Vec3f nz = z;
+        nz.Normalize<P>();
+        Vec3f nx = x - nz * x.Dot(nz);
+        nx.Normalize<P>();
+        return {nx, nz.cross(nx), nz};
+    }
+
     [[nodiscard]] JTX_HOSTDEV Vec3f ToLocal(const Vec3f &v) const {
         return {v.Dot(x), v.Dot(y), v.Dot(z)};
     }
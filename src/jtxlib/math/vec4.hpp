@@ -4,6 +4,7 @@
 #include <jtxlib/math/constants.hpp>
 #include <jtxlib/math/math.hpp>
 #include <jtxlib/math/numerical.hpp>
+#include <jtxlib/math/veccore.hpp>
 #include <jtxlib/util/assert.hpp>
 #include <stdexcept>
 #include <string>
@@ -15,7 +16,7 @@ template<typename T>
 class Vec3;
 
 template<typename T>
-class Vec4 {
+class Vec4 : public VecOps<Vec4<T>, T, 4> {
     static_assert(std::is_arithmetic_v<T>, "Vec4 can only be instantiated with arithmetic types");
 
 public:
@@ -34,69 +35,33 @@ public:
     }
 
     //region Constructors
-    JTX_HOSTDEV Vec4() : x(JTX_ZERO), y(JTX_ZERO), z(JTX_ZERO), w(JTX_ZERO) {};
+    JTX_HOSTDEV constexpr Vec4() : x(JTX_ZERO), y(JTX_ZERO), z(JTX_ZERO), w(JTX_ZERO) {};
 
-    JTX_HOSTDEV Vec4(T x, T y, T z, T w) : x(x), y(y), z(z), w(w) { ASSERT(valid()); };
+    JTX_HOSTDEV constexpr Vec4(T x, T y, T z, T w) : x(x), y(y), z(z), w(w) { ASSERT(valid()); };
 
-    JTX_HOSTDEV Vec4(const Vec4 &other) : x(other.x), y(other.y), z(other.z), w(other.w) { ASSERT(valid()); };
+    JTX_HOSTDEV constexpr Vec4(const Vec4 &other) : x(other.x), y(other.y), z(other.z), w(other.w) {
+        ASSERT(valid());
+    };
 
     template<typename U>
-    JTX_HOSTDEV explicit Vec4(const Vec4<U> &other) : x(T(other.x)), y(T(other.y)), z(T(other.z)), w(T(other.w)) {
+    JTX_HOSTDEV constexpr explicit Vec4(const Vec4<U> &other)
+        : x(T(other.x)), y(T(other.y)), z(T(other.z)), w(T(other.w)) {
         ASSERT(valid());
     };
 
-    JTX_HOSTDEV Vec4(const Vec2<T> &other, T z, T w) : x(other.x), y(other.y), z(z), w(w) { ASSERT(valid()); };
-    JTX_HOSTDEV Vec4(const Vec3<T> &other, T w) : x(other.x), y(other.y), z(other.z), w(w) { ASSERT(valid()); };
+    JTX_HOSTDEV constexpr Vec4(const Vec2<T> &other, T z, T w) : x(other.x), y(other.y), z(z), w(w) {
+        ASSERT(valid());
+    };
+    JTX_HOSTDEV constexpr Vec4(const Vec3<T> &other, T w) : x(other.x), y(other.y), z(other.z), w(w) {
+        ASSERT(valid());
+    };
 
     ~Vec4() = default;
     //endregion
 
-    //region Unary operators
-    JTX_HOSTDEV Vec4 operator-() const {
-        return {-x, -y, -z, -w};
-    }
-
-    JTX_HOSTDEV Vec4 operator+() const {
-        return {+x, +y, +z, +w};
-    }
-
-    JTX_HOSTDEV Vec4 &operator++() {
-        ++x;
-        ++y;
-        ++z;
-        ++w;
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec4 operator++(int) {
-        Vec4 temp = *this;
-        ++x;
-        ++y;
-        ++z;
-        ++w;
-        return temp;
-    }
-
-    JTX_HOSTDEV Vec4 &operator--() {
-        --x;
-        --y;
-        --z;
-        --w;
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec4 operator--(int) {
-        Vec4 temp = *this;
-        --x;
-        --y;
-        --z;
-        --w;
-        return temp;
-    }
-    //endregion
-
     //region Binary operators
-    JTX_HOSTDEV Vec4 &operator=(const Vec4 &other) {
+    // Arithmetic and comparison operators are in VecOps, see veccore.hpp
+    JTX_HOSTDEV constexpr Vec4 &operator=(const Vec4 &other) {
         ASSERT(other.valid());
         x = other.x;
         y = other.y;
@@ -105,139 +70,14 @@ public:
         return *this;
     }
 
-    JTX_HOSTDEV bool operator==(const Vec4 &other) const {
-        return (x == other.x) && (y == other.y) && (z == other.z) && (w == other.w);
-    }
-
-    JTX_HOSTDEV bool operator!=(const Vec4 &other) const {
-        return (x != other.x) || (y != other.y) || (z != other.z) || (w != other.w);
-    }
-
-    JTX_HOSTDEV Vec4 operator+(const Vec4 &other) const {
-        return {x + other.x, y + other.y, z + other.z, w + other.w};
-    }
-
-    JTX_HOSTDEV Vec4 operator+(const T scalar) const {
-        return {x + scalar, y + scalar, z + scalar, w + scalar};
-    }
-
-    JTX_HOSTDEV Vec4 operator-(const Vec4 &other) const {
-        return {x - other.x, y - other.y, z - other.z, w - other.w};
-    }
-
-    JTX_HOSTDEV Vec4 operator-(const T scalar) const {
-        return {x - scalar, y - scalar, z - scalar, w - scalar};
-    }
-
-    JTX_HOSTDEV Vec4 operator*(const Vec4 &other) const {
-        return {x * other.x, y * other.y, z * other.z, w * other.w};
-    }
-
-    JTX_HOSTDEV Vec4 operator*(T scalar) const {
-        return {x * scalar, y * scalar, z * scalar, w * scalar};
-    }
-
-    friend JTX_HOSTDEV Vec4 operator*(T scalar, const Vec4 &v) {
-        return v * scalar;
-    }
-
-    JTX_HOSTDEV Vec4 operator/(const Vec4 &other) const {
-        ASSERT(JTX_ZERO != other.x && JTX_ZERO != other.y && JTX_ZERO != other.z && JTX_ZERO != other.w);
-        return {x / other.x, y / other.y, z / other.z, w / other.w};
-    }
-
-    JTX_HOSTDEV Vec4 operator/(T scalar) const {
-        ASSERT(JTX_ZERO != scalar);
-        return {x / scalar, y / scalar, z / scalar, w / scalar};
-    }
-
-    friend JTX_HOSTDEV Vec4 operator/(T scalar, const Vec4 &v) {
-        ASSERT(JTX_ZERO != scalar);
-        return {scalar / v.x, scalar / v.y, scalar / v.z, scalar / v.w};
-    }
-
-    JTX_HOSTDEV const T &operator[](int index) const {
+    JTX_HOSTDEV constexpr const T &operator[](int index) const {
         ASSERT(index >= 0 && index < 4);
-        return (&x)[index];
+        return detail::at<4>(*this, index);
     }
 
-    JTX_HOSTDEV T &operator[](int index) {
+    JTX_HOSTDEV constexpr T &operator[](int index) {
         ASSERT(index >= 0 && index < 4);
-        return (&x)[index];
-    }
-    //endregion
-
-    //region In-place Assignment Operators
-    JTX_HOSTDEV Vec4 &operator+=(const Vec4 &other) {
-        x += other.x;
-        y += other.y;
-        z += other.z;
-        w += other.w;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec4 &operator+=(const T scalar) {
-        x += scalar;
-        y += scalar;
-        z += scalar;
-        w += scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec4 &operator-=(const Vec4 &other) {
-        x -= other.x;
-        y -= other.y;
-        z -= other.z;
-        w -= other.w;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec4 &operator-=(const T scalar) {
-        x -= scalar;
-        y -= scalar;
-        z -= scalar;
-        w -= scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec4 &operator*=(const Vec4 &other) {
-        x *= other.x;
-        y *= other.y;
-        z *= other.z;
-        w *= other.w;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec4 &operator*=(T scalar) {
-        x *= scalar;
-        y *= scalar;
-        z *= scalar;
-        w *= scalar;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec4 &operator/=(const Vec4 &other) {
-        x /= other.x;
-        y /= other.y;
-        z /= other.z;
-        w /= other.w;
-        ASSERT(valid());
-        return *this;
-    }
-
-    JTX_HOSTDEV Vec4 &operator/=(T scalar) {
-        x /= scalar;
-        y /= scalar;
-        z /= scalar;
-        w /= scalar;
-        ASSERT(valid());
-        return *this;
+        return detail::at<4>(*this, index);
     }
     //endregion
 
@@ -247,11 +87,11 @@ public:
                jtx::Equals(z, other.z, epsilon) && jtx::Equals(w, other.w, epsilon);
     }
 
-    [[nodiscard]] JTX_HOSTDEV T dot(const Vec4 &other) const {
+    [[nodiscard]] JTX_HOSTDEV constexpr T dot(const Vec4 &other) const {
         return x * other.x + y * other.y + z * other.z + w * other.w;
     }
 
-    [[nodiscard]] JTX_HOSTDEV T dot(const T _x, const T _y, const T _z, const T _w) const {
+    [[nodiscard]] JTX_HOSTDEV constexpr T dot(const T _x, const T _y, const T _z, const T _w) const {
         return this->x * _x + this->y * _y + this->z * _z + this->w * _w;
     }
 
@@ -267,12 +107,31 @@ public:
         return jtx::Abs(dot(other));
     }
 
-    [[nodiscard]] JTX_HOSTDEV float len() const { return jtx::Sqrt(x * x + y * y + z * z + w * w); }
+    [[nodiscard]] JTX_HOSTDEV constexpr FloatType<T> lenSqr() const { return x * x + y * y + z * z + w * w; }
+
+    // P is a precision policy, see policy.hpp
+    template<typename P = Exact>
+    [[nodiscard]] JTX_HOSTDEV FloatType<T> len() const {
+        FloatType<T> l2 = lenSqr();
+        if constexpr (IsApprox<P>) {
+            return l2 == 0 ? 0 : l2 * jtx::Rsqrt<P>(l2);
+        } else {
+            return jtx::Sqrt(l2);
+        }
+    }
 
+    template<typename P = Exact>
     JTX_HOSTDEV Vec4 &normalize() {
-        float l = len();
-        if (l != 0) {
-            (*this) /= l;
+        if constexpr (IsApprox<P>) {
+            FloatType<T> l2 = lenSqr();
+            if (l2 != 0) {
+                (*this) *= jtx::Rsqrt<P>(l2);
+            }
+        } else {
+            FloatType<T> l = len();
+            if (l != 0) {
+                (*this) /= l;
+            }
         }
         return *this;
     }
@@ -301,7 +160,7 @@ public:
         return jtx::Max(jtx::Max(z, w), jtx::Max(x, y));
     }
 
-    JTX_HOSTDEV T hprod() const {
+    JTX_HOSTDEV constexpr T hprod() const {
         return x * y * z * w;
     }
     //endregion
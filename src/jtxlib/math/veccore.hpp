@@ -0,0 +1,227 @@
+/**
+ * Component-wise core shared by Vec2, Vec3 and Vec4
+ *
+ * VecOps<V, T, N> implements the arithmetic and comparison operators once for every vector type instead of
+ * each class spelling them out per component. The component loops are unrolled at compile time, so a + b on
+ * a Vec3f is the same three adds as writing them by hand, with no loop or temporary array left at -O1.
+ * V needs public x, y (z, w) members, a constructor taking N components and to derive from VecOps<V, T, N>.
+ */
+#pragma once
+
+#include <jtxlib.hpp>
+#include <jtxlib/math/constants.hpp>
+#include <jtxlib/math/math.hpp>
+#include <jtxlib/util/assert.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace jtx {
+namespace detail {
+// Calls f(std::integral_constant<int, I>{}) for I = 0, ..., N - 1
+template<int N, typename F>
+JTX_HOSTDEV constexpr void unroll(F &&f) {
+    [&]<int... I>(std::integer_sequence<int, I...>) {
+        (f(std::integral_constant<int, I>{}), ...);
+    }(std::make_integer_sequence<int, N>{});
+}
+
+// Component I by name, unlike operator[] this is usable in constant expressions
+template<int I, typename V>
+JTX_HOSTDEV constexpr auto &component(V &v) {
+    if constexpr (I == 0) return v.x;
+    else if constexpr (I == 1) return v.y;
+    else if constexpr (I == 2) return v.z;
+    else return v.w;
+}
+
+// Component i of an N-component vector. Constant evaluation can't step from x to the next member through a
+// pointer, so it picks the member by name instead
+template<int N, typename V>
+JTX_HOSTDEV constexpr auto &at(V &v, int i) {
+    if (std::is_constant_evaluated()) {
+        if constexpr (N > 3) if (i == 3) return v.w;
+        if constexpr (N > 2) if (i == 2) return v.z;
+        return i == 0 ? v.x : v.y;
+    }
+    return (&v.x)[i];
+}
+
+// V(f(0), ..., f(N - 1)), built in place through V's component constructor
+template<int N, typename V, typename F>
+JTX_HOSTDEV constexpr V generate(F &&f) {
+    return [&]<int... I>(std::integer_sequence<int, I...>) {
+        return V(f(std::integral_constant<int, I>{})...);
+    }(std::make_integer_sequence<int, N>{});
+}
+
+template<int N, typename V, typename F>
+JTX_HOSTDEV constexpr V map(const V &a, F f) {
+    return generate<N, V>([&](auto I) { return f(component<I>(a)); });
+}
+
+template<int N, typename V, typename F>
+JTX_HOSTDEV constexpr V map(const V &a, const V &b, F f) {
+    return generate<N, V>([&](auto I) { return f(component<I>(a), component<I>(b)); });
+}
+
+template<int N, typename V, typename F>
+JTX_HOSTDEV constexpr V map(const V &a, const V &b, const V &c, F f) {
+    return generate<N, V>([&](auto I) { return f(component<I>(a), component<I>(b), component<I>(c)); });
+}
+
+template<int N, typename V, typename F>
+JTX_HOSTDEV constexpr bool all(const V &a, const V &b, F f) {
+    bool res = true;
+    unroll<N>([&](auto I) { res = res && f(component<I>(a), component<I>(b)); });
+    return res;
+}
+}// namespace detail
+
+template<typename V, typename T, int N>
+class VecOps {
+public:
+    //region Unary operators
+    JTX_HOSTDEV constexpr V operator-() const { return detail::map<N>(self(), [](T a) { return T(-a); }); }
+
+    JTX_HOSTDEV constexpr V operator+() const { return self(); }
+
+    JTX_HOSTDEV constexpr V &operator++() {
+        detail::unroll<N>([&](auto I) { ++detail::component<I>(self()); });
+        return self();
+    }
+
+    JTX_HOSTDEV constexpr V operator++(int) {
+        V temp = self();
+        ++*this;
+        return temp;
+    }
+
+    JTX_HOSTDEV constexpr V &operator--() {
+        detail::unroll<N>([&](auto I) { --detail::component<I>(self()); });
+        return self();
+    }
+
+    JTX_HOSTDEV constexpr V operator--(int) {
+        V temp = self();
+        --*this;
+        return temp;
+    }
+    //endregion
+
+    //region Binary operators
+    JTX_HOSTDEV friend constexpr bool operator==(const V &a, const V &b) {
+        return detail::all<N>(a, b, [](T u, T v) { return u == v; });
+    }
+
+    JTX_HOSTDEV friend constexpr bool operator!=(const V &a, const V &b) { return !(a == b); }
+
+    JTX_HOSTDEV friend constexpr V operator+(const V &a, const V &b) {
+        return detail::map<N>(a, b, [](T u, T v) { return u + v; });
+    }
+
+    JTX_HOSTDEV friend constexpr V operator+(const V &a, T s) {
+        return detail::map<N>(a, [s](T u) { return u + s; });
+    }
+
+    JTX_HOSTDEV friend constexpr V operator+(T s, const V &a) { return a + s; }
+
+    JTX_HOSTDEV friend constexpr V operator-(const V &a, const V &b) {
+        return detail::map<N>(a, b, [](T u, T v) { return u - v; });
+    }
+
+    JTX_HOSTDEV friend constexpr V operator-(const V &a, T s) {
+        return detail::map<N>(a, [s](T u) { return u - s; });
+    }
+
+    JTX_HOSTDEV friend constexpr V operator-(T s, const V &a) {
+        return detail::map<N>(a, [s](T u) { return s - u; });
+    }
+
+    JTX_HOSTDEV friend constexpr V operator*(const V &a, const V &b) {
+        return detail::map<N>(a, b, [](T u, T v) { return u * v; });
+    }
+
+    JTX_HOSTDEV friend constexpr V operator*(const V &a, T s) {
+        return detail::map<N>(a, [s](T u) { return u * s; });
+    }
+
+    JTX_HOSTDEV friend constexpr V operator*(T s, const V &a) { return a * s; }
+
+    JTX_HOSTDEV friend constexpr V operator/(const V &a, const V &b) {
+        return detail::map<N>(a, b, [](T u, T v) { return u / v; });
+    }
+
+    JTX_HOSTDEV friend constexpr V operator/(const V &a, T s) {
+        ASSERT(JTX_ZERO != s);
+        return detail::map<N>(a, [s](T u) { return u / s; });
+    }
+
+    JTX_HOSTDEV friend constexpr V operator/(T s, const V &a) {
+        return detail::map<N>(a, [s](T u) { return s / u; });
+    }
+    //endregion
+
+    //region In-place Assignment Operators
+    JTX_HOSTDEV constexpr V &operator+=(const V &other) {
+        detail::unroll<N>([&](auto I) { detail::component<I>(self()) += detail::component<I>(other); });
+        return self();
+    }
+
+    JTX_HOSTDEV constexpr V &operator+=(T s) {
+        detail::unroll<N>([&](auto I) { detail::component<I>(self()) += s; });
+        return self();
+    }
+
+    JTX_HOSTDEV constexpr V &operator-=(const V &other) {
+        detail::unroll<N>([&](auto I) { detail::component<I>(self()) -= detail::component<I>(other); });
+        return self();
+    }
+
+    JTX_HOSTDEV constexpr V &operator-=(T s) {
+        detail::unroll<N>([&](auto I) { detail::component<I>(self()) -= s; });
+        return self();
+    }
+
+    JTX_HOSTDEV constexpr V &operator*=(const V &other) {
+        detail::unroll<N>([&](auto I) { detail::component<I>(self()) *= detail::component<I>(other); });
+        return self();
+    }
+
+    JTX_HOSTDEV constexpr V &operator*=(T s) {
+        detail::unroll<N>([&](auto I) { detail::component<I>(self()) *= s; });
+        return self();
+    }
+
+    JTX_HOSTDEV constexpr V &operator/=(const V &other) {
+        detail::unroll<N>([&](auto I) { detail::component<I>(self()) /= detail::component<I>(other); });
+        return self();
+    }
+
+    JTX_HOSTDEV constexpr V &operator/=(T s) {
+        detail::unroll<N>([&](auto I) { detail::component<I>(self()) /= s; });
+        return self();
+    }
+    //endregion
+
+private:
+    JTX_HOSTDEV constexpr V &self() { return static_cast<V &>(*this); }
+    JTX_HOSTDEV constexpr const V &self() const { return static_cast<const V &>(*this); }
+};
+
+//region Component-wise functions
+// a * b + c per component, fused when the target has FMA (see jtx::mulAdd)
+template<typename V, typename T, int N>
+JTX_HOSTDEV constexpr V fma(const VecOps<V, T, N> &a, const VecOps<V, T, N> &b, const VecOps<V, T, N> &c) {
+    return detail::map<N>(static_cast<const V &>(a), static_cast<const V &>(b), static_cast<const V &>(c),
+                          [](T u, T v, T w) { return jtx::mulAdd(u, v, w); });
+}
+
+// (1 - t) * a + t * b, exact at t = 0 and t = 1
+template<typename V, typename T, int N>
+JTX_HOSTDEV constexpr V Lerp(const VecOps<V, T, N> &a, const VecOps<V, T, N> &b, std::type_identity_t<T> t) {
+    return detail::map<N>(static_cast<const V &>(a), static_cast<const V &>(b),
+                          [t](T u, T v) { return jtx::mulAdd(t, v, jtx::mulAdd(-t, u, u)); });
+}
+//endregion
+}// namespace jtx
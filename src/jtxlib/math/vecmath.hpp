@@ -9,19 +9,29 @@
 
 namespace jtx {
 #pragma region Dot Product
-JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE T Dot(const Vec2<T> &a, const Vec2<T> &b) {
-    return a.x * b.x + a.y * b.y;
+// P is a rounding policy, see policy.hpp. Precise only changes float vectors: integer products are exact and
+// doubles keep the plain sum
+template<typename P = DefaultRounding, typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+JTX_HOSTDEV JTX_INLINE constexpr T Dot(const Vec2<T> &a, const Vec2<T> &b) {
+    if constexpr (IsPrecise<P> && std::is_same_v<T, float>) {
+        return jtx::sumOfProducts<P>(a.x, b.x, a.y, b.y);
+    } else {
+        return a.x * b.x + a.y * b.y;
+    }
 }
 
-JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE T Dot(const Vec3<T> &a, const Vec3<T> &b) {
-    return a.x * b.x + a.y * b.y + a.z * b.z;
+template<typename P = DefaultRounding, typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+JTX_HOSTDEV JTX_INLINE constexpr T Dot(const Vec3<T> &a, const Vec3<T> &b) {
+    return a.template Dot<P>(b);
 }
 
-JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE T Dot(const Vec4<T> &a, const Vec4<T> &b) {
-    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+template<typename P = DefaultRounding, typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+JTX_HOSTDEV JTX_INLINE constexpr T Dot(const Vec4<T> &a, const Vec4<T> &b) {
+    if constexpr (IsPrecise<P> && std::is_same_v<T, float>) {
+        return jtx::sumOfProducts<P>(a.x, b.x, a.y, b.y, a.z, b.z, a.w, b.w);
+    } else {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
 }
 #pragma endregion
 
@@ -60,34 +70,23 @@ JTX_HOSTDEV JTX_INLINE T AbsDot(const Vec4<T> &a, const Vec4<T> &b) {
 #pragma endregion
 
 #pragma region Normalize
-JTX_NUM_ONLY_T
+// P is a precision policy (see policy.hpp), e.g. Normalize<Approx>(v). Zero vectors stay zero
+template<typename P = Exact, typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
 JTX_HOSTDEV JTX_INLINE Vec2<T> Normalize(const Vec2<T> &v) {
-    float l = v.Length();
-    if (l != 0) {
-        return v / l;
-    } else {
-        return Vec2<T>{};
-    }
+    Vec2<T> res = v;
+    return res.template normalize<P>();
 }
 
-JTX_NUM_ONLY_T
+template<typename P = Exact, typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
 JTX_HOSTDEV JTX_INLINE Vec3<T> Normalize(const Vec3<T> &v) {
-    float l = v.Length();
-    if (l != 0) {
-        return v / l;
-    } else {
-        return Vec3<T>{};
-    }
+    Vec3<T> res = v;
+    return res.template Normalize<P>();
 }
 
-JTX_NUM_ONLY_T
+template<typename P = Exact, typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
 JTX_HOSTDEV JTX_INLINE Vec4<T> Normalize(const Vec4<T> &v) {
-    float l = v.Length();
-    if (l != 0) {
-        return v / l;
-    } else {
-        return Vec4<T>{};
-    }
+    Vec4<T> res = v;
+    return res.template normalize<P>();
 }
 #pragma endregion
 
@@ -125,87 +124,54 @@ JTX_HOSTDEV JTX_INLINE Vec4<T> floor(const Vec4<T> &v) {
 
 #pragma region Min & Max
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE Vec2<T> min(const Vec2<T> &a, const Vec2<T> &b) {
+JTX_HOSTDEV JTX_INLINE constexpr Vec2<T> min(const Vec2<T> &a, const Vec2<T> &b) {
     return {std::min(a.x, b.x), std::min(a.y, b.y)};
 }
 
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE Vec3<T> min(const Vec3<T> &a, const Vec3<T> &b) {
+JTX_HOSTDEV JTX_INLINE constexpr Vec3<T> min(const Vec3<T> &a, const Vec3<T> &b) {
     return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)};
 }
 
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE Vec4<T> min(const Vec4<T> &a, const Vec4<T> &b) {
+JTX_HOSTDEV JTX_INLINE constexpr Vec4<T> min(const Vec4<T> &a, const Vec4<T> &b) {
     return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z), std::min(a.w, b.w)};
 }
 
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE Vec2<T> Max(const Vec2<T> &a, const Vec2<T> &b) {
+JTX_HOSTDEV JTX_INLINE constexpr Vec2<T> Max(const Vec2<T> &a, const Vec2<T> &b) {
     return {std::max(a.x, b.x), std::max(a.y, b.y)};
 }
 
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE Vec3<T> Max(const Vec3<T> &a, const Vec3<T> &b) {
+JTX_HOSTDEV JTX_INLINE constexpr Vec3<T> Max(const Vec3<T> &a, const Vec3<T> &b) {
     return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
 }
 
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE Vec4<T> Max(const Vec4<T> &a, const Vec4<T> &b) {
+JTX_HOSTDEV JTX_INLINE constexpr Vec4<T> Max(const Vec4<T> &a, const Vec4<T> &b) {
     return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z), std::max(a.w, b.w)};
 }
 #pragma endregion
 
 #pragma region Horizontal Product
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE T hprod(const Vec2<T> &v) {
+JTX_HOSTDEV JTX_INLINE constexpr T hprod(const Vec2<T> &v) {
     return v.x * v.y;
 }
 
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE T hprod(const Vec3<T> &v) {
+JTX_HOSTDEV JTX_INLINE constexpr T hprod(const Vec3<T> &v) {
     return v.x * v.y * v.z;
 }
 
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE T hprod(const Vec4<T> &v) {
+JTX_HOSTDEV JTX_INLINE constexpr T hprod(const Vec4<T> &v) {
     return v.x * v.y * v.z * v.w;
 }
 #pragma endregion
 
-#pragma region LERP
-JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE auto Lerp(const Vec2<T> &a, const Vec2<T> &b, T t) {
-    return (1 - t) * a + b * t;
-}
-
-JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE auto
-Lerp(const Vec3<T> &a, const Vec3<T> &b, T t) {
-    return (1 - t) * a + b * t;
-}
-
-JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE auto Lerp(const Vec4<T> &a, const Vec4<T> &b, T t) {
-    return (1 - t) * a + b * t;
-}
-#pragma endregion
-
-#pragma region FMA
-JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE Vec2<T> fma(const Vec2<T> &a, const Vec2<T> &b, const Vec2<T> &c) {
-    return a * b + c;
-}
-
-JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE Vec3<T> fma(const Vec3<T> &a, const Vec3<T> &b, const Vec3<T> &c) {
-    return a * b + c;
-}
-
-JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE Vec4<T> fma(const Vec4<T> &a, const Vec4<T> &b, const Vec4<T> &c) {
-    return a * b + c;
-}
-#pragma endregion
+// Lerp() and fma() for vectors are in veccore.hpp
 
 #pragma region Angle between
 JTX_NUM_ONLY_T
@@ -239,17 +205,17 @@ JTX_HOSTDEV JTX_INLINE Vec3<T> gramSchmidt(const Vec3<T> &a, const Vec3<T> &b) {
 
 #pragma region Distance
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE float distanceSqr(const Vec2<T> &a, const Vec2<T> &b) {
+JTX_HOSTDEV JTX_INLINE constexpr float distanceSqr(const Vec2<T> &a, const Vec2<T> &b) {
     return (a - b).LengthSquared();
 }
 
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE float distanceSqr(const Vec3<T> &a, const Vec3<T> &b) {
+JTX_HOSTDEV JTX_INLINE constexpr float distanceSqr(const Vec3<T> &a, const Vec3<T> &b) {
     return (a - b).LengthSquared();
 }
 
 JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE float distanceSqr(const Vec4<T> &a, const Vec4<T> &b) {
+JTX_HOSTDEV JTX_INLINE constexpr float distanceSqr(const Vec4<T> &a, const Vec4<T> &b) {
     return (a - b).LengthSquared();
 }
 
@@ -270,17 +236,9 @@ JTX_HOSTDEV JTX_INLINE float distance(const Vec4<T> &a, const Vec4<T> &b) {
 #pragma endregion
 
 #pragma region Vec3 Specific
-JTX_NUM_ONLY_T
-JTX_HOSTDEV JTX_INLINE Vec3<T> Cross(const Vec3<T> &a, const Vec3<T> &b) {
-#ifdef JTXLIB_MINIMIZE_FP_ERROR
-    return {jtx::dop(a.y, b.z, a.z, b.y),
-            jtx::dop(a.z, b.x, a.x, b.z),
-            jtx::dop(a.x, b.y, a.y, b.x)};
-#else
-    return {a.y * b.z - a.z * b.y,
-            a.z * b.x - a.x * b.z,
-            a.x * b.y - a.y * b.x};
-#endif
+template<typename P = DefaultRounding, typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+JTX_HOSTDEV JTX_INLINE constexpr Vec3<T> Cross(const Vec3<T> &a, const Vec3<T> &b) {
+    return a.template cross<P>(b);
 }
 
 JTX_NUM_ONLY_T
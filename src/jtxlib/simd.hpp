@@ -1,3 +1,7 @@
 #pragma once
 
-#include "simd/avxfloat.hpp"
\ No newline at end of file
+#include "simd/avxfloat.hpp"
+#include "simd/simdhalf.hpp"
+#include "simd/simdmath.hpp"
+#include "simd/simdspherical.hpp"
+#include "simd/vec3fa.hpp"
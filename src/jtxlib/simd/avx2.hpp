@@ -0,0 +1,279 @@
+/**
+ * AVX2 backend for the 8-wide SIMD types, included by simdfloat.hpp
+ * This is based off: https://github.com/dubiousconst282/GLimpSW/blob/main/src/SwRast/SIMD.h
+ */
+#pragma once
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "portability-simd-intrinsics"
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "google-explicit-constructor"
+
+#include <immintrin.h>
+
+namespace jtx::inline JTX_SIMD_ABI {
+    template<>
+    struct SimdMask<8> {
+        static constexpr size_t size = 8;
+
+        __m256 data;
+
+        // Sets all lanes to false
+        SimdMask() : data(_mm256_setzero_ps()) {}
+        SimdMask(__m256 data) : data(data) {}
+        SimdMask(__m256i data) : data(_mm256_castsi256_ps(data)) {}
+        SimdMask(bool val) : data(val ? _mm256_castsi256_ps(_mm256_set1_epi32(-1)) : _mm256_setzero_ps()) {}
+
+        // One bit per lane, lane 0 is the least significant bit
+        [[nodiscard]] inline int movemask() const { return _mm256_movemask_ps(data); }
+
+        [[nodiscard]] inline bool any() const { return movemask() != 0; }
+        [[nodiscard]] inline bool all() const { return movemask() == 0xFF; }
+        [[nodiscard]] inline bool none() const { return movemask() == 0; }
+
+        inline bool operator[](size_t i) const { return (movemask() >> i) & 1; }
+
+        inline operator __m256() const { return data; }
+
+        friend inline SimdMask operator&(SimdMask a, SimdMask b) { return _mm256_and_ps(a, b); }
+        friend inline SimdMask operator|(SimdMask a, SimdMask b) { return _mm256_or_ps(a, b); }
+        friend inline SimdMask operator^(SimdMask a, SimdMask b) { return _mm256_xor_ps(a, b); }
+        friend inline SimdMask operator~(SimdMask a) { return _mm256_xor_ps(a, SimdMask(true)); }
+    };
+
+    template<>
+    struct SimdInt<8> {
+        static constexpr size_t size = 8;
+
+        __m256i data;
+
+        // Sets all lanes to 0
+        SimdInt() : data(_mm256_setzero_si256()) {}
+        SimdInt(__m256i data) : data(data) {}
+        SimdInt(int32_t val) : data(_mm256_set1_epi32(val)) {}
+
+        inline int32_t &operator[](size_t i) { return reinterpret_cast<int32_t *>(&data)[i]; }
+        inline const int32_t &operator[](size_t i) const { return reinterpret_cast<const int32_t *>(&data)[i]; }
+
+        static inline SimdInt load(const int32_t *ptr) { return _mm256_load_si256(reinterpret_cast<const __m256i *>(ptr)); }
+        static inline SimdInt loadu(const int32_t *ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)); }
+        inline void store(int32_t *ptr) const { _mm256_store_si256(reinterpret_cast<__m256i *>(ptr), data); }
+        inline void storeu(int32_t *ptr) const { _mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr), data); }
+
+        inline operator __m256i() const { return data; }
+
+        inline SimdInt &operator+=(SimdInt other) { return *this = *this + other; }
+        inline SimdInt &operator-=(SimdInt other) { return *this = *this - other; }
+        inline SimdInt &operator*=(SimdInt other) { return *this = *this * other; }
+        inline SimdInt &operator&=(SimdInt other) { return *this = *this & other; }
+        inline SimdInt &operator|=(SimdInt other) { return *this = *this | other; }
+        inline SimdInt &operator^=(SimdInt other) { return *this = *this ^ other; }
+        inline SimdInt &operator<<=(int n) { return *this = *this << n; }
+        inline SimdInt &operator>>=(int n) { return *this = *this >> n; }
+
+        friend inline SimdInt operator+(SimdInt a, SimdInt b) { return _mm256_add_epi32(a, b); }
+        friend inline SimdInt operator-(SimdInt a, SimdInt b) { return _mm256_sub_epi32(a, b); }
+        friend inline SimdInt operator*(SimdInt a, SimdInt b) { return _mm256_mullo_epi32(a, b); }
+        friend inline SimdInt operator-(SimdInt a) { return _mm256_sub_epi32(_mm256_setzero_si256(), a); }
+
+        friend inline SimdInt operator&(SimdInt a, SimdInt b) { return _mm256_and_si256(a, b); }
+        friend inline SimdInt operator|(SimdInt a, SimdInt b) { return _mm256_or_si256(a, b); }
+        friend inline SimdInt operator^(SimdInt a, SimdInt b) { return _mm256_xor_si256(a, b); }
+        friend inline SimdInt operator~(SimdInt a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+
+        friend inline SimdInt operator<<(SimdInt a, int n) { return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+        // Arithmetic (sign-extending) shift
+        friend inline SimdInt operator>>(SimdInt a, int n) { return _mm256_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+        // Logical (zero-filling) shift
+        friend inline SimdInt shiftRightLogical(SimdInt a, int n) { return _mm256_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+
+        // Per-lane shift amounts, amounts >= 32 give 0 (or the sign for arithmetic shifts)
+        friend inline SimdInt operator<<(SimdInt a, SimdInt n) { return _mm256_sllv_epi32(a, n); }
+        friend inline SimdInt operator>>(SimdInt a, SimdInt n) { return _mm256_srav_epi32(a, n); }
+        friend inline SimdInt shiftRightLogical(SimdInt a, SimdInt n) { return _mm256_srlv_epi32(a, n); }
+
+        // ~a & b
+        friend inline SimdInt andnot(SimdInt a, SimdInt b) { return _mm256_andnot_si256(a, b); }
+
+        friend inline SimdMask<8> operator==(SimdInt a, SimdInt b) { return _mm256_cmpeq_epi32(a, b); }
+        friend inline SimdMask<8> operator!=(SimdInt a, SimdInt b) { return ~(a == b); }
+        friend inline SimdMask<8> operator<(SimdInt a, SimdInt b) { return _mm256_cmpgt_epi32(b, a); }
+        friend inline SimdMask<8> operator>(SimdInt a, SimdInt b) { return _mm256_cmpgt_epi32(a, b); }
+        friend inline SimdMask<8> operator<=(SimdInt a, SimdInt b) { return ~(a > b); }
+        friend inline SimdMask<8> operator>=(SimdInt a, SimdInt b) { return ~(a < b); }
+
+        friend inline SimdInt min(SimdInt a, SimdInt b) { return _mm256_min_epi32(a, b); }
+        friend inline SimdInt max(SimdInt a, SimdInt b) { return _mm256_max_epi32(a, b); }
+
+        // Picks a where mask is set, b otherwise
+        friend inline SimdInt select(SimdMask<8> mask, SimdInt a, SimdInt b) {
+            return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b), _mm256_castsi256_ps(a), mask));
+        }
+    };
+
+    template<>
+    struct SimdFloat<8> {
+        static constexpr size_t size = 8;
+#ifdef __FMA__
+        static constexpr bool fusedFma = true;
+#else
+        static constexpr bool fusedFma = false;
+#endif
+
+        __m256 data;
+
+        // Sets all lanes to 0
+        SimdFloat() : data(_mm256_setzero_ps()) {}
+        SimdFloat(__m256 data) : data(data) {}
+        SimdFloat(float val) : data(_mm256_set1_ps(val)) {}
+
+        inline float &operator[](size_t i) { return reinterpret_cast<float *>(&data)[i]; }
+        inline const float &operator[](size_t i) const { return reinterpret_cast<const float *>(&data)[i]; }
+
+        static inline SimdFloat load(const float *ptr) { return _mm256_load_ps(ptr); }
+        static inline SimdFloat loadu(const float *ptr) { return _mm256_loadu_ps(ptr); }
+        inline void store(float *ptr) const { _mm256_store_ps(ptr, data); }
+        inline void storeu(float *ptr) const { _mm256_storeu_ps(ptr, data); }
+
+        inline operator __m256() const { return data; }
+
+        inline SimdFloat &operator+=(SimdFloat other) { return *this = *this + other; }
+        inline SimdFloat &operator-=(SimdFloat other) { return *this = *this - other; }
+        inline SimdFloat &operator*=(SimdFloat other) { return *this = *this * other; }
+        inline SimdFloat &operator/=(SimdFloat other) { return *this = *this / other; }
+
+        //region Operators
+        friend inline SimdFloat operator+(SimdFloat a, SimdFloat b) { return _mm256_add_ps(a, b); }
+        friend inline SimdFloat operator-(SimdFloat a, SimdFloat b) { return _mm256_sub_ps(a, b); }
+        friend inline SimdFloat operator*(SimdFloat a, SimdFloat b) { return _mm256_mul_ps(a, b); }
+        friend inline SimdFloat operator/(SimdFloat a, SimdFloat b) { return _mm256_div_ps(a, b); }
+        friend inline SimdFloat operator-(SimdFloat a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+
+        friend inline SimdMask<8> operator==(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+        friend inline SimdMask<8> operator!=(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+        friend inline SimdMask<8> operator<(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        friend inline SimdMask<8> operator<=(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        friend inline SimdMask<8> operator>(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        friend inline SimdMask<8> operator>=(SimdFloat a, SimdFloat b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        //endregion
+
+        //region Functions
+        // Picks a where mask is set, b otherwise
+        friend inline SimdFloat select(SimdMask<8> mask, SimdFloat a, SimdFloat b) { return _mm256_blendv_ps(b, a, mask); }
+
+        // a * b + c, fused when compiled with FMA support
+        friend inline SimdFloat fma(SimdFloat a, SimdFloat b, SimdFloat c) {
+#ifdef __FMA__
+            return _mm256_fmadd_ps(a, b, c);
+#else
+            return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+        }
+
+        // a * b - c, fused when compiled with FMA support
+        friend inline SimdFloat fms(SimdFloat a, SimdFloat b, SimdFloat c) {
+#ifdef __FMA__
+            return _mm256_fmsub_ps(a, b, c);
+#else
+            return _mm256_sub_ps(_mm256_mul_ps(a, b), c);
+#endif
+        }
+
+        friend inline SimdFloat min(SimdFloat a, SimdFloat b) { return _mm256_min_ps(a, b); }
+        friend inline SimdFloat max(SimdFloat a, SimdFloat b) { return _mm256_max_ps(a, b); }
+        friend inline SimdFloat abs(SimdFloat a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+
+        friend inline SimdFloat floor(SimdFloat a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+        friend inline SimdFloat ceil(SimdFloat a) { return _mm256_round_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+        // Rounds to the nearest integer, ties to even
+        friend inline SimdFloat round(SimdFloat a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        friend inline SimdFloat sqrt(SimdFloat a) { return _mm256_sqrt_ps(a); }
+        friend inline SimdFloat rcpEstimate(SimdFloat a) { return _mm256_rcp_ps(a); }
+        friend inline SimdFloat rsqrtEstimate(SimdFloat a) { return _mm256_rsqrt_ps(a); }
+        //endregion
+    };
+
+    inline SimdFloat<8> toFloat(SimdInt<8> a) { return _mm256_cvtepi32_ps(a); }
+    inline SimdInt<8> toInt(SimdFloat<8> a) { return _mm256_cvttps_epi32(a); }
+    inline SimdFloat<8> asFloat(SimdInt<8> a) { return _mm256_castsi256_ps(a); }
+    inline SimdInt<8> asInt(SimdFloat<8> a) { return _mm256_castps_si256(a); }
+    inline SimdInt<8> roundToInt(SimdFloat<8> a) { return _mm256_cvtps_epi32(a); }
+
+    inline SimdFloat<8> gather(const float *base, SimdInt<8> idx) { return _mm256_i32gather_ps(base, idx, 4); }
+
+    inline SimdFloat<8> gather(const float *base, SimdInt<8> idx, SimdMask<8> mask, SimdFloat<8> src = SimdFloat<8>()) {
+        return _mm256_mask_i32gather_ps(src, base, idx, mask, 4);
+    }
+
+    inline SimdInt<8> gather(const int32_t *base, SimdInt<8> idx) {
+        return _mm256_i32gather_epi32(reinterpret_cast<const int *>(base), idx, 4);
+    }
+
+    inline SimdInt<8> gather(const int32_t *base, SimdInt<8> idx, SimdMask<8> mask, SimdInt<8> src = SimdInt<8>()) {
+        return _mm256_mask_i32gather_epi32(src, reinterpret_cast<const int *>(base), idx, _mm256_castps_si256(mask), 4);
+    }
+
+    // Shuffle sequences from Intel's "3D Vector Normalization Using 256-Bit Intel AVX", each 128-bit half
+    // transposes four vectors
+    inline void loadInterleaved3(const float *src, SimdFloat<8> *x, SimdFloat<8> *y, SimdFloat<8> *z) {
+        __m256 m03 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src)), _mm_loadu_ps(src + 12), 1);
+        __m256 m14 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 4)), _mm_loadu_ps(src + 16), 1);
+        __m256 m25 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 8)), _mm_loadu_ps(src + 20), 1);
+
+        __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));// x2 y2 x3 y3
+        __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));// y0 z0 y1 z1
+        *x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        *y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        *z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+    }
+
+    inline void storeInterleaved3(float *dst, SimdFloat<8> x, SimdFloat<8> y, SimdFloat<8> z) {
+        __m256 rxy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));// x0 x2 y0 y2
+        __m256 ryz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));// y1 y3 z1 z3
+        __m256 rzx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));// z0 z2 x1 x3
+
+        __m256 r03 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 r14 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+        __m256 r25 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+
+        _mm256_storeu_ps(dst, _mm256_permute2f128_ps(r03, r14, 0x20));
+        _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(r25, r03, 0x30));
+        _mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(r14, r25, 0x31));
+    }
+
+    inline void loadInterleaved4(const float *src, SimdFloat<8> *x, SimdFloat<8> *y, SimdFloat<8> *z, SimdFloat<8> *w) {
+        // Vectors i and i + 4 share a register, then a 4x4 transpose per 128-bit half
+        __m256 m0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src)), _mm_loadu_ps(src + 16), 1);
+        __m256 m1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 4)), _mm_loadu_ps(src + 20), 1);
+        __m256 m2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 8)), _mm_loadu_ps(src + 24), 1);
+        __m256 m3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 12)), _mm_loadu_ps(src + 28), 1);
+
+        __m256 t0 = _mm256_unpacklo_ps(m0, m1);// x0 x1 y0 y1
+        __m256 t1 = _mm256_unpackhi_ps(m0, m1);// z0 z1 w0 w1
+        __m256 t2 = _mm256_unpacklo_ps(m2, m3);// x2 x3 y2 y3
+        __m256 t3 = _mm256_unpackhi_ps(m2, m3);// z2 z3 w2 w3
+        *x = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        *y = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        *z = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        *w = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    inline void storeInterleaved4(float *dst, SimdFloat<8> x, SimdFloat<8> y, SimdFloat<8> z, SimdFloat<8> w) {
+        __m256 t0 = _mm256_unpacklo_ps(x, y);// x0 y0 x1 y1
+        __m256 t1 = _mm256_unpackhi_ps(x, y);// x2 y2 x3 y3
+        __m256 t2 = _mm256_unpacklo_ps(z, w);// z0 w0 z1 w1
+        __m256 t3 = _mm256_unpackhi_ps(z, w);// z2 w2 z3 w3
+        __m256 r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+        _mm256_storeu_ps(dst, _mm256_permute2f128_ps(r0, r1, 0x20));
+        _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(r2, r3, 0x20));
+        _mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(r0, r1, 0x31));
+        _mm256_storeu_ps(dst + 24, _mm256_permute2f128_ps(r2, r3, 0x31));
+    }
+}// namespace jtx
+
+#pragma clang diagnostic pop
+#pragma clang diagnostic pop
@@ -0,0 +1,264 @@
+/**
+ * AVX-512 (F) backend for the 16-wide SIMD types, included by simdfloat.hpp
+ * Masks are kept in mask registers (__mmask16) instead of vectors
+ */
+#pragma once
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "portability-simd-intrinsics"
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "google-explicit-constructor"
+
+#include <immintrin.h>
+
+namespace jtx::inline JTX_SIMD_ABI {
+    template<>
+    struct SimdMask<16> {
+        static constexpr size_t size = 16;
+
+        __mmask16 data;
+
+        // Sets all lanes to false
+        SimdMask() : data(0) {}
+        SimdMask(__mmask16 data) : data(data) {}
+        SimdMask(bool val) : data(val ? 0xFFFF : 0) {}
+
+        // One bit per lane, lane 0 is the least significant bit
+        [[nodiscard]] inline int movemask() const { return data; }
+
+        [[nodiscard]] inline bool any() const { return data != 0; }
+        [[nodiscard]] inline bool all() const { return data == 0xFFFF; }
+        [[nodiscard]] inline bool none() const { return data == 0; }
+
+        inline bool operator[](size_t i) const { return (data >> i) & 1; }
+
+        inline operator __mmask16() const { return data; }
+
+        friend inline SimdMask operator&(SimdMask a, SimdMask b) { return static_cast<__mmask16>(a.data & b.data); }
+        friend inline SimdMask operator|(SimdMask a, SimdMask b) { return static_cast<__mmask16>(a.data | b.data); }
+        friend inline SimdMask operator^(SimdMask a, SimdMask b) { return static_cast<__mmask16>(a.data ^ b.data); }
+        friend inline SimdMask operator~(SimdMask a) { return static_cast<__mmask16>(~a.data); }
+    };
+
+    template<>
+    struct SimdInt<16> {
+        static constexpr size_t size = 16;
+
+        __m512i data;
+
+        // Sets all lanes to 0
+        SimdInt() : data(_mm512_setzero_si512()) {}
+        SimdInt(__m512i data) : data(data) {}
+        SimdInt(int32_t val) : data(_mm512_set1_epi32(val)) {}
+
+        inline int32_t &operator[](size_t i) { return reinterpret_cast<int32_t *>(&data)[i]; }
+        inline const int32_t &operator[](size_t i) const { return reinterpret_cast<const int32_t *>(&data)[i]; }
+
+        static inline SimdInt load(const int32_t *ptr) { return _mm512_load_si512(ptr); }
+        static inline SimdInt loadu(const int32_t *ptr) { return _mm512_loadu_si512(ptr); }
+        inline void store(int32_t *ptr) const { _mm512_store_si512(ptr, data); }
+        inline void storeu(int32_t *ptr) const { _mm512_storeu_si512(ptr, data); }
+
+        inline operator __m512i() const { return data; }
+
+        inline SimdInt &operator+=(SimdInt other) { return *this = *this + other; }
+        inline SimdInt &operator-=(SimdInt other) { return *this = *this - other; }
+        inline SimdInt &operator*=(SimdInt other) { return *this = *this * other; }
+        inline SimdInt &operator&=(SimdInt other) { return *this = *this & other; }
+        inline SimdInt &operator|=(SimdInt other) { return *this = *this | other; }
+        inline SimdInt &operator^=(SimdInt other) { return *this = *this ^ other; }
+        inline SimdInt &operator<<=(int n) { return *this = *this << n; }
+        inline SimdInt &operator>>=(int n) { return *this = *this >> n; }
+
+        friend inline SimdInt operator+(SimdInt a, SimdInt b) { return _mm512_add_epi32(a, b); }
+        friend inline SimdInt operator-(SimdInt a, SimdInt b) { return _mm512_sub_epi32(a, b); }
+        friend inline SimdInt operator*(SimdInt a, SimdInt b) { return _mm512_mullo_epi32(a, b); }
+        friend inline SimdInt operator-(SimdInt a) { return _mm512_sub_epi32(_mm512_setzero_si512(), a); }
+
+        friend inline SimdInt operator&(SimdInt a, SimdInt b) { return _mm512_and_si512(a, b); }
+        friend inline SimdInt operator|(SimdInt a, SimdInt b) { return _mm512_or_si512(a, b); }
+        friend inline SimdInt operator^(SimdInt a, SimdInt b) { return _mm512_xor_si512(a, b); }
+        friend inline SimdInt operator~(SimdInt a) { return _mm512_xor_si512(a, _mm512_set1_epi32(-1)); }
+
+        friend inline SimdInt operator<<(SimdInt a, int n) { return _mm512_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+        // Arithmetic (sign-extending) shift
+        friend inline SimdInt operator>>(SimdInt a, int n) { return _mm512_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+        // Logical (zero-filling) shift
+        friend inline SimdInt shiftRightLogical(SimdInt a, int n) { return _mm512_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+
+        // Per-lane shift amounts, amounts >= 32 give 0 (or the sign for arithmetic shifts)
+        friend inline SimdInt operator<<(SimdInt a, SimdInt n) { return _mm512_sllv_epi32(a, n); }
+        friend inline SimdInt operator>>(SimdInt a, SimdInt n) { return _mm512_srav_epi32(a, n); }
+        friend inline SimdInt shiftRightLogical(SimdInt a, SimdInt n) { return _mm512_srlv_epi32(a, n); }
+
+        // ~a & b
+        friend inline SimdInt andnot(SimdInt a, SimdInt b) { return _mm512_andnot_si512(a, b); }
+
+        friend inline SimdMask<16> operator==(SimdInt a, SimdInt b) { return _mm512_cmpeq_epi32_mask(a, b); }
+        friend inline SimdMask<16> operator!=(SimdInt a, SimdInt b) { return _mm512_cmpneq_epi32_mask(a, b); }
+        friend inline SimdMask<16> operator<(SimdInt a, SimdInt b) { return _mm512_cmplt_epi32_mask(a, b); }
+        friend inline SimdMask<16> operator>(SimdInt a, SimdInt b) { return _mm512_cmpgt_epi32_mask(a, b); }
+        friend inline SimdMask<16> operator<=(SimdInt a, SimdInt b) { return _mm512_cmple_epi32_mask(a, b); }
+        friend inline SimdMask<16> operator>=(SimdInt a, SimdInt b) { return _mm512_cmpge_epi32_mask(a, b); }
+
+        friend inline SimdInt min(SimdInt a, SimdInt b) { return _mm512_min_epi32(a, b); }
+        friend inline SimdInt max(SimdInt a, SimdInt b) { return _mm512_max_epi32(a, b); }
+
+        // Picks a where mask is set, b otherwise
+        friend inline SimdInt select(SimdMask<16> mask, SimdInt a, SimdInt b) { return _mm512_mask_blend_epi32(mask, b, a); }
+    };
+
+    template<>
+    struct SimdFloat<16> {
+        static constexpr size_t size = 16;
+        static constexpr bool fusedFma = true;
+
+        __m512 data;
+
+        // Sets all lanes to 0
+        SimdFloat() : data(_mm512_setzero_ps()) {}
+        SimdFloat(__m512 data) : data(data) {}
+        SimdFloat(float val) : data(_mm512_set1_ps(val)) {}
+
+        inline float &operator[](size_t i) { return reinterpret_cast<float *>(&data)[i]; }
+        inline const float &operator[](size_t i) const { return reinterpret_cast<const float *>(&data)[i]; }
+
+        static inline SimdFloat load(const float *ptr) { return _mm512_load_ps(ptr); }
+        static inline SimdFloat loadu(const float *ptr) { return _mm512_loadu_ps(ptr); }
+        inline void store(float *ptr) const { _mm512_store_ps(ptr, data); }
+        inline void storeu(float *ptr) const { _mm512_storeu_ps(ptr, data); }
+
+        inline operator __m512() const { return data; }
+
+        inline SimdFloat &operator+=(SimdFloat other) { return *this = *this + other; }
+        inline SimdFloat &operator-=(SimdFloat other) { return *this = *this - other; }
+        inline SimdFloat &operator*=(SimdFloat other) { return *this = *this * other; }
+        inline SimdFloat &operator/=(SimdFloat other) { return *this = *this / other; }
+
+        //region Operators
+        friend inline SimdFloat operator+(SimdFloat a, SimdFloat b) { return _mm512_add_ps(a, b); }
+        friend inline SimdFloat operator-(SimdFloat a, SimdFloat b) { return _mm512_sub_ps(a, b); }
+        friend inline SimdFloat operator*(SimdFloat a, SimdFloat b) { return _mm512_mul_ps(a, b); }
+        friend inline SimdFloat operator/(SimdFloat a, SimdFloat b) { return _mm512_div_ps(a, b); }
+        // AVX-512F has no float xor, flip the sign bit through the integer domain
+        friend inline SimdFloat operator-(SimdFloat a) {
+            return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(INT32_MIN)));
+        }
+
+        friend inline SimdMask<16> operator==(SimdFloat a, SimdFloat b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+        friend inline SimdMask<16> operator!=(SimdFloat a, SimdFloat b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ); }
+        friend inline SimdMask<16> operator<(SimdFloat a, SimdFloat b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+        friend inline SimdMask<16> operator<=(SimdFloat a, SimdFloat b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+        friend inline SimdMask<16> operator>(SimdFloat a, SimdFloat b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+        friend inline SimdMask<16> operator>=(SimdFloat a, SimdFloat b) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+        //endregion
+
+        //region Functions
+        // Picks a where mask is set, b otherwise
+        friend inline SimdFloat select(SimdMask<16> mask, SimdFloat a, SimdFloat b) { return _mm512_mask_blend_ps(mask, b, a); }
+
+        // a * b + c, always fused
+        friend inline SimdFloat fma(SimdFloat a, SimdFloat b, SimdFloat c) { return _mm512_fmadd_ps(a, b, c); }
+        // a * b - c, always fused
+        friend inline SimdFloat fms(SimdFloat a, SimdFloat b, SimdFloat c) { return _mm512_fmsub_ps(a, b, c); }
+
+        friend inline SimdFloat min(SimdFloat a, SimdFloat b) { return _mm512_min_ps(a, b); }
+        friend inline SimdFloat max(SimdFloat a, SimdFloat b) { return _mm512_max_ps(a, b); }
+        friend inline SimdFloat abs(SimdFloat a) { return _mm512_abs_ps(a); }
+
+        friend inline SimdFloat floor(SimdFloat a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+        friend inline SimdFloat ceil(SimdFloat a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+        // Rounds to the nearest integer, ties to even
+        friend inline SimdFloat round(SimdFloat a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        friend inline SimdFloat sqrt(SimdFloat a) { return _mm512_sqrt_ps(a); }
+        friend inline SimdFloat rcpEstimate(SimdFloat a) { return _mm512_rcp14_ps(a); }
+        friend inline SimdFloat rsqrtEstimate(SimdFloat a) { return _mm512_rsqrt14_ps(a); }
+        //endregion
+    };
+
+    inline SimdFloat<16> toFloat(SimdInt<16> a) { return _mm512_cvtepi32_ps(a); }
+    inline SimdInt<16> toInt(SimdFloat<16> a) { return _mm512_cvttps_epi32(a); }
+    inline SimdFloat<16> asFloat(SimdInt<16> a) { return _mm512_castsi512_ps(a); }
+    inline SimdInt<16> asInt(SimdFloat<16> a) { return _mm512_castps_si512(a); }
+    inline SimdInt<16> roundToInt(SimdFloat<16> a) { return _mm512_cvtps_epi32(a); }
+
+    inline SimdFloat<16> gather(const float *base, SimdInt<16> idx) { return _mm512_i32gather_ps(idx, base, 4); }
+
+    inline SimdFloat<16> gather(const float *base, SimdInt<16> idx, SimdMask<16> mask, SimdFloat<16> src = SimdFloat<16>()) {
+        return _mm512_mask_i32gather_ps(src, mask, idx, base, 4);
+    }
+
+    inline SimdInt<16> gather(const int32_t *base, SimdInt<16> idx) { return _mm512_i32gather_epi32(idx, base, 4); }
+
+    inline SimdInt<16> gather(const int32_t *base, SimdInt<16> idx, SimdMask<16> mask, SimdInt<16> src = SimdInt<16>()) {
+        return _mm512_mask_i32gather_epi32(src, mask, idx, base, 4);
+    }
+
+    /**
+     * The transposes use two-source permutes, which only look at the low 5 bits of each index: lanes whose
+     * float comes from the third (or fourth) register get junk from the first permute and are replaced by
+     * the second one. The index vectors are constants after folding
+     */
+    inline void loadInterleaved3(const float *src, SimdFloat<16> *x, SimdFloat<16> *y, SimdFloat<16> *z) {
+        __m512 m0 = _mm512_loadu_ps(src), m1 = _mm512_loadu_ps(src + 16), m2 = _mm512_loadu_ps(src + 32);
+        const __m512i i3 = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                                              _mm512_set1_epi32(3));
+
+        auto component = [&](int k) -> SimdFloat<16> {
+            __m512i idx = _mm512_add_epi32(i3, _mm512_set1_epi32(k));
+            __mmask16 fromM2 = _mm512_cmpge_epi32_mask(idx, _mm512_set1_epi32(32));
+            __m512 t = _mm512_permutex2var_ps(m0, idx, m1);
+            return _mm512_mask_permutexvar_ps(t, fromM2, idx, m2);
+        };
+        *x = component(0);
+        *y = component(1);
+        *z = component(2);
+    }
+
+    inline void storeInterleaved3(float *dst, SimdFloat<16> x, SimdFloat<16> y, SimdFloat<16> z) {
+        const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        for (int j = 0; j < 3; ++j) {
+            // Output float f = 16 * j + lane is component f % 3 of vector f / 3
+            __m512i f = _mm512_add_epi32(lane, _mm512_set1_epi32(16 * j));
+            __m512i e = _mm512_srli_epi32(_mm512_mullo_epi32(f, _mm512_set1_epi32(0xAAAB)), 17);
+            __m512i c = _mm512_sub_epi32(f, _mm512_mullo_epi32(e, _mm512_set1_epi32(3)));
+
+            __mmask16 fromY = _mm512_cmpeq_epi32_mask(c, _mm512_set1_epi32(1));
+            __mmask16 fromZ = _mm512_cmpeq_epi32_mask(c, _mm512_set1_epi32(2));
+            __m512i idx = _mm512_mask_add_epi32(e, fromY, e, _mm512_set1_epi32(16));
+            __m512 t = _mm512_permutex2var_ps(x, idx, y);
+            _mm512_storeu_ps(dst + 16 * j, _mm512_mask_permutexvar_ps(t, fromZ, e, z));
+        }
+    }
+
+    inline void loadInterleaved4(const float *src, SimdFloat<16> *x, SimdFloat<16> *y, SimdFloat<16> *z,
+                                 SimdFloat<16> *w) {
+        __m512 m0 = _mm512_loadu_ps(src), m1 = _mm512_loadu_ps(src + 16);
+        __m512 m2 = _mm512_loadu_ps(src + 32), m3 = _mm512_loadu_ps(src + 48);
+        const __m512i i4 = _mm512_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60);
+
+        // Vectors 0-7 come from m0:m1, vectors 8-15 from m2:m3
+        auto component = [&](int k) -> SimdFloat<16> {
+            __m512i idx = _mm512_add_epi32(i4, _mm512_set1_epi32(k));
+            return _mm512_mask_blend_ps(0xFF00, _mm512_permutex2var_ps(m0, idx, m1), _mm512_permutex2var_ps(m2, idx, m3));
+        };
+        *x = component(0);
+        *y = component(1);
+        *z = component(2);
+        *w = component(3);
+    }
+
+    inline void storeInterleaved4(float *dst, SimdFloat<16> x, SimdFloat<16> y, SimdFloat<16> z, SimdFloat<16> w) {
+        // Float l of output register j is component l % 4 of vector 4 * j + l / 4
+        const __m512i idx = _mm512_setr_epi32(0, 16, 0, 16, 1, 17, 1, 17, 2, 18, 2, 18, 3, 19, 3, 19);
+        for (int j = 0; j < 4; ++j) {
+            __m512i e = _mm512_add_epi32(idx, _mm512_set1_epi32(4 * j));
+            __m512 xy = _mm512_permutex2var_ps(x, e, y);
+            __m512 zw = _mm512_permutex2var_ps(z, e, w);
+            _mm512_storeu_ps(dst + 16 * j, _mm512_mask_blend_ps(0xCCCC, xy, zw));
+        }
+    }
+}// namespace jtx
+
+#pragma clang diagnostic pop
+#pragma clang diagnostic pop
@@ -0,0 +1,112 @@
+#include "cpu.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define JTXLIB_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace jtx {
+
+#ifdef JTXLIB_X86
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#ifdef _MSC_VER
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<uint32_t>(r[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Register state the OS saves on context switches (XCR0)
+static uint64_t xgetbv0() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+}
+
+static CpuFeatures probe() {
+    CpuFeatures f;
+    uint32_t r[4];
+
+    cpuid(0, 0, r);
+    uint32_t maxLeaf = r[0];
+    if (maxLeaf < 1) return f;
+
+    cpuid(1, 0, r);
+    const uint32_t ecx1 = r[2];
+    f.sse41 = ecx1 & (1u << 19);
+    f.sse42 = ecx1 & (1u << 20);
+
+    // AVX needs OSXSAVE and the OS saving XMM (bit 1) and YMM (bit 2) state
+    const bool osxsave = ecx1 & (1u << 27);
+    const uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+    const bool osAvx = (xcr0 & 0x6) == 0x6;
+    // AVX-512 also needs opmask (bit 5) and ZMM (bits 6, 7) state
+    const bool osAvx512 = osAvx && (xcr0 & 0xE0) == 0xE0;
+
+    f.avx = osAvx && (ecx1 & (1u << 28));
+    f.fma = f.avx && (ecx1 & (1u << 12));
+    f.f16c = f.avx && (ecx1 & (1u << 29));
+
+    if (maxLeaf >= 7) {
+        cpuid(7, 0, r);
+        const uint32_t ebx7 = r[1];
+        f.avx2 = f.avx && (ebx7 & (1u << 5));
+        f.bmi2 = ebx7 & (1u << 8);
+        f.avx512f = osAvx512 && (ebx7 & (1u << 16));
+        f.avx512dq = f.avx512f && (ebx7 & (1u << 17));
+        f.avx512bw = f.avx512f && (ebx7 & (1u << 30));
+        f.avx512vl = f.avx512f && (ebx7 & (1u << 31));
+    }
+    return f;
+}
+#else
+static CpuFeatures probe() { return {}; }
+#endif
+
+const CpuFeatures &cpuFeatures() {
+    static const CpuFeatures features = probe();
+    return features;
+}
+
+bool isSupported(SimdIsa isa) {
+    const CpuFeatures &f = cpuFeatures();
+    switch (isa) {
+        case SimdIsa::Scalar:
+            return true;
+        case SimdIsa::AVX2:
+            return f.avx2 && f.fma && f.f16c;
+        case SimdIsa::AVX512:
+            return f.avx512f && f.avx2 && f.fma && f.f16c;
+    }
+    return false;
+}
+
+SimdIsa detectSimdIsa() {
+    if (isSupported(SimdIsa::AVX512)) return SimdIsa::AVX512;
+    if (isSupported(SimdIsa::AVX2)) return SimdIsa::AVX2;
+    return SimdIsa::Scalar;
+}
+
+const char *toString(SimdIsa isa) {
+    switch (isa) {
+        case SimdIsa::Scalar:
+            return "scalar";
+        case SimdIsa::AVX2:
+            return "avx2";
+        case SimdIsa::AVX512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+}// namespace jtx
@@ -0,0 +1,42 @@
+/**
+ * Runtime CPU feature detection (cpuid + xgetbv)
+ *
+ * A feature is only reported when both the CPU and the OS support it, i.e. AVX/AVX-512 also require the
+ * OS to save the extended register state. On non-x86 targets every feature is reported as missing.
+ */
+#pragma once
+
+#include <jtxlib.hpp>
+
+#include <cstdint>
+
+namespace jtx {
+
+struct CpuFeatures {
+    bool sse41 = false;
+    bool sse42 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool f16c = false;
+    bool bmi2 = false;
+    bool avx512f = false;
+    bool avx512dq = false;
+    bool avx512bw = false;
+    bool avx512vl = false;
+};
+
+// Instruction sets the SIMD kernels are compiled for, ordered from narrowest to widest
+enum class SimdIsa : uint8_t { Scalar, AVX2, AVX512 };
+
+// Probed once and cached
+JTX_HOST const CpuFeatures &cpuFeatures();
+
+// Widest SimdIsa the CPU supports
+JTX_HOST SimdIsa detectSimdIsa();
+
+JTX_HOST bool isSupported(SimdIsa isa);
+
+JTX_HOST const char *toString(SimdIsa isa);
+
+}// namespace jtx
@@ -0,0 +1,41 @@
+#include "kernels.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace jtx {
+
+const KernelTable *simdKernels(SimdIsa isa) {
+    if (!isSupported(isa)) return nullptr;
+    switch (isa) {
+        case SimdIsa::Scalar:
+            return detail::scalarKernelTable();
+        case SimdIsa::AVX2:
+            return detail::avx2KernelTable();
+        case SimdIsa::AVX512:
+            return detail::avx512KernelTable();
+    }
+    return nullptr;
+}
+
+static const KernelTable &selectKernels() {
+    SimdIsa isa = detectSimdIsa();
+    if (const char *env = std::getenv("JTXLIB_SIMD_ISA")) {
+        for (SimdIsa cap: {SimdIsa::Scalar, SimdIsa::AVX2, SimdIsa::AVX512}) {
+            if (std::strcmp(env, toString(cap)) == 0 && cap < isa) isa = cap;
+        }
+    }
+
+    // Fall back to narrower tables if the widest one was not compiled in
+    for (int i = static_cast<int>(isa); i >= 0; --i) {
+        if (const KernelTable *table = simdKernels(static_cast<SimdIsa>(i))) return *table;
+    }
+    return *detail::scalarKernelTable();
+}
+
+const KernelTable &simdKernels() {
+    static const KernelTable &table = selectKernels();
+    return table;
+}
+
+}// namespace jtx
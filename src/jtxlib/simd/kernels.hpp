@@ -0,0 +1,140 @@
+/**
+ * Batch kernels with runtime ISA dispatch
+ *
+ * Each kernel is written once (simd/kernels_impl.hpp) against SimdFloat<N> and compiled in one translation
+ * unit per instruction set (kernels_scalar.cpp, kernels_avx2.cpp, kernels_avx512.cpp) with per-file compiler
+ * flags. The first call to simdKernels() picks the widest table the CPU supports, so the rest of the library
+ * can be built for a baseline CPU and still use AVX2/AVX-512 where available.
+ *
+ * The JTXLIB_SIMD_ISA environment variable (scalar, avx2, avx512) caps the selected ISA, which is useful to
+ * compare code paths on the same machine.
+ *
+ * All arrays are structure-of-arrays and don't need to be aligned.
+ */
+#pragma once
+
+#include <jtxlib.hpp>
+#include <jtxlib/math/mat4.hpp>
+#include <jtxlib/simd/cpu.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace jtx {
+
+// Axis-aligned boxes in SoA layout, box i is [min{X,Y,Z}[i], max{X,Y,Z}[i]]
+struct BoxesSoA {
+    const float *minX, *minY, *minZ;
+    const float *maxX, *maxY, *maxZ;
+};
+
+struct KernelTable {
+    SimdIsa isa;
+
+    // out = m * (x, y, z, 1), divided by w unless w == 1. Outputs may alias the inputs
+    // Affine matrices (last row 0, 0, 0, 1) skip the w row entirely
+    void (*transformPoints)(const Mat4 &m, const float *x, const float *y, const float *z,
+                            float *outX, float *outY, float *outZ, size_t n);
+
+    // out = m * (x, y, z, 0). Outputs may alias the inputs
+    void (*transformVectors)(const Mat4 &m, const float *x, const float *y, const float *z,
+                             float *outX, float *outY, float *outZ, size_t n);
+
+    // Same as above for packed {x, y, z} triples (arrays of Point3f/Vec3f), out may alias in
+    void (*transformPointsAoS)(const Mat4 &m, const float *in, float *out, size_t n);
+    void (*transformVectorsAoS)(const Mat4 &m, const float *in, float *out, size_t n);
+
+    // Bounds of m applied to each packed {minX, minY, minZ, maxX, maxY, maxZ} box, same semantics as
+    // Mat4::applyToBBox. out may alias in
+    void (*transformBoxes)(const Mat4 &m, const float *in, float *out, size_t n);
+
+    // Mat4::inverse() of n matrices. Singular ones come out as NaN with invertible[i] (optional) set to 0.
+    // Returns the number of invertible matrices, out may alias in
+    size_t (*invertMatrices)(const Mat4 *in, Mat4 *out, uint8_t *invertible, size_t n);
+
+    // Slab test of one ray against n boxes, same semantics as AABB3::intersectP
+    // hit[i] is 1 if the ray hits box i within [0, tMax]; tHit[i] (optional) is the entry distance
+    size_t (*intersectRayBoxes)(const float origin[3], const float invDir[3], float tMax, const BoxesSoA &boxes,
+                                size_t n, uint8_t *hit, float *tHit);
+
+    // Uniform floats in [0, 1) from a counter-based hash of (seed, index)
+    // Results are identical for every ISA, so a range can be split across threads with the offset
+    void (*fillRandom)(float *out, size_t n, uint64_t seed, uint32_t offset);
+
+    // float <-> IEEE half and bfloat16 bit patterns, same bits as the scalar conversions in math/half.hpp
+    void (*floatToHalf)(const float *in, uint16_t *out, size_t n);
+    void (*halfToFloat)(const uint16_t *in, float *out, size_t n);
+    void (*floatToBFloat16)(const float *in, uint16_t *out, size_t n);
+    void (*bfloat16ToFloat)(const uint16_t *in, float *out, size_t n);
+
+    // Octahedral encoding of packed {x, y, z} unit vectors into (x, y) pairs and back, same as OctahedralVecT.
+    // Encoding gives the same integers as the scalar code
+    void (*encodeOctahedral16)(const float *in, uint16_t *out, size_t n);
+    void (*decodeOctahedral16)(const uint16_t *in, float *out, size_t n);
+    void (*encodeOctahedral8)(const float *in, uint8_t *out, size_t n);
+    void (*decodeOctahedral8)(const uint8_t *in, float *out, size_t n);
+
+    // Equal-area mapping between packed {u, v} points in [0, 1]^2 and packed {x, y, z} unit vectors, same as
+    // EqualAreaSquareToSphere/EqualAreaSphereToSquare. wrapEqualAreaSquare folds {u, v} points back into the
+    // square like WrapEqualAreaSquare. out may alias in for the wrap only
+    void (*equalAreaSquareToSphere)(const float *in, float *out, size_t n);
+    void (*equalAreaSphereToSquare)(const float *in, float *out, size_t n);
+    void (*wrapEqualAreaSquare)(const float *in, float *out, size_t n);
+};
+
+// Table for the widest supported ISA, resolved on first use
+JTX_HOST const KernelTable &simdKernels();
+
+// Table for a specific ISA, nullptr if it was not compiled in or the CPU does not support it
+JTX_HOST const KernelTable *simdKernels(SimdIsa isa);
+
+JTX_HOST JTX_INLINE void batchTransformPoints(const Mat4 &m, const float *x, const float *y, const float *z,
+                                              float *outX, float *outY, float *outZ, size_t n) {
+    simdKernels().transformPoints(m, x, y, z, outX, outY, outZ, n);
+}
+
+JTX_HOST JTX_INLINE void batchTransformVectors(const Mat4 &m, const float *x, const float *y, const float *z,
+                                               float *outX, float *outY, float *outZ, size_t n) {
+    simdKernels().transformVectors(m, x, y, z, outX, outY, outZ, n);
+}
+
+static_assert(sizeof(Vec3f) == 3 * sizeof(float), "The AoS kernels assume Vec3f is three packed floats");
+
+JTX_HOST JTX_INLINE void batchTransformPoints(const Mat4 &m, const Point3f *in, Point3f *out, size_t n) {
+    simdKernels().transformPointsAoS(m, reinterpret_cast<const float *>(in), reinterpret_cast<float *>(out), n);
+}
+
+JTX_HOST JTX_INLINE void batchTransformVectors(const Mat4 &m, const Vec3f *in, Vec3f *out, size_t n) {
+    simdKernels().transformVectorsAoS(m, reinterpret_cast<const float *>(in), reinterpret_cast<float *>(out), n);
+}
+
+static_assert(sizeof(BBox3f) == 6 * sizeof(float), "transformBoxes assumes BBox3f is six packed floats");
+
+JTX_HOST JTX_INLINE void batchTransformBoxes(const Mat4 &m, const BBox3f *in, BBox3f *out, size_t n) {
+    simdKernels().transformBoxes(m, reinterpret_cast<const float *>(in), reinterpret_cast<float *>(out), n);
+}
+
+JTX_HOST JTX_INLINE size_t batchInvertMatrices(const Mat4 *in, Mat4 *out, size_t n, uint8_t *invertible = nullptr) {
+    return simdKernels().invertMatrices(in, out, invertible, n);
+}
+
+// Returns the number of boxes hit
+JTX_HOST JTX_INLINE size_t batchIntersectRayBoxes(const Point3f &o, const Vec3f &d, float tMax, const BoxesSoA &boxes,
+                                                  size_t n, uint8_t *hit, float *tHit = nullptr) {
+    const float origin[3] = {o.x, o.y, o.z};
+    const float invDir[3] = {1 / d.x, 1 / d.y, 1 / d.z};
+    return simdKernels().intersectRayBoxes(origin, invDir, tMax, boxes, n, hit, tHit);
+}
+
+JTX_HOST JTX_INLINE void fillRandom(float *out, size_t n, uint64_t seed, uint32_t offset = 0) {
+    simdKernels().fillRandom(out, n, seed, offset);
+}
+
+namespace detail {
+    // Defined by the per-ISA translation units, nullptr when the ISA could not be compiled
+    JTX_HOST const KernelTable *scalarKernelTable();
+    JTX_HOST const KernelTable *avx2KernelTable();
+    JTX_HOST const KernelTable *avx512KernelTable();
+}// namespace detail
+
+}// namespace jtx
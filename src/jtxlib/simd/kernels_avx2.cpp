@@ -0,0 +1,15 @@
+// Built with -mavx2 -mfma -mf16c (see CMakeLists.txt)
+#include "kernels_impl.hpp"
+
+namespace jtx {
+
+const KernelTable *detail::avx2KernelTable() {
+#if defined(__AVX2__) && defined(__FMA__)
+    static constexpr KernelTable table = Kernels<8>::table(SimdIsa::AVX2);
+    return &table;
+#else
+    return nullptr;
+#endif
+}
+
+}// namespace jtx
@@ -0,0 +1,24 @@
+// Built with -mavx512f -mavx2 -mfma -mf16c (see CMakeLists.txt)
+// GCC 12 reports the _mm512_undefined_* placeholders in avx512fintrin.h as uninitialized (a false positive)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include "kernels_impl.hpp"
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace jtx {
+
+const KernelTable *detail::avx512KernelTable() {
+#if defined(__AVX512F__)
+    static constexpr KernelTable table = Kernels<16>::table(SimdIsa::AVX512);
+    return &table;
+#else
+    return nullptr;
+#endif
+}
+
+}// namespace jtx
@@ -0,0 +1,404 @@
+/**
+ * Kernel implementations shared by the per-ISA translation units
+ *
+ * Only include this from kernels_scalar.cpp, kernels_avx2.cpp and kernels_avx512.cpp. Everything here has
+ * internal linkage and the SIMD types live in an ISA-specific inline namespace, so the copies compiled with
+ * different flags never get merged by the linker. For the same reason the kernels only read Mat4::data and
+ * don't call any inline function from the rest of the library or the standard library, not even
+ * std::numeric_limits or std::array: unoptimized builds emit those as weak copies with AVX encodings, and the
+ * linker may keep one of them for the whole program. Use the constexpr constants in constants.hpp instead.
+ */
+#pragma once
+
+#include <jtxlib/simd/kernels.hpp>
+#include <jtxlib/simd/simdhalf.hpp>
+#include <jtxlib/simd/simdmat4.hpp>
+#include <jtxlib/simd/simdspherical.hpp>
+
+namespace jtx {
+namespace {
+    template<int N>
+    struct Kernels {
+        using F = SimdFloat<N>;
+        using I = SimdInt<N>;
+
+        // Runs body(offset, count) over [0, n) in blocks of N, the tail goes through a padded copy so it
+        // produces exactly the same results as a full block
+        template<typename Body>
+        static void forBlocks(size_t n, Body body) {
+            size_t i = 0;
+            for (; i + N <= n; i += N) body(i, N);
+            if (i < n) body(i, n - i);
+        }
+
+        static F load(const float *p, size_t count) {
+            if (count == N) return F::loadu(p);
+            float tmp[N] = {};
+            for (size_t k = 0; k < count; ++k) tmp[k] = p[k];
+            return F::loadu(tmp);
+        }
+
+        static void store(F v, float *p, size_t count) {
+            if (count == N) return v.storeu(p);
+            float tmp[N];
+            v.storeu(tmp);
+            for (size_t k = 0; k < count; ++k) p[k] = tmp[k];
+        }
+
+        static bool isAffine(const Mat4 &m) {
+            const auto &d = m.data;
+            return d[3][0] == 0.0f && d[3][1] == 0.0f && d[3][2] == 0.0f && d[3][3] == 1.0f;
+        }
+
+        // m * (x, y, z, 1) for points and m * (x, y, z, 0) for vectors. When the matrix is affine w is always 1,
+        // otherwise lanes are divided by w unless it's exactly 1
+        template<bool IsPoint, bool Affine>
+        static void transformBlock(const Mat4 &m, F &x, F &y, F &z) {
+            const auto &d = m.data;
+            auto row = [&](int r) {
+                F last = IsPoint ? fma(F(d[r][2]), z, F(d[r][3])) : F(d[r][2]) * z;
+                return fma(F(d[r][0]), x, fma(F(d[r][1]), y, last));
+            };
+            F xp = row(0), yp = row(1), zp = row(2);
+
+            if constexpr (IsPoint && !Affine) {
+                F wp = row(3);
+                auto affine = wp == F(1.0f);
+                if (!affine.all()) {
+                    xp = select(affine, xp, xp / wp);
+                    yp = select(affine, yp, yp / wp);
+                    zp = select(affine, zp, zp / wp);
+                }
+            }
+            x = xp, y = yp, z = zp;
+        }
+
+        template<bool IsPoint, bool Affine>
+        static void transformSoA(const Mat4 &m, const float *x, const float *y, const float *z,
+                                 float *outX, float *outY, float *outZ, size_t n) {
+            forBlocks(n, [&](size_t i, size_t count) {
+                F px = load(x + i, count), py = load(y + i, count), pz = load(z + i, count);
+                transformBlock<IsPoint, Affine>(m, px, py, pz);
+                store(px, outX + i, count);
+                store(py, outY + i, count);
+                store(pz, outZ + i, count);
+            });
+        }
+
+        template<bool IsPoint, bool Affine>
+        static void transformAoS(const Mat4 &m, const float *in, float *out, size_t n) {
+            forBlocks(n, [&](size_t i, size_t count) {
+                F x, y, z;
+                if (count == N) {
+                    loadInterleaved3(in + 3 * i, &x, &y, &z);
+                } else {
+                    float tmp[3 * N] = {};
+                    for (size_t k = 0; k < 3 * count; ++k) tmp[k] = in[3 * i + k];
+                    loadInterleaved3(tmp, &x, &y, &z);
+                }
+
+                transformBlock<IsPoint, Affine>(m, x, y, z);
+
+                if (count == N) {
+                    storeInterleaved3(out + 3 * i, x, y, z);
+                } else {
+                    float tmp[3 * N];
+                    storeInterleaved3(tmp, x, y, z);
+                    for (size_t k = 0; k < 3 * count; ++k) out[3 * i + k] = tmp[k];
+                }
+            });
+        }
+
+        static void transformPoints(const Mat4 &m, const float *x, const float *y, const float *z,
+                                    float *outX, float *outY, float *outZ, size_t n) {
+            if (isAffine(m)) transformSoA<true, true>(m, x, y, z, outX, outY, outZ, n);
+            else transformSoA<true, false>(m, x, y, z, outX, outY, outZ, n);
+        }
+
+        static void transformVectors(const Mat4 &m, const float *x, const float *y, const float *z,
+                                     float *outX, float *outY, float *outZ, size_t n) {
+            transformSoA<false, true>(m, x, y, z, outX, outY, outZ, n);
+        }
+
+        static void transformPointsAoS(const Mat4 &m, const float *in, float *out, size_t n) {
+            if (isAffine(m)) transformAoS<true, true>(m, in, out, n);
+            else transformAoS<true, false>(m, in, out, n);
+        }
+
+        static void transformVectorsAoS(const Mat4 &m, const float *in, float *out, size_t n) {
+            transformAoS<false, true>(m, in, out, n);
+        }
+
+        // Boxes are packed {minX, minY, minZ, maxX, maxY, maxZ}. Loads are gathers, stores go through a
+        // transposed copy since there is no scatter
+        static void transformBoxes(const Mat4 &m, const float *in, float *out, size_t n) {
+            const auto &d = m.data;
+            const bool affine = isAffine(m);
+
+            alignas(64) int32_t lane[N];
+            for (int k = 0; k < N; ++k) lane[k] = 6 * k;
+            const I offsets = I::load(lane);
+
+            forBlocks(n, [&](size_t i, size_t count) {
+                const float *base = in + 6 * i;
+                auto active = offsets < I(static_cast<int32_t>(6 * count));
+                F lo[3], hi[3];
+                for (int c = 0; c < 3; ++c) {
+                    lo[c] = count == N ? gather(base + c, offsets) : gather(base + c, offsets, active);
+                    hi[c] = count == N ? gather(base + 3 + c, offsets) : gather(base + 3 + c, offsets, active);
+                }
+
+                F rlo[3], rhi[3];
+                if (affine) {
+                    // Arvo's method, same operation order as Mat4::applyToBBox
+                    for (int r = 0; r < 3; ++r) {
+                        rlo[r] = rhi[r] = F(d[r][3]);
+                        for (int c = 0; c < 3; ++c) {
+                            F a = F(d[r][c]) * lo[c];
+                            F b = F(d[r][c]) * hi[c];
+                            rlo[r] += min(a, b);
+                            rhi[r] += max(a, b);
+                        }
+                    }
+                } else {
+                    for (int r = 0; r < 3; ++r) {
+                        rlo[r] = F(JTX_MAX_F);
+                        rhi[r] = F(JTX_LOWEST_F);
+                    }
+                    for (int corner = 0; corner < 8; ++corner) {
+                        F x = corner & 1 ? hi[0] : lo[0];
+                        F y = corner & 2 ? hi[1] : lo[1];
+                        F z = corner & 4 ? hi[2] : lo[2];
+                        transformBlock<true, false>(m, x, y, z);
+                        rlo[0] = min(rlo[0], x), rlo[1] = min(rlo[1], y), rlo[2] = min(rlo[2], z);
+                        rhi[0] = max(rhi[0], x), rhi[1] = max(rhi[1], y), rhi[2] = max(rhi[2], z);
+                    }
+                }
+
+                auto degenerate = (lo[0] > hi[0]) | (lo[1] > hi[1]) | (lo[2] > hi[2]);
+                alignas(64) float res[6][N];
+                for (int c = 0; c < 3; ++c) {
+                    select(degenerate, lo[c], rlo[c]).store(res[c]);
+                    select(degenerate, hi[c], rhi[c]).store(res[3 + c]);
+                }
+                for (size_t k = 0; k < count; ++k) {
+                    for (int c = 0; c < 6; ++c) out[6 * (i + k) + c] = res[c][k];
+                }
+            });
+        }
+
+        static size_t invertMatrices(const Mat4 *in, Mat4 *out, uint8_t *invertible, size_t n) {
+            size_t count = 0;
+            forBlocks(n, [&](size_t i, size_t blockCount) {
+                SimdMask<N> ok;
+                inverse(SimdMat4<N>::loadPartial(in + i, blockCount), &ok).storePartial(out + i, blockCount);
+
+                int mask = ok.movemask();
+                for (size_t k = 0; k < blockCount; ++k) {
+                    uint8_t flag = (mask >> k) & 1;
+                    if (invertible) invertible[i + k] = flag;
+                    count += flag;
+                }
+            });
+            return count;
+        }
+
+        static size_t intersectRayBoxes(const float origin[3], const float invDir[3], float tMax,
+                                        const BoxesSoA &boxes, size_t n, uint8_t *hit, float *tHit) {
+            const float *mins[3] = {boxes.minX, boxes.minY, boxes.minZ};
+            const float *maxs[3] = {boxes.maxX, boxes.maxY, boxes.maxZ};
+            size_t hits = 0;
+
+            forBlocks(n, [&](size_t i, size_t count) {
+                F t0(0.0f), t1(tMax);
+                for (int axis = 0; axis < 3; ++axis) {
+                    F o(origin[axis]), inv(invDir[axis]);
+                    F tNear = (load(mins[axis] + i, count) - o) * inv;
+                    F tFar = (load(maxs[axis] + i, count) - o) * inv;
+
+                    // Same comparisons as AABB3::intersectP so NaNs (0 * inf) are ignored the same way
+                    auto swap = tNear > tFar;
+                    F lo = select(swap, tFar, tNear);
+                    F hi = select(swap, tNear, tFar);
+                    t0 = select(lo > t0, lo, t0);
+                    t1 = select(hi < t1, hi, t1);
+                }
+
+                int mask = (~(t0 > t1)).movemask();
+                for (size_t k = 0; k < count; ++k) {
+                    uint8_t h = (mask >> k) & 1;
+                    hit[i + k] = h;
+                    hits += h;
+                }
+                if (tHit) store(t0, tHit + i, count);
+            });
+            return hits;
+        }
+
+        // lowbias32 by Chris Wellons, https://nullprogram.com/blog/2018/07/31/
+        static I hash(I x) {
+            x = x ^ shiftRightLogical(x, 16);
+            x = x * I(0x7feb352d);
+            x = x ^ shiftRightLogical(x, 15);
+            x = x * I(static_cast<int32_t>(0x846ca68bu));
+            x = x ^ shiftRightLogical(x, 16);
+            return x;
+        }
+
+        static void fillRandom(float *out, size_t n, uint64_t seed, uint32_t offset) {
+            I key0(static_cast<int32_t>(seed));
+            I key1(static_cast<int32_t>(seed >> 32));
+
+            alignas(64) int32_t lane[N];
+            for (int k = 0; k < N; ++k) lane[k] = k;
+            I iota = I::load(lane);
+
+            forBlocks(n, [&](size_t i, size_t count) {
+                I index = iota + I(static_cast<int32_t>(offset + static_cast<uint32_t>(i)));
+                I h = hash(hash(index ^ key0) + key1);
+                // Top 24 bits give every float in [0, 1) with spacing 2^-24
+                F u = toFloat(shiftRightLogical(h, 8)) * F(0x1p-24f);
+                store(u, out + i, count);
+            });
+        }
+
+        // 16-bit conversions through the loadHalf/storeHalf style functions of simdhalf.hpp
+        template<F (*Load)(const uint16_t *)>
+        static void from16(const uint16_t *in, float *out, size_t n) {
+            forBlocks(n, [&](size_t i, size_t count) {
+                if (count == N) return Load(in + i).storeu(out + i);
+                uint16_t tmp[N] = {};
+                for (size_t k = 0; k < count; ++k) tmp[k] = in[i + k];
+                store(Load(tmp), out + i, count);
+            });
+        }
+
+        template<void (*Store)(uint16_t *, F)>
+        static void to16(const float *in, uint16_t *out, size_t n) {
+            forBlocks(n, [&](size_t i, size_t count) {
+                if (count == N) return Store(out + i, F::loadu(in + i));
+                uint16_t tmp[N];
+                Store(tmp, load(in + i, count));
+                for (size_t k = 0; k < count; ++k) out[i + k] = tmp[k];
+            });
+        }
+
+        template<typename T>
+        static void encodeOctahedral(const float *in, T *out, size_t n) {
+            constexpr float scale = static_cast<float>(T(~T(0)));
+            forBlocks(n, [&](size_t i, size_t count) {
+                SimdVec3f<N> v;
+                if (count == N) {
+                    loadInterleaved3(in + 3 * i, &v.x, &v.y, &v.z);
+                } else {
+                    float tmp[3 * N] = {};
+                    for (size_t k = 0; k < 3 * count; ++k) tmp[k] = in[3 * i + k];
+                    loadInterleaved3(tmp, &v.x, &v.y, &v.z);
+                }
+
+                I x, y;
+                jtx::encodeOctahedral(v, scale, &x, &y);
+                alignas(64) int32_t qx[N], qy[N];
+                x.store(qx);
+                y.store(qy);
+                for (size_t k = 0; k < count; ++k) {
+                    out[2 * (i + k)] = static_cast<T>(qx[k]);
+                    out[2 * (i + k) + 1] = static_cast<T>(qy[k]);
+                }
+            });
+        }
+
+        template<typename T>
+        static void decodeOctahedral(const T *in, float *out, size_t n) {
+            constexpr float scale = static_cast<float>(T(~T(0)));
+            forBlocks(n, [&](size_t i, size_t count) {
+                alignas(64) int32_t qx[N] = {}, qy[N] = {};
+                for (size_t k = 0; k < count; ++k) {
+                    qx[k] = in[2 * (i + k)];
+                    qy[k] = in[2 * (i + k) + 1];
+                }
+
+                SimdVec3f<N> v = jtx::decodeOctahedral(I::load(qx), I::load(qy), scale);
+                if (count == N) {
+                    storeInterleaved3(out + 3 * i, v.x, v.y, v.z);
+                } else {
+                    float tmp[3 * N];
+                    storeInterleaved3(tmp, v.x, v.y, v.z);
+                    for (size_t k = 0; k < 3 * count; ++k) out[3 * i + k] = tmp[k];
+                }
+            });
+        }
+
+        // Packed {u, v} pairs, the tail is padded with zeros
+        static void load2(const float *p, size_t count, F *u, F *v) {
+            alignas(64) float tu[N] = {}, tv[N] = {};
+            for (size_t k = 0; k < count; ++k) {
+                tu[k] = p[2 * k];
+                tv[k] = p[2 * k + 1];
+            }
+            *u = F::load(tu);
+            *v = F::load(tv);
+        }
+
+        static void store2(float *p, size_t count, F u, F v) {
+            alignas(64) float tu[N], tv[N];
+            u.store(tu);
+            v.store(tv);
+            for (size_t k = 0; k < count; ++k) {
+                p[2 * k] = tu[k];
+                p[2 * k + 1] = tv[k];
+            }
+        }
+
+        static void equalAreaSquareToSphere(const float *in, float *out, size_t n) {
+            forBlocks(n, [&](size_t i, size_t count) {
+                F u, v;
+                load2(in + 2 * i, count, &u, &v);
+                SimdVec3f<N> d = jtx::equalAreaSquareToSphere(u, v);
+                if (count == N) {
+                    storeInterleaved3(out + 3 * i, d.x, d.y, d.z);
+                } else {
+                    float tmp[3 * N];
+                    storeInterleaved3(tmp, d.x, d.y, d.z);
+                    for (size_t k = 0; k < 3 * count; ++k) out[3 * i + k] = tmp[k];
+                }
+            });
+        }
+
+        static void equalAreaSphereToSquare(const float *in, float *out, size_t n) {
+            forBlocks(n, [&](size_t i, size_t count) {
+                SimdVec3f<N> d;
+                if (count == N) {
+                    loadInterleaved3(in + 3 * i, &d.x, &d.y, &d.z);
+                } else {
+                    float tmp[3 * N] = {};
+                    for (size_t k = 0; k < 3 * count; ++k) tmp[k] = in[3 * i + k];
+                    loadInterleaved3(tmp, &d.x, &d.y, &d.z);
+                }
+
+                F u, v;
+                jtx::equalAreaSphereToSquare(d, &u, &v);
+                store2(out + 2 * i, count, u, v);
+            });
+        }
+
+        static void wrapEqualAreaSquare(const float *in, float *out, size_t n) {
+            forBlocks(n, [&](size_t i, size_t count) {
+                F u, v;
+                load2(in + 2 * i, count, &u, &v);
+                jtx::wrapEqualAreaSquare(&u, &v);
+                store2(out + 2 * i, count, u, v);
+            });
+        }
+
+        static constexpr KernelTable table(SimdIsa isa) {
+            return {isa, &transformPoints, &transformVectors, &transformPointsAoS, &transformVectorsAoS,
+                    &transformBoxes, &invertMatrices, &intersectRayBoxes, &fillRandom,
+                    &to16<storeHalf<N>>, &from16<loadHalf<N>>, &to16<storeBFloat16<N>>, &from16<loadBFloat16<N>>,
+                    &encodeOctahedral<uint16_t>, &decodeOctahedral<uint16_t>,
+                    &encodeOctahedral<uint8_t>, &decodeOctahedral<uint8_t>,
+                    &equalAreaSquareToSphere, &equalAreaSphereToSquare, &wrapEqualAreaSquare};
+        }
+    };
+}// namespace
+}// namespace jtx
@@ -0,0 +1,12 @@
+// Built with the default flags of the library, the 4-wide types use the portable backend (or SSE4.1 if the
+// whole library is built with it)
+#include "kernels_impl.hpp"
+
+namespace jtx {
+
+const KernelTable *detail::scalarKernelTable() {
+    static constexpr KernelTable table = Kernels<4>::table(SimdIsa::Scalar);
+    return &table;
+}
+
+}// namespace jtx
@@ -0,0 +1,569 @@
+#pragma once
+
+#include <jtxlib.hpp>
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The SIMD types change representation with the instruction sets enabled for a translation unit, so they
+ * live in an inline namespace named after the backend. This keeps translation units compiled with
+ * different flags (see simd/kernels.hpp) from violating the ODR with each other.
+ */
+#if defined(__AVX512F__)
+#define JTX_SIMD_ABI simd_avx512
+#elif defined(__AVX2__)
+#define JTX_SIMD_ABI simd_avx2
+#elif defined(__SSE4_1__)
+#define JTX_SIMD_ABI simd_sse4
+#else
+#define JTX_SIMD_ABI simd_scalar
+#endif
+
+namespace jtx::inline JTX_SIMD_ABI {
+    /**
+     * Width-generic SIMD types used in a SoA data layout
+     *  - SimdFloat<N>: N floats
+     *  - SimdInt<N>: N 32-bit signed integers
+     *  - SimdMask<N>: result of lane-wise comparisons
+     *
+     * The primary templates below are the portable scalar backend (plain arrays, any width). Native
+     * backends specialize them depending on the instruction sets enabled at compile time:
+     *  - SSE4.1:  SimdFloat<4>  (__m128)
+     *  - AVX2:    SimdFloat<8>  (__m256)
+     *  - AVX-512: SimdFloat<16> (__m512)
+     *
+     * All operators and functions are hidden friends so that scalars convert implicitly (a + 1.0f) and
+     * they never clash with the scalar overloads in jtx.
+     */
+    template<int N>
+    struct SimdMask;
+    template<int N>
+    struct SimdInt;
+    template<int N>
+    struct SimdFloat;
+
+    // Widest width with a native backend for the current compilation flags
+#if defined(__AVX512F__)
+    static constexpr int SIMD_NATIVE_WIDTH = 16;
+#elif defined(__AVX2__)
+    static constexpr int SIMD_NATIVE_WIDTH = 8;
+#else
+    static constexpr int SIMD_NATIVE_WIDTH = 4;
+#endif
+
+    //region Scalar backend
+    template<int N>
+    struct SimdMask {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "SIMD width must be a power of two");
+        static constexpr size_t size = N;
+
+        bool lanes[N];
+
+        // Sets all lanes to false
+        SimdMask() : lanes{} {}
+        SimdMask(bool val) {
+            for (int i = 0; i < N; ++i) lanes[i] = val;
+        }
+
+        // One bit per lane, lane 0 is the least significant bit
+        [[nodiscard]] inline int movemask() const {
+            int m = 0;
+            for (int i = 0; i < N; ++i) m |= static_cast<int>(lanes[i]) << i;
+            return m;
+        }
+
+        [[nodiscard]] inline bool any() const { return movemask() != 0; }
+        [[nodiscard]] inline bool all() const { return movemask() == static_cast<int>((1ull << N) - 1); }
+        [[nodiscard]] inline bool none() const { return movemask() == 0; }
+
+        inline bool operator[](size_t i) const { return lanes[i]; }
+
+        friend inline SimdMask operator&(SimdMask a, SimdMask b) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = a.lanes[i] && b.lanes[i];
+            return a;
+        }
+
+        friend inline SimdMask operator|(SimdMask a, SimdMask b) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = a.lanes[i] || b.lanes[i];
+            return a;
+        }
+
+        friend inline SimdMask operator^(SimdMask a, SimdMask b) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = a.lanes[i] != b.lanes[i];
+            return a;
+        }
+
+        friend inline SimdMask operator~(SimdMask a) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = !a.lanes[i];
+            return a;
+        }
+    };
+
+    template<int N>
+    struct SimdInt {
+        static constexpr size_t size = N;
+
+        alignas(N * sizeof(int32_t)) int32_t lanes[N];
+
+        // Sets all lanes to 0
+        SimdInt() : lanes{} {}
+        SimdInt(int32_t val) {
+            for (int i = 0; i < N; ++i) lanes[i] = val;
+        }
+
+        inline int32_t &operator[](size_t i) { return lanes[i]; }
+        inline const int32_t &operator[](size_t i) const { return lanes[i]; }
+
+        static inline SimdInt load(const int32_t *ptr) {
+            SimdInt r;
+            for (int i = 0; i < N; ++i) r.lanes[i] = ptr[i];
+            return r;
+        }
+
+        static inline SimdInt loadu(const int32_t *ptr) { return load(ptr); }
+
+        inline void store(int32_t *ptr) const {
+            for (int i = 0; i < N; ++i) ptr[i] = lanes[i];
+        }
+
+        inline void storeu(int32_t *ptr) const { store(ptr); }
+
+        inline SimdInt &operator+=(SimdInt other) { return *this = *this + other; }
+        inline SimdInt &operator-=(SimdInt other) { return *this = *this - other; }
+        inline SimdInt &operator*=(SimdInt other) { return *this = *this * other; }
+        inline SimdInt &operator&=(SimdInt other) { return *this = *this & other; }
+        inline SimdInt &operator|=(SimdInt other) { return *this = *this | other; }
+        inline SimdInt &operator^=(SimdInt other) { return *this = *this ^ other; }
+        inline SimdInt &operator<<=(int n) { return *this = *this << n; }
+        inline SimdInt &operator>>=(int n) { return *this = *this >> n; }
+
+        // Arithmetic wraps around like the native backends
+        template<typename F>
+        static inline SimdInt map(SimdInt a, SimdInt b, F f) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = f(a.lanes[i], b.lanes[i]);
+            return a;
+        }
+
+        template<typename F>
+        static inline SimdMask<N> compare(SimdInt a, SimdInt b, F f) {
+            SimdMask<N> m;
+            for (int i = 0; i < N; ++i) m.lanes[i] = f(a.lanes[i], b.lanes[i]);
+            return m;
+        }
+
+        friend inline SimdInt operator+(SimdInt a, SimdInt b) {
+            return map(a, b, [](int32_t x, int32_t y) { return int32_t(uint32_t(x) + uint32_t(y)); });
+        }
+
+        friend inline SimdInt operator-(SimdInt a, SimdInt b) {
+            return map(a, b, [](int32_t x, int32_t y) { return int32_t(uint32_t(x) - uint32_t(y)); });
+        }
+
+        friend inline SimdInt operator*(SimdInt a, SimdInt b) {
+            return map(a, b, [](int32_t x, int32_t y) { return int32_t(uint32_t(x) * uint32_t(y)); });
+        }
+
+        friend inline SimdInt operator-(SimdInt a) { return SimdInt(0) - a; }
+
+        friend inline SimdInt operator&(SimdInt a, SimdInt b) {
+            return map(a, b, [](int32_t x, int32_t y) { return x & y; });
+        }
+
+        friend inline SimdInt operator|(SimdInt a, SimdInt b) {
+            return map(a, b, [](int32_t x, int32_t y) { return x | y; });
+        }
+
+        friend inline SimdInt operator^(SimdInt a, SimdInt b) {
+            return map(a, b, [](int32_t x, int32_t y) { return x ^ y; });
+        }
+
+        friend inline SimdInt operator~(SimdInt a) { return a ^ SimdInt(-1); }
+
+        friend inline SimdInt operator<<(SimdInt a, int n) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = int32_t(uint32_t(a.lanes[i]) << n);
+            return a;
+        }
+
+        // Arithmetic (sign-extending) shift
+        friend inline SimdInt operator>>(SimdInt a, int n) {
+            for (int i = 0; i < N; ++i) a.lanes[i] >>= n;
+            return a;
+        }
+
+        // Logical (zero-filling) shift
+        friend inline SimdInt shiftRightLogical(SimdInt a, int n) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = int32_t(uint32_t(a.lanes[i]) >> n);
+            return a;
+        }
+
+        // Per-lane shift amounts, amounts >= 32 give 0 (or the sign for arithmetic shifts)
+        friend inline SimdInt operator<<(SimdInt a, SimdInt n) {
+            return map(a, n, [](int32_t x, int32_t s) { return uint32_t(s) < 32 ? int32_t(uint32_t(x) << s) : 0; });
+        }
+
+        friend inline SimdInt operator>>(SimdInt a, SimdInt n) {
+            return map(a, n, [](int32_t x, int32_t s) { return x >> (uint32_t(s) < 32 ? s : 31); });
+        }
+
+        friend inline SimdInt shiftRightLogical(SimdInt a, SimdInt n) {
+            return map(a, n, [](int32_t x, int32_t s) { return uint32_t(s) < 32 ? int32_t(uint32_t(x) >> s) : 0; });
+        }
+
+        // ~a & b
+        friend inline SimdInt andnot(SimdInt a, SimdInt b) {
+            return map(a, b, [](int32_t x, int32_t y) { return ~x & y; });
+        }
+
+        friend inline SimdMask<N> operator==(SimdInt a, SimdInt b) {
+            return compare(a, b, [](int32_t x, int32_t y) { return x == y; });
+        }
+
+        friend inline SimdMask<N> operator!=(SimdInt a, SimdInt b) { return ~(a == b); }
+
+        friend inline SimdMask<N> operator<(SimdInt a, SimdInt b) {
+            return compare(a, b, [](int32_t x, int32_t y) { return x < y; });
+        }
+
+        friend inline SimdMask<N> operator>(SimdInt a, SimdInt b) { return b < a; }
+        friend inline SimdMask<N> operator<=(SimdInt a, SimdInt b) { return ~(b < a); }
+        friend inline SimdMask<N> operator>=(SimdInt a, SimdInt b) { return ~(a < b); }
+
+        friend inline SimdInt min(SimdInt a, SimdInt b) {
+            return map(a, b, [](int32_t x, int32_t y) { return x < y ? x : y; });
+        }
+
+        friend inline SimdInt max(SimdInt a, SimdInt b) {
+            return map(a, b, [](int32_t x, int32_t y) { return x > y ? x : y; });
+        }
+
+        // Picks a where mask is set, b otherwise
+        friend inline SimdInt select(SimdMask<N> mask, SimdInt a, SimdInt b) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = mask.lanes[i] ? a.lanes[i] : b.lanes[i];
+            return a;
+        }
+    };
+
+    template<int N>
+    struct SimdFloat {
+        static constexpr size_t size = N;
+        // Whether fma() rounds once, the scalar backend always uses std::fma
+        static constexpr bool fusedFma = true;
+
+        alignas(N * sizeof(float)) float lanes[N];
+
+        // Sets all lanes to 0
+        SimdFloat() : lanes{} {}
+        SimdFloat(float val) {
+            for (int i = 0; i < N; ++i) lanes[i] = val;
+        }
+
+        inline float &operator[](size_t i) { return lanes[i]; }
+        inline const float &operator[](size_t i) const { return lanes[i]; }
+
+        static inline SimdFloat load(const float *ptr) {
+            SimdFloat r;
+            for (int i = 0; i < N; ++i) r.lanes[i] = ptr[i];
+            return r;
+        }
+
+        static inline SimdFloat loadu(const float *ptr) { return load(ptr); }
+
+        inline void store(float *ptr) const {
+            for (int i = 0; i < N; ++i) ptr[i] = lanes[i];
+        }
+
+        inline void storeu(float *ptr) const { store(ptr); }
+
+        inline SimdFloat &operator+=(SimdFloat other) { return *this = *this + other; }
+        inline SimdFloat &operator-=(SimdFloat other) { return *this = *this - other; }
+        inline SimdFloat &operator*=(SimdFloat other) { return *this = *this * other; }
+        inline SimdFloat &operator/=(SimdFloat other) { return *this = *this / other; }
+
+        template<typename F>
+        static inline SimdFloat map(SimdFloat a, F f) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = f(a.lanes[i]);
+            return a;
+        }
+
+        template<typename F>
+        static inline SimdFloat map(SimdFloat a, SimdFloat b, F f) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = f(a.lanes[i], b.lanes[i]);
+            return a;
+        }
+
+        template<typename F>
+        static inline SimdMask<N> compare(SimdFloat a, SimdFloat b, F f) {
+            SimdMask<N> m;
+            for (int i = 0; i < N; ++i) m.lanes[i] = f(a.lanes[i], b.lanes[i]);
+            return m;
+        }
+
+        //region Operators
+        friend inline SimdFloat operator+(SimdFloat a, SimdFloat b) {
+            return map(a, b, [](float x, float y) { return x + y; });
+        }
+
+        friend inline SimdFloat operator-(SimdFloat a, SimdFloat b) {
+            return map(a, b, [](float x, float y) { return x - y; });
+        }
+
+        friend inline SimdFloat operator*(SimdFloat a, SimdFloat b) {
+            return map(a, b, [](float x, float y) { return x * y; });
+        }
+
+        friend inline SimdFloat operator/(SimdFloat a, SimdFloat b) {
+            return map(a, b, [](float x, float y) { return x / y; });
+        }
+
+        friend inline SimdFloat operator-(SimdFloat a) {
+            return map(a, [](float x) { return -x; });
+        }
+
+        friend inline SimdMask<N> operator==(SimdFloat a, SimdFloat b) {
+            return compare(a, b, [](float x, float y) { return x == y; });
+        }
+
+        friend inline SimdMask<N> operator!=(SimdFloat a, SimdFloat b) {
+            return compare(a, b, [](float x, float y) { return x != y; });
+        }
+
+        friend inline SimdMask<N> operator<(SimdFloat a, SimdFloat b) {
+            return compare(a, b, [](float x, float y) { return x < y; });
+        }
+
+        friend inline SimdMask<N> operator<=(SimdFloat a, SimdFloat b) {
+            return compare(a, b, [](float x, float y) { return x <= y; });
+        }
+
+        friend inline SimdMask<N> operator>(SimdFloat a, SimdFloat b) {
+            return compare(a, b, [](float x, float y) { return x > y; });
+        }
+
+        friend inline SimdMask<N> operator>=(SimdFloat a, SimdFloat b) {
+            return compare(a, b, [](float x, float y) { return x >= y; });
+        }
+        //endregion
+
+        //region Functions
+        // Picks a where mask is set, b otherwise
+        friend inline SimdFloat select(SimdMask<N> mask, SimdFloat a, SimdFloat b) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = mask.lanes[i] ? a.lanes[i] : b.lanes[i];
+            return a;
+        }
+
+        // a * b + c
+        friend inline SimdFloat fma(SimdFloat a, SimdFloat b, SimdFloat c) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = std::fma(a.lanes[i], b.lanes[i], c.lanes[i]);
+            return a;
+        }
+
+        // a * b - c
+        friend inline SimdFloat fms(SimdFloat a, SimdFloat b, SimdFloat c) {
+            for (int i = 0; i < N; ++i) a.lanes[i] = std::fma(a.lanes[i], b.lanes[i], -c.lanes[i]);
+            return a;
+        }
+
+        // Matches minps/maxps: returns b if either is NaN
+        friend inline SimdFloat min(SimdFloat a, SimdFloat b) {
+            return map(a, b, [](float x, float y) { return x < y ? x : y; });
+        }
+
+        friend inline SimdFloat max(SimdFloat a, SimdFloat b) {
+            return map(a, b, [](float x, float y) { return x > y ? x : y; });
+        }
+
+        friend inline SimdFloat abs(SimdFloat a) {
+            return map(a, [](float x) { return std::abs(x); });
+        }
+
+        friend inline SimdFloat floor(SimdFloat a) {
+            return map(a, [](float x) { return std::floor(x); });
+        }
+
+        friend inline SimdFloat ceil(SimdFloat a) {
+            return map(a, [](float x) { return std::ceil(x); });
+        }
+
+        // Rounds to the nearest integer, ties to even
+        friend inline SimdFloat round(SimdFloat a) {
+            return map(a, [](float x) { return std::nearbyint(x); });
+        }
+
+        friend inline SimdFloat sqrt(SimdFloat a) {
+            return map(a, [](float x) { return std::sqrt(x); });
+        }
+
+        // Hardware estimates of 1 / a and 1 / sqrt(a), exact in the scalar backend
+        friend inline SimdFloat rcpEstimate(SimdFloat a) {
+            return map(a, [](float x) { return 1.0f / x; });
+        }
+
+        friend inline SimdFloat rsqrtEstimate(SimdFloat a) {
+            return map(a, [](float x) { return 1.0f / std::sqrt(x); });
+        }
+        //endregion
+    };
+
+    template<int N>
+    inline SimdFloat<N> toFloat(SimdInt<N> a) {
+        SimdFloat<N> r;
+        for (int i = 0; i < N; ++i) r.lanes[i] = static_cast<float>(a.lanes[i]);
+        return r;
+    }
+
+    // Converts with truncation towards zero
+    template<int N>
+    inline SimdInt<N> toInt(SimdFloat<N> a) {
+        SimdInt<N> r;
+        for (int i = 0; i < N; ++i) r.lanes[i] = static_cast<int32_t>(a.lanes[i]);
+        return r;
+    }
+
+    // Reinterprets the bits of each lane
+    template<int N>
+    inline SimdFloat<N> asFloat(SimdInt<N> a) {
+        SimdFloat<N> r;
+        for (int i = 0; i < N; ++i) r.lanes[i] = std::bit_cast<float>(a.lanes[i]);
+        return r;
+    }
+
+    template<int N>
+    inline SimdInt<N> asInt(SimdFloat<N> a) {
+        SimdInt<N> r;
+        for (int i = 0; i < N; ++i) r.lanes[i] = std::bit_cast<int32_t>(a.lanes[i]);
+        return r;
+    }
+
+    // Converts with rounding to the nearest integer, ties to even
+    template<int N>
+    inline SimdInt<N> roundToInt(SimdFloat<N> a) {
+        SimdInt<N> r;
+        for (int i = 0; i < N; ++i) r.lanes[i] = static_cast<int32_t>(std::nearbyint(a.lanes[i]));
+        return r;
+    }
+
+    /**
+     * Loads base[idx[i]] into every lane
+     * The masked variants only load lanes where mask is set, the other lanes are taken from src and their
+     * indices are never dereferenced
+     */
+    template<int N>
+    inline SimdFloat<N> gather(const float *base, SimdInt<N> idx) {
+        SimdFloat<N> r;
+        for (int i = 0; i < N; ++i) r.lanes[i] = base[idx.lanes[i]];
+        return r;
+    }
+
+    template<int N>
+    inline SimdFloat<N> gather(const float *base, SimdInt<N> idx, SimdMask<N> mask, SimdFloat<N> src = SimdFloat<N>()) {
+        for (int i = 0; i < N; ++i) {
+            if (mask.lanes[i]) src.lanes[i] = base[idx.lanes[i]];
+        }
+        return src;
+    }
+
+    template<int N>
+    inline SimdInt<N> gather(const int32_t *base, SimdInt<N> idx) {
+        SimdInt<N> r;
+        for (int i = 0; i < N; ++i) r.lanes[i] = base[idx.lanes[i]];
+        return r;
+    }
+
+    template<int N>
+    inline SimdInt<N> gather(const int32_t *base, SimdInt<N> idx, SimdMask<N> mask, SimdInt<N> src = SimdInt<N>()) {
+        for (int i = 0; i < N; ++i) {
+            if (mask.lanes[i]) src.lanes[i] = base[idx.lanes[i]];
+        }
+        return src;
+    }
+
+    /**
+     * Transposes between interleaved (AoS) and SoA data
+     * loadInterleaved3 reads 3 * N floats {x0, y0, z0, x1, y1, z1, ...} into x, y and z, storeInterleaved3 is
+     * the inverse. The 4-component versions do the same for {x, y, z, w} groups. Pointers don't need to be
+     * aligned. Native backends implement these with shuffles instead of going through memory lane by lane.
+     */
+    template<int N>
+    inline void loadInterleaved3(const float *src, SimdFloat<N> *x, SimdFloat<N> *y, SimdFloat<N> *z) {
+        for (int i = 0; i < N; ++i) {
+            x->lanes[i] = src[3 * i];
+            y->lanes[i] = src[3 * i + 1];
+            z->lanes[i] = src[3 * i + 2];
+        }
+    }
+
+    template<int N>
+    inline void storeInterleaved3(float *dst, SimdFloat<N> x, SimdFloat<N> y, SimdFloat<N> z) {
+        for (int i = 0; i < N; ++i) {
+            dst[3 * i] = x.lanes[i];
+            dst[3 * i + 1] = y.lanes[i];
+            dst[3 * i + 2] = z.lanes[i];
+        }
+    }
+
+    template<int N>
+    inline void loadInterleaved4(const float *src, SimdFloat<N> *x, SimdFloat<N> *y, SimdFloat<N> *z, SimdFloat<N> *w) {
+        for (int i = 0; i < N; ++i) {
+            x->lanes[i] = src[4 * i];
+            y->lanes[i] = src[4 * i + 1];
+            z->lanes[i] = src[4 * i + 2];
+            w->lanes[i] = src[4 * i + 3];
+        }
+    }
+
+    template<int N>
+    inline void storeInterleaved4(float *dst, SimdFloat<N> x, SimdFloat<N> y, SimdFloat<N> z, SimdFloat<N> w) {
+        for (int i = 0; i < N; ++i) {
+            dst[4 * i] = x.lanes[i];
+            dst[4 * i + 1] = y.lanes[i];
+            dst[4 * i + 2] = z.lanes[i];
+            dst[4 * i + 3] = w.lanes[i];
+        }
+    }
+    //endregion
+}// namespace jtx
+
+#if defined(__SSE4_1__)
+#include "sse4.hpp"
+#endif
+#if defined(__AVX2__)
+#include "avx2.hpp"
+#endif
+#if defined(__AVX512F__)
+#include "avx512.hpp"
+#endif
+
+namespace jtx::inline JTX_SIMD_ABI {
+    /**
+     * Approximate 1 / a
+     * Native estimates have 12 (SSE/AVX) or 14 (AVX-512) bits of precision, one Newton-Raphson step
+     * brings them to ~23 bits
+     */
+    template<bool Refine = true, int N>
+    inline SimdFloat<N> rcp(SimdFloat<N> a) {
+        SimdFloat<N> r = rcpEstimate(a);
+        if constexpr (Refine) {
+            // r * (2 - a * r)
+            r = r * (SimdFloat<N>(2.0f) - a * r);
+        }
+        return r;
+    }
+
+    // Approximate 1 / sqrt(a), see rcp()
+    template<bool Refine = true, int N>
+    inline SimdFloat<N> rsqrt(SimdFloat<N> a) {
+        SimdFloat<N> r = rsqrtEstimate(a);
+        if constexpr (Refine) {
+            // 0.5 * r * (3 - a * r * r)
+            r = SimdFloat<N>(0.5f) * r * (SimdFloat<N>(3.0f) - a * r * r);
+        }
+        return r;
+    }
+
+    using SimdFloatN = SimdFloat<SIMD_NATIVE_WIDTH>;
+    using SimdIntN = SimdInt<SIMD_NATIVE_WIDTH>;
+    using SimdMaskN = SimdMask<SIMD_NATIVE_WIDTH>;
+}// namespace jtx
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "simdfloat.hpp"
+
+#include <cstdint>
+
+/**
+ * Lane-wise float <-> half and float <-> bfloat16 conversions
+ *
+ * toHalfBits/fromHalfBits are the scalar conversions in math/half.hpp done with SimdInt, so they give the same
+ * bits on every backend. loadHalf/storeHalf use F16C (or AVX-512) when the translation unit is built with it and
+ * fall back to those otherwise. No x86 extension we target converts bfloat16, it's cheap enough with integer ops.
+ */
+namespace jtx::inline JTX_SIMD_ABI {
+    // The 16-bit results are in the low half of each lane
+    template<int N>
+    inline SimdInt<N> toHalfBits(SimdFloat<N> f) {
+        using I = SimdInt<N>;
+        I bits = asInt(f);
+        I sign = bits & I(static_cast<int32_t>(0x80000000u));
+        bits = bits ^ sign;
+
+        I nan = I(0x7E00) | (shiftRightLogical(bits, 13) & I(0x3FF));
+        I overflow = select(bits > I(0x7F800000), nan, I(0x7C00));
+        I denormal = asInt(asFloat(bits) + SimdFloat<N>(0.5f)) - I(0x3F000000);
+        I mantissaOdd = shiftRightLogical(bits, 13) & I(1);
+        I normal = shiftRightLogical(bits + I(static_cast<int32_t>(0xC8000FFFu)) + mantissaOdd, 13);
+
+        I h = select(bits < I(0x38800000), denormal, normal);
+        h = select(bits >= I(0x47800000), overflow, h);
+        return h | shiftRightLogical(sign, 16);
+    }
+
+    // Only the low 16 bits of each lane are read
+    template<int N>
+    inline SimdFloat<N> fromHalfBits(SimdInt<N> h) {
+        using I = SimdInt<N>;
+        I bits = (h & I(0x7FFF)) << 13;
+        I exponent = bits & I(0x0F800000);
+        bits = bits + I(0x38000000);
+
+        I quiet = select((h & I(0x3FF)) == I(0), I(0), I(0x00400000));
+        I infNan = (bits + I(0x38000000)) | quiet;
+        I denormal = asInt(asFloat(bits + I(0x00800000)) - SimdFloat<N>(0x1p-14f));
+
+        bits = select(exponent == I(0x0F800000), infNan, bits);
+        bits = select(exponent == I(0), denormal, bits);
+        return asFloat(bits | ((h & I(0x8000)) << 16));
+    }
+
+    template<int N>
+    inline SimdInt<N> toBFloat16Bits(SimdFloat<N> f) {
+        using I = SimdInt<N>;
+        I bits = asInt(f);
+        auto isNan = (bits & I(0x7FFFFFFF)) > I(0x7F800000);
+        I rounded = shiftRightLogical(bits + I(0x7FFF) + (shiftRightLogical(bits, 16) & I(1)), 16);
+        return select(isNan, shiftRightLogical(bits, 16) | I(0x40), rounded) & I(0xFFFF);
+    }
+
+    template<int N>
+    inline SimdFloat<N> fromBFloat16Bits(SimdInt<N> b) {
+        return asFloat(b << 16);
+    }
+
+    //region Memory
+    // N halves from src, no alignment required
+    template<int N>
+    inline SimdFloat<N> loadHalf(const uint16_t *src) {
+#if defined(__F16C__)
+        if constexpr (N == 4) return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)));
+#endif
+#if defined(__F16C__) && defined(__AVX2__)
+        if constexpr (N == 8) return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+#endif
+#if defined(__AVX512F__)
+        if constexpr (N == 16) return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src)));
+#endif
+        alignas(64) int32_t tmp[N];
+        for (int i = 0; i < N; ++i) tmp[i] = src[i];
+        return fromHalfBits(SimdInt<N>::load(tmp));
+    }
+
+    template<int N>
+    inline void storeHalf(uint16_t *dst, SimdFloat<N> f) {
+#if defined(__F16C__)
+        if constexpr (N == 4) {
+            __m128i h = _mm_cvtps_ph(f.data, _MM_FROUND_TO_NEAREST_INT);
+            return _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), h);
+        }
+#endif
+#if defined(__F16C__) && defined(__AVX2__)
+        if constexpr (N == 8) {
+            __m128i h = _mm256_cvtps_ph(f.data, _MM_FROUND_TO_NEAREST_INT);
+            return _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), h);
+        }
+#endif
+#if defined(__AVX512F__)
+        if constexpr (N == 16) {
+            __m256i h = _mm512_cvtps_ph(f.data, _MM_FROUND_TO_NEAREST_INT);
+            return _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), h);
+        }
+#endif
+        alignas(64) int32_t tmp[N];
+        toHalfBits(f).store(tmp);
+        for (int i = 0; i < N; ++i) dst[i] = static_cast<uint16_t>(tmp[i]);
+    }
+
+    template<int N>
+    inline SimdFloat<N> loadBFloat16(const uint16_t *src) {
+        alignas(64) int32_t tmp[N];
+        for (int i = 0; i < N; ++i) tmp[i] = src[i];
+        return fromBFloat16Bits(SimdInt<N>::load(tmp));
+    }
+
+    template<int N>
+    inline void storeBFloat16(uint16_t *dst, SimdFloat<N> f) {
+        alignas(64) int32_t tmp[N];
+        toBFloat16Bits(f).store(tmp);
+        for (int i = 0; i < N; ++i) dst[i] = static_cast<uint16_t>(tmp[i]);
+    }
+    //endregion
+}// namespace jtx
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "simdvec.hpp"
+
+/**
+ * SimdMat4<N> holds N 4x4 matrices in SoA form: m[i][j] has element (i, j) of every matrix
+ *
+ * determinant, inverse and mul vectorize the scalar Mat4 versions in mat4.cpp: the same s0..s5/c0..c5
+ * cofactor expansion, difference of products and compensated inner products. Every lane gets the
+ * result of the scalar code, up to the scalar path not always having a fused fma for the error terms.
+ */
+namespace jtx::inline JTX_SIMD_ABI {
+    namespace simd_detail {
+        // Lane-wise versions of the EFT helpers in math.hpp
+        template<int N>
+        struct SimdFloatEFT {
+            SimdFloat<N> v, err;
+
+            [[nodiscard]] inline SimdFloat<N> value() const { return v + err; }
+        };
+
+        template<int N>
+        inline SimdFloatEFT<N> twoProd(SimdFloat<N> a, SimdFloat<N> b) {
+            SimdFloat<N> ab = a * b;
+            return {ab, fma(a, b, -ab)};
+        }
+
+        template<int N>
+        inline SimdFloatEFT<N> twoSum(SimdFloat<N> a, SimdFloat<N> b) {
+            SimdFloat<N> s = a + b;
+            SimdFloat<N> delta = s - a;
+            return {s, (a - (s - delta)) + (b - delta)};
+        }
+
+        template<int N>
+        inline SimdFloatEFT<N> innerProd(SimdFloat<N> a, SimdFloat<N> b) {
+            return twoProd(a, b);
+        }
+
+        template<int N, typename... T>
+        inline SimdFloatEFT<N> innerProd(SimdFloat<N> a, SimdFloat<N> b, T... terms) {
+            SimdFloatEFT<N> ab = twoProd(a, b);
+            SimdFloatEFT<N> tp = innerProd(terms...);
+            SimdFloatEFT<N> sum = twoSum(ab.v, tp.v);
+            return {sum.v, ab.err + tp.err + sum.err};
+        }
+
+        template<int N>
+        inline SimdFloat<N> dop(SimdFloat<N> a, SimdFloat<N> b, SimdFloat<N> c, SimdFloat<N> d) {
+            SimdFloat<N> cd = c * d;
+            SimdFloat<N> alpha = fma(a, b, -cd);
+            SimdFloat<N> beta = fma(-c, d, cd);
+            return alpha + beta;
+        }
+    }// namespace simd_detail
+
+    template<int N>
+    struct SimdMat4 {
+        SimdFloat<N> m[4][4];
+
+        //region AoS <-> SoA
+        // Loads N consecutive matrices
+        static inline SimdMat4 load(const Mat4 *src) { return loadPartial(src, N); }
+
+        // Loads count <= N matrices, the remaining lanes are the identity so they stay invertible
+        static inline SimdMat4 loadPartial(const Mat4 *src, size_t count) {
+            alignas(64) float tmp[16][N];
+            for (size_t k = 0; k < static_cast<size_t>(N); ++k) {
+                for (int i = 0; i < 4; ++i) {
+                    for (int j = 0; j < 4; ++j) {
+                        tmp[4 * i + j][k] = k < count ? src[k].data[i][j] : (i == j ? 1.0f : 0.0f);
+                    }
+                }
+            }
+
+            SimdMat4 res;
+            for (int e = 0; e < 16; ++e) res.m[e / 4][e % 4] = SimdFloat<N>::load(tmp[e]);
+            return res;
+        }
+
+        inline void store(Mat4 *dst) const { storePartial(dst, N); }
+
+        // Stores the first count <= N matrices
+        inline void storePartial(Mat4 *dst, size_t count) const {
+            alignas(64) float tmp[16][N];
+            for (int e = 0; e < 16; ++e) m[e / 4][e % 4].store(tmp[e]);
+            for (size_t k = 0; k < count; ++k) {
+                for (int i = 0; i < 4; ++i) {
+                    for (int j = 0; j < 4; ++j) dst[k].data[i][j] = tmp[4 * i + j][k];
+                }
+            }
+        }
+        //endregion
+    };
+
+    namespace simd_detail {
+        // 2x2 minors of the top (s) and bottom (c) row pairs, same naming as Mat4::inverse
+        template<int N>
+        inline void minors(const SimdMat4<N> &mat, SimdFloat<N> s[6], SimdFloat<N> c[6]) {
+            const auto &d = mat.m;
+            s[0] = dop(d[0][0], d[1][1], d[1][0], d[0][1]);
+            s[1] = dop(d[0][0], d[1][2], d[1][0], d[0][2]);
+            s[2] = dop(d[0][0], d[1][3], d[1][0], d[0][3]);
+            s[3] = dop(d[0][1], d[1][2], d[1][1], d[0][2]);
+            s[4] = dop(d[0][1], d[1][3], d[1][1], d[0][3]);
+            s[5] = dop(d[0][2], d[1][3], d[1][2], d[0][3]);
+
+            c[0] = dop(d[2][0], d[3][1], d[3][0], d[2][1]);
+            c[1] = dop(d[2][0], d[3][2], d[3][0], d[2][2]);
+            c[2] = dop(d[2][0], d[3][3], d[3][0], d[2][3]);
+            c[3] = dop(d[2][1], d[3][2], d[3][1], d[2][2]);
+            c[4] = dop(d[2][1], d[3][3], d[3][1], d[2][3]);
+            c[5] = dop(d[2][2], d[3][3], d[3][2], d[2][3]);
+        }
+
+        template<int N>
+        inline SimdFloat<N> determinant(const SimdFloat<N> s[6], const SimdFloat<N> c[6]) {
+            return dop(s[0], c[5], s[1], c[4]) + dop(s[2], c[3], -s[3], c[2]) + dop(s[5], c[0], s[4], c[1]);
+        }
+    }// namespace simd_detail
+
+    template<int N>
+    inline SimdFloat<N> determinant(const SimdMat4<N> &mat) {
+        SimdFloat<N> s[6], c[6];
+        simd_detail::minors(mat, s, c);
+        return simd_detail::determinant(s, c);
+    }
+
+    /**
+     * Inverts every lane like Mat4::inverse(). Lanes with a zero determinant are filled with NaN and cleared in
+     * *invertible (if given), where Mat4::inverse() would return an empty optional
+     */
+    template<int N>
+    inline SimdMat4<N> inverse(const SimdMat4<N> &mat, SimdMask<N> *invertible = nullptr) {
+        using F = SimdFloat<N>;
+        using simd_detail::innerProd;
+
+        F s[6], c[6];
+        simd_detail::minors(mat, s, c);
+        F det = simd_detail::determinant(s, c);
+        auto singular = det == F(0.0f);
+        if (invertible) *invertible = ~singular;
+
+        F invDet = select(singular, F(JTX_NAN_F), F(1.0f) / det);
+        const auto &d = mat.m;
+        SimdMat4<N> res;
+        res.m[0][0] = invDet * innerProd(d[1][1], c[5], d[1][3], c[3], -d[1][2], c[4]).value();
+        res.m[0][1] = invDet * innerProd(-d[0][1], c[5], d[0][2], c[4], -d[0][3], c[3]).value();
+        res.m[0][2] = invDet * innerProd(d[3][1], s[5], d[3][3], s[3], -d[3][2], s[4]).value();
+        res.m[0][3] = invDet * innerProd(-d[2][1], s[5], d[2][2], s[4], -d[2][3], s[3]).value();
+        res.m[1][0] = invDet * innerProd(-d[1][0], c[5], d[1][2], c[2], -d[1][3], c[1]).value();
+        res.m[1][1] = invDet * innerProd(d[0][0], c[5], d[0][3], c[1], -d[0][2], c[2]).value();
+        res.m[1][2] = invDet * innerProd(-d[3][0], s[5], d[3][2], s[2], -d[3][3], s[1]).value();
+        res.m[1][3] = invDet * innerProd(d[2][0], s[5], d[2][3], s[1], -d[2][2], s[2]).value();
+        res.m[2][0] = invDet * innerProd(d[1][0], c[4], d[1][3], c[0], -d[1][1], c[2]).value();
+        res.m[2][1] = invDet * innerProd(-d[0][0], c[4], d[0][1], c[2], -d[0][3], c[0]).value();
+        res.m[2][2] = invDet * innerProd(d[3][0], s[4], d[3][3], s[0], -d[3][1], s[2]).value();
+        res.m[2][3] = invDet * innerProd(-d[2][0], s[4], d[2][1], s[2], -d[2][3], s[0]).value();
+        res.m[3][0] = invDet * innerProd(-d[1][0], c[3], d[1][1], c[1], -d[1][2], c[0]).value();
+        res.m[3][1] = invDet * innerProd(d[0][0], c[3], d[0][2], c[0], -d[0][1], c[1]).value();
+        res.m[3][2] = invDet * innerProd(-d[3][0], s[3], d[3][1], s[1], -d[3][2], s[0]).value();
+        res.m[3][3] = invDet * innerProd(d[2][0], s[3], d[2][2], s[0], -d[2][1], s[1]).value();
+        return res;
+    }
+
+    // a * b for every lane, with the compensated inner products of Mat4::mul
+    template<int N>
+    inline SimdMat4<N> mul(const SimdMat4<N> &a, const SimdMat4<N> &b) {
+        SimdMat4<N> res;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                res.m[i][j] = simd_detail::innerProd(a.m[i][0], b.m[0][j], a.m[i][1], b.m[1][j],
+                                                     a.m[i][2], b.m[2][j], a.m[i][3], b.m[3][j]).value();
+            }
+        }
+        return res;
+    }
+}// namespace jtx
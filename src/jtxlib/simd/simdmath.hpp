@@ -0,0 +1,303 @@
+#pragma once
+
+#include "simdfloat.hpp"
+#include "../math/constants.hpp"
+
+/**
+ * Vectorized transcendental functions for SimdFloat<N>
+ *
+ * Cephes-style single-precision approximations: Cody-Waite range reduction followed by a minimax
+ * polynomial evaluated with FMAs. Every lane takes the same path, so there are no per-lane branches and
+ * the results are identical for every backend (as long as fma is fused on all of them).
+ *
+ * Max errors are measured against the double-precision libm result rounded to float:
+ *  - exp:   1 ULP                     (denormal results are within 1 ULP of the denormal spacing)
+ *  - log:   1 ULP
+ *  - sin:   2 ULP for |x| <= 8192, 3 ULP for |x| <= 1e7 (larger arguments are not reduced correctly)
+ *           Without a fused fma (SimdFloat::fusedFma, e.g. AVX2 builds without -mfma) the reduction loses
+ *           bits near multiples of pi/2: 2 ULP for |x| <= 4, 14 ULP for |x| <= 100, 256 ULP for |x| <= 8192
+ *  - cos:   same as sin
+ *  - acos:  1 ULP
+ *  - asin:  2 ULP
+ *  - atan2: 3 ULP
+ *  - pow:   1 + 3 * |y * log(x)| ULP, the error of log(x) is scaled by y (e.g. 73 ULP for results ~1e21)
+ *
+ * IEEE special values (NaN, +-inf, +-0) follow the C library.
+ */
+namespace jtx::inline JTX_SIMD_ABI {
+    /**
+     * Horner evaluation of c0 + c1 * t + c2 * t^2 + ..., same coefficient order as the scalar
+     * evalPolynomial in math.hpp
+     */
+    template<int N, typename... Coeffs>
+    inline SimdFloat<N> evalPolynomial(SimdFloat<N> t, float c, Coeffs... coeffs) {
+        if constexpr (sizeof...(Coeffs) == 0) {
+            return SimdFloat<N>(c);
+        } else {
+            return fma(t, evalPolynomial(t, static_cast<float>(coeffs)...), SimdFloat<N>(c));
+        }
+    }
+
+    // Horner evaluation with the coefficients in an array, e.g. a constexpr table shared with the scalar code
+    template<int N, size_t K>
+    inline SimdFloat<N> evalPolynomial(SimdFloat<N> t, const float (&c)[K]) {
+        SimdFloat<N> r(c[K - 1]);
+        for (size_t i = K - 1; i-- > 0;) r = fma(t, r, SimdFloat<N>(c[i]));
+        return r;
+    }
+
+    namespace simd_detail {
+        // Lane-wise jtx::detail::estrin
+        template<int N, size_t K>
+        inline SimdFloat<N> estrin(SimdFloat<N> t, const SimdFloat<N> (&c)[K]) {
+            if constexpr (K == 1) {
+                return c[0];
+            } else {
+                SimdFloat<N> pairs[(K + 1) / 2];
+                for (size_t i = 0; i < K / 2; ++i) pairs[i] = fma(t, c[2 * i + 1], c[2 * i]);
+                if constexpr (K % 2 == 1) pairs[K / 2] = c[K - 1];
+                return estrin(t * t, pairs);
+            }
+        }
+    }// namespace simd_detail
+
+    // Estrin evaluation, same coefficient order and rounding as the scalar evalPolynomialEstrin
+    template<int N, typename... Coeffs>
+    inline SimdFloat<N> evalPolynomialEstrin(SimdFloat<N> t, float c, Coeffs... coeffs) {
+        const SimdFloat<N> all[] = {SimdFloat<N>(c), SimdFloat<N>(static_cast<float>(coeffs))...};
+        return simd_detail::estrin(t, all);
+    }
+
+    template<int N, size_t K>
+    inline SimdFloat<N> evalPolynomialEstrin(SimdFloat<N> t, const float (&c)[K]) {
+        SimdFloat<N> coeffs[K];
+        for (size_t i = 0; i < K; ++i) coeffs[i] = SimdFloat<N>(c[i]);
+        return simd_detail::estrin(t, coeffs);
+    }
+
+    namespace simd_detail {
+        template<int N>
+        inline SimdMask<N> isNaN(SimdFloat<N> x) { return x != x; }
+
+        // Sign bit of x as an integer mask (0 or 0x80000000)
+        template<int N>
+        inline SimdInt<N> signBit(SimdFloat<N> x) { return asInt(x) & SimdInt<N>(static_cast<int32_t>(0x80000000u)); }
+
+        // Flips the sign of x where the sign bit of s is set
+        template<int N>
+        inline SimdFloat<N> flipSign(SimdFloat<N> x, SimdInt<N> s) { return asFloat(asInt(x) ^ s); }
+
+        // acos/asin core, returns asin(|x|) split as (p, big) where
+        // big lanes: asin(|x|) = pi/2 - 2 * p, other lanes: asin(|x|) = p
+        template<int N>
+        inline SimdFloat<N> asinCore(SimdFloat<N> ax, SimdMask<N> big) {
+            using F = SimdFloat<N>;
+            F zBig = F(0.5f) * (F(1.0f) - ax);
+            F z = select(big, zBig, ax * ax);
+            F a = select(big, sqrt(zBig), ax);
+            F p = evalPolynomial(z, 1.6666752422e-1f, 7.4953002686e-2f, 4.5470025998e-2f, 2.4181311049e-2f,
+                                 4.2163199048e-2f);
+            return fma(a * z, p, a);
+        }
+    }// namespace simd_detail
+
+    //region Exponential and logarithm
+    template<int N>
+    inline SimdFloat<N> exp(SimdFloat<N> x) {
+        using F = SimdFloat<N>;
+        using I = SimdInt<N>;
+
+        // Beyond these bounds the result is 0 or inf anyway, clamping keeps the integer exponent in range
+        F xc = min(max(x, F(-104.0f)), F(89.0f));
+
+        // x = n * ln2 + r, |r| <= ln2 / 2
+        F n = round(xc * F(1.44269504088896341f));
+        F r = fma(n, F(-0.693359375f), xc);
+        r = fma(n, F(2.12194440e-4f), r);
+
+        F r2 = r * r;
+        F p = evalPolynomial(r, 5.0000001201e-1f, 1.6666665459e-1f, 4.1665795894e-2f, 8.3334519073e-3f,
+                             1.3981999507e-3f, 1.9875691500e-4f);
+        F y = fma(r2, p, r + F(1.0f));
+
+        // Scale by 2^n in two steps so results that over/underflow (including denormals) come out right
+        I ni = toInt(n);
+        I n1 = ni >> 1;
+        I n2 = ni - n1;
+        y = y * asFloat((n1 + I(127)) << 23);
+        y = y * asFloat((n2 + I(127)) << 23);
+        return select(simd_detail::isNaN(x), x, y);
+    }
+
+    template<int N>
+    inline SimdFloat<N> log(SimdFloat<N> x) {
+        using F = SimdFloat<N>;
+        using I = SimdInt<N>;
+
+        // Normalize denormals first so the exponent can be read from the bits
+        auto denormal = x < F(JTX_MIN_NORMAL_F);
+        F xn = select(denormal, x * F(8388608.0f), x);
+        I bits = asInt(xn);
+        I e = ((bits >> 23) & I(0xFF)) - select(denormal, I(126 + 23), I(126));
+
+        // x = m * 2^e with m in [sqrt(1/2), sqrt(2))
+        F m = asFloat((bits & I(0x007FFFFF)) | I(0x3F000000));
+        auto small = m < F(0.707106781186547524f);
+        e = e - select(small, I(1), I(0));
+        m = select(small, m + m, m) - F(1.0f);
+        F ef = toFloat(e);
+
+        F z = m * m;
+        F p = evalPolynomial(m, 3.3333331174e-1f, -2.4999993993e-1f, 2.0000714765e-1f, -1.6668057665e-1f,
+                             1.4249322787e-1f, -1.2420140846e-1f, 1.1676998740e-1f, -1.1514610310e-1f,
+                             7.0376836292e-2f);
+        F y = m * z * p;
+        y = fma(ef, F(-2.12194440e-4f), y);
+        y = fma(z, F(-0.5f), y);
+        F r = fma(ef, F(0.693359375f), m + y);
+
+        r = select(x == F(JTX_INFINITY_F), x, r);
+        r = select(x == F(0.0f), F(JTX_NEG_INFINITY_F), r);
+        return select((x < F(0.0f)) | simd_detail::isNaN(x), F(JTX_NAN_F), r);
+    }
+
+    // x^y, computed as exp(y * log(x)) with the sign and special cases of std::pow
+    template<int N>
+    inline SimdFloat<N> pow(SimdFloat<N> x, SimdFloat<N> y) {
+        using F = SimdFloat<N>;
+        using I = SimdInt<N>;
+
+        F ax = abs(x);
+        F r = exp(y * log(ax));
+
+        // Negative bases only have a real result for integer exponents, odd ones flip the sign
+        auto negative = x < F(0.0f);
+        auto integer = floor(y) == y;
+        auto big = abs(y) >= F(16777216.0f);// every float this large is even
+        I odd = (toInt(select(big, F(0.0f), y)) & I(1)) << 31;
+        r = select(negative & integer, simd_detail::flipSign(r, odd), r);
+        r = select(negative & ~integer & (ax != F(JTX_INFINITY_F)), F(JTX_NAN_F), r);
+
+        // pow(-0, odd y) keeps the sign of the zero
+        r = select(x == F(0.0f), simd_detail::flipSign(r, odd & simd_detail::signBit(x)), r);
+
+        auto one = (y == F(0.0f)) | (x == F(1.0f)) | ((x == F(-1.0f)) & (abs(y) == F(JTX_INFINITY_F)));
+        return select(one, F(1.0f), r);
+    }
+
+    template<int N>
+    inline SimdFloat<N> pow(SimdFloat<N> x, float y) { return pow(x, SimdFloat<N>(y)); }
+    //endregion
+
+    //region Trigonometric
+    /**
+     * sin and cos of the same argument, sharing the range reduction
+     * x = k * pi/2 + r with |r| <= pi/4, the quadrant k selects the polynomial and the sign
+     */
+    template<int N>
+    inline void sincos(SimdFloat<N> x, SimdFloat<N> *s, SimdFloat<N> *c) {
+        using F = SimdFloat<N>;
+        using I = SimdInt<N>;
+
+        F ax = abs(x);
+        I j = toInt(ax * F(1.27323954473516268f));
+        j = (j + I(1)) & I(~1);
+        F y = toFloat(j);
+
+        // Cody-Waite reduction. With a fused fma each product is exact, so pi/4 can be split into three
+        // full floats. Otherwise the Cephes split keeps the leading products exact for small y
+        F r;
+        if constexpr (F::fusedFma) {
+            r = fma(y, F(-0x1.921fb6p-1f), ax);
+            r = fma(y, F(0x1.777a5cp-26f), r);
+            r = fma(y, F(0x1.ee59dap-51f), r);
+        } else {
+            r = ax - y * F(0.78515625f);
+            r = r - y * F(2.4187564849853515625e-4f);
+            r = r - y * F(3.77489497744594108e-8f);
+        }
+
+        F z = r * r;
+        F ps = fma(r * z, evalPolynomial(z, -1.6666654611e-1f, 8.3321608736e-3f, -1.9515295891e-4f), r);
+        F pc = fma(z * z, evalPolynomial(z, 4.166664568298827e-2f, -1.388731625493765e-3f, 2.443315711809948e-5f),
+                   fma(z, F(-0.5f), F(1.0f)));
+
+        auto swap = (j & I(2)) != I(0);
+        F sinR = select(swap, pc, ps);
+        F cosR = select(swap, ps, pc);
+
+        I sinSign = ((j & I(4)) << 29) ^ simd_detail::signBit(x);
+        I cosSign = ((j + I(2)) & I(4)) << 29;
+
+        auto inf = ax == F(JTX_INFINITY_F);
+        F nan(JTX_NAN_F);
+        *s = select(inf, nan, simd_detail::flipSign(sinR, sinSign));
+        *c = select(inf, nan, simd_detail::flipSign(cosR, cosSign));
+    }
+
+    template<int N>
+    inline SimdFloat<N> sin(SimdFloat<N> x) {
+        SimdFloat<N> s, c;
+        sincos(x, &s, &c);
+        return s;
+    }
+
+    template<int N>
+    inline SimdFloat<N> cos(SimdFloat<N> x) {
+        SimdFloat<N> s, c;
+        sincos(x, &s, &c);
+        return c;
+    }
+
+    // NaN outside of [-1, 1]
+    template<int N>
+    inline SimdFloat<N> asin(SimdFloat<N> x) {
+        using F = SimdFloat<N>;
+        F ax = abs(x);
+        auto big = ax > F(0.5f);
+        F p = simd_detail::asinCore(ax, big);
+        F r = select(big, fma(p, F(-2.0f), F(JTX_PI_F / 2)), p);
+        return simd_detail::flipSign(r, simd_detail::signBit(x));
+    }
+
+    // NaN outside of [-1, 1]
+    template<int N>
+    inline SimdFloat<N> acos(SimdFloat<N> x) {
+        using F = SimdFloat<N>;
+        F ax = abs(x);
+        auto big = ax > F(0.5f);
+        F p = simd_detail::asinCore(ax, big);
+
+        // |x| > 0.5: acos(|x|) = 2 * p, mirrored for negative x
+        F rBig = p + p;
+        rBig = select(x < F(0.0f), F(JTX_PI_F) - rBig, rBig);
+        F rSmall = F(JTX_PI_F / 2) - simd_detail::flipSign(p, simd_detail::signBit(x));
+        return select(big, rBig, rSmall);
+    }
+
+    template<int N>
+    inline SimdFloat<N> atan2(SimdFloat<N> y, SimdFloat<N> x) {
+        using F = SimdFloat<N>;
+
+        F ax = abs(x), ay = abs(y);
+        F mn = min(ax, ay), mx = max(ax, ay);
+        F a = mn / mx;
+        a = select((ax == ay) & (ax == F(JTX_INFINITY_F)), F(1.0f), a);
+        a = select(mx == F(0.0f), F(0.0f), a);
+
+        // atan(a) for a in [0, 1], reduced to [0, tan(pi/8)] with atan(a) = pi/4 + atan((a - 1) / (a + 1))
+        auto reduce = a > F(0.4142135623730950f);
+        F t = select(reduce, (a - F(1.0f)) / (a + F(1.0f)), a);
+        F z = t * t;
+        F p = evalPolynomial(z, -3.33329491539e-1f, 1.99777106478e-1f, -1.38776856032e-1f, 8.05374449538e-2f);
+        F r = fma(t * z, p, t);
+        r = select(reduce, r + F(JTX_PI_F / 4), r);
+
+        // Unfold the octant: swap axes, then mirror for negative x (including -0), sign of y
+        r = select(ay > ax, F(JTX_PI_F / 2) - r, r);
+        r = select(simd_detail::signBit(x) != SimdInt<N>(0), F(JTX_PI_F) - r, r);
+        r = simd_detail::flipSign(r, simd_detail::signBit(y));
+        return select(simd_detail::isNaN(x) | simd_detail::isNaN(y), x + y, r);
+    }
+    //endregion
+}// namespace jtx
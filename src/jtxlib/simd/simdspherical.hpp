@@ -0,0 +1,140 @@
+#pragma once
+
+#include "../math/math.hpp"
+#include "simdmath.hpp"
+#include "simdvec.hpp"
+
+/**
+ * Lane-wise versions of the spherical mappings in math/spherical.hpp
+ *
+ * The branches of the scalar code become selects, so every lane takes the same path.
+ */
+namespace jtx::inline JTX_SIMD_ABI {
+    namespace simd_detail {
+        // |mag| with the sign of sgn, like CopySign
+        template<int N>
+        inline SimdFloat<N> copySign(SimdFloat<N> mag, SimdFloat<N> sgn) {
+            return asFloat((asInt(mag) & SimdInt<N>(0x7FFFFFFF)) | signBit(sgn));
+        }
+
+        // +-1 with the sign of x, like CopySign(1.0f, x)
+        template<int N>
+        inline SimdFloat<N> signOf(SimdFloat<N> x) { return asFloat(asInt(SimdFloat<N>(1.0f)) | signBit(x)); }
+
+        // Rounds non-negative values to nearest with ties away from zero, like jtx::round
+        template<int N>
+        inline SimdInt<N> roundHalfUp(SimdFloat<N> x) {
+            SimdFloat<N> t = floor(x);
+            return toInt(select(x - t >= SimdFloat<N>(0.5f), t + SimdFloat<N>(1.0f), t));
+        }
+    }// namespace simd_detail
+
+    //region Octahedral
+    /**
+     * Octahedral encoding of unit vectors into integers in [0, scale], same as OctahedralVecT with
+     * scale = the largest value of the storage type. Zero vectors map to the center instead of NaN
+     */
+    template<int N>
+    inline void encodeOctahedral(const SimdVec3f<N> &v, float scale, SimdInt<N> *x, SimdInt<N> *y) {
+        using F = SimdFloat<N>;
+        using simd_detail::signOf;
+
+        F l1 = abs(v.x) + abs(v.y) + abs(v.z);
+        l1 = select(l1 == F(0.0f), F(1.0f), l1);
+        F vx = v.x / l1, vy = v.y / l1, vz = v.z / l1;
+
+        auto lower = vz < F(0.0f);
+        F fx = select(lower, (F(1.0f) - abs(vy)) * signOf(vx), vx);
+        F fy = select(lower, (F(1.0f) - abs(vx)) * signOf(vy), vy);
+
+        auto quantize = [&](F f) {
+            F t = min(max((f + F(1.0f)) / F(2.0f), F(0.0f)), F(1.0f));
+            return simd_detail::roundHalfUp(t * F(scale));
+        };
+        *x = quantize(fx);
+        *y = quantize(fy);
+    }
+
+    template<int N>
+    inline SimdVec3f<N> decodeOctahedral(SimdInt<N> x, SimdInt<N> y, float scale) {
+        using F = SimdFloat<N>;
+        using simd_detail::signOf;
+
+        F vx = F(-1.0f) + F(2.0f) * (toFloat(x) / F(scale));
+        F vy = F(-1.0f) + F(2.0f) * (toFloat(y) / F(scale));
+        F vz = F(1.0f) - abs(vx) - abs(vy);
+
+        auto lower = vz < F(0.0f);
+        F fx = select(lower, (F(1.0f) - abs(vy)) * signOf(vx), vx);
+        F fy = select(lower, (F(1.0f) - abs(vx)) * signOf(vy), vy);
+        return Normalize(SimdVec3f<N>(fx, fy, vz));
+    }
+    //endregion
+
+    //region Square-Sphere
+    // Clarberg's equal-area mapping of [0, 1]^2 to the unit sphere, same as EqualAreaSquareToSphere
+    template<int N>
+    inline SimdVec3f<N> equalAreaSquareToSphere(SimdFloat<N> px, SimdFloat<N> py) {
+        using F = SimdFloat<N>;
+        using simd_detail::copySign;
+
+        F u = F(2.0f) * px - F(1.0f);
+        F v = F(2.0f) * py - F(1.0f);
+        F up = abs(u), vp = abs(v);
+
+        F signedDist = F(1.0f) - (up + vp);
+        F r = F(1.0f) - abs(signedDist);
+
+        F phi = select(r == F(0.0f), F(1.0f), (vp - up) / r + F(1.0f)) * F(JTX_PI_F / 4);
+        F sinPhi, cosPhi;
+        sincos(phi, &sinPhi, &cosPhi);
+
+        F scale = r * sqrt(max(F(2.0f) - r * r, F(0.0f)));
+        return {copySign(cosPhi, u) * scale, copySign(sinPhi, v) * scale, copySign(F(1.0f) - r * r, signedDist)};
+    }
+
+    // Inverse of equalAreaSquareToSphere, same as EqualAreaSphereToSquare
+    template<int N>
+    inline void equalAreaSphereToSquare(const SimdVec3f<N> &d, SimdFloat<N> *px, SimdFloat<N> *py) {
+        using F = SimdFloat<N>;
+        using simd_detail::copySign;
+
+        F x = abs(d.x), y = abs(d.y), z = abs(d.z);
+        F r = sqrt(max(F(1.0f) - z, F(0.0f)));
+        F a = max(x, y);
+        F b = min(x, y);
+        b = select(a == F(0.0f), F(0.0f), b / a);
+
+        // Same atan(b) * 2 / pi approximation as spherical.cpp
+        F phi = evalPolynomialEstrin(b, EQUAL_AREA_ATAN_COEFFS);
+        phi = select(x < y, F(1.0f) - phi, phi);
+        F v = phi * r;
+        F u = r - v;
+
+        auto lower = d.z < F(0.0f);
+        u = select(lower, F(1.0f) - u, u);
+        v = select(lower, F(1.0f) - v, v);
+
+        *px = F(0.5f) * (copySign(u, d.x) + F(1.0f));
+        *py = F(0.5f) * (copySign(v, d.y) + F(1.0f));
+    }
+
+    // Folds points outside [0, 1]^2 back in, same as WrapEqualAreaSquare
+    template<int N>
+    inline void wrapEqualAreaSquare(SimdFloat<N> *px, SimdFloat<N> *py) {
+        using F = SimdFloat<N>;
+        F x = *px, y = *py;
+
+        auto xLow = x < F(0.0f), xHigh = x > F(1.0f);
+        x = select(xLow, -x, select(xHigh, F(2.0f) - x, x));
+        y = select(xLow | xHigh, F(1.0f) - y, y);
+
+        auto yLow = y < F(0.0f), yHigh = y > F(1.0f);
+        x = select(yLow | yHigh, F(1.0f) - x, x);
+        y = select(yLow, -y, select(yHigh, F(2.0f) - y, y));
+
+        *px = x;
+        *py = y;
+    }
+    //endregion
+}// namespace jtx
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "simdfloat.hpp"
+#include "../math/mat4.hpp"
+
+namespace jtx::inline JTX_SIMD_ABI {
+    static_assert(sizeof(Vec3f) == 3 * sizeof(float) && sizeof(Vec4f) == 4 * sizeof(float),
+                  "AoS loads assume tightly packed vectors");
+
+    /**
+     * SimdVec3f and SimdVec4f are SoA structs for 3D and 4D vectors
+     * Each holds a SimdFloat<N> per component, meaning they hold N vectors at a time
+     */
+    template<int N>
+    struct SimdVec4f;
+
+    template<int N>
+    struct SimdVec3f {
+        SimdFloat<N> x, y, z;
+
+        SimdVec3f() = default;
+        SimdVec3f(SimdFloat<N> _x, SimdFloat<N> _y, SimdFloat<N> _z) : x(_x), y(_y), z(_z) {}
+
+        SimdVec3f(float v) : x(v), y(v), z(v) {}
+        SimdVec3f(SimdFloat<N> v) : x(v), y(v), z(v) {}
+        SimdVec3f(const SimdVec4f<N> &v) : x(v.x), y(v.y), z(v.z) {}
+
+        //region AoS <-> SoA
+        // Loads N consecutive vectors, e.g. from a jtx::vector<Vec3f>
+        static inline SimdVec3f load(const Vec3f *src) {
+            SimdVec3f v;
+            loadInterleaved3(reinterpret_cast<const float *>(src), &v.x, &v.y, &v.z);
+            return v;
+        }
+
+        // Loads count <= N vectors, the remaining lanes are 0. Never reads past src + count
+        static inline SimdVec3f loadPartial(const Vec3f *src, size_t count) {
+            if (count == N) return load(src);
+            Vec3f tmp[N];
+            for (size_t i = 0; i < count; ++i) tmp[i] = src[i];
+            return load(tmp);
+        }
+
+        /**
+         * Loads count <= N vectors that are stride bytes apart, e.g. the normals of an interleaved vertex
+         * buffer: loadStrided(&vertices[i].n, sizeof(Vertex)). The remaining lanes are 0
+         */
+        static inline SimdVec3f loadStrided(const void *base, size_t stride, size_t count = N) {
+            ASSERT(stride % sizeof(float) == 0);
+            alignas(64) int32_t lane[N];
+            for (int i = 0; i < N; ++i) lane[i] = i;
+            SimdInt<N> i = SimdInt<N>::load(lane);
+            auto mask = i < SimdInt<N>(static_cast<int32_t>(count));
+            SimdInt<N> idx = i * SimdInt<N>(static_cast<int32_t>(stride / sizeof(float)));
+
+            auto p = static_cast<const float *>(base);
+            return {gather(p, idx, mask), gather(p + 1, idx, mask), gather(p + 2, idx, mask)};
+        }
+
+        inline void store(Vec3f *dst) const { storeInterleaved3(reinterpret_cast<float *>(dst), x, y, z); }
+
+        // Stores the first count <= N vectors
+        inline void storePartial(Vec3f *dst, size_t count) const {
+            if (count == N) return store(dst);
+            Vec3f tmp[N];
+            store(tmp);
+            for (size_t i = 0; i < count; ++i) dst[i] = tmp[i];
+        }
+        //endregion
+
+        inline SimdFloat<N> LengthSquared() const { return fma(x, x, fma(y, y, z * z)); }
+        inline SimdFloat<N> Length() const { return sqrt(LengthSquared()); }
+
+        inline SimdVec3f &operator+=(const SimdVec3f &other) { return *this = *this + other; }
+        inline SimdVec3f &operator-=(const SimdVec3f &other) { return *this = *this - other; }
+        inline SimdVec3f &operator*=(const SimdVec3f &other) { return *this = *this * other; }
+        inline SimdVec3f &operator/=(const SimdVec3f &other) { return *this = *this / other; }
+
+        /**
+         * Same operations as vecmath.hpp offers for Vec3, applied to N vectors at once
+         * Scalars and SimdFloat<N> convert implicitly to a broadcast vector, so v * 2.0f and s * v work
+         */
+        //region Operators
+        friend inline SimdVec3f operator+(const SimdVec3f &a, const SimdVec3f &b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+        friend inline SimdVec3f operator-(const SimdVec3f &a, const SimdVec3f &b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+        friend inline SimdVec3f operator*(const SimdVec3f &a, const SimdVec3f &b) { return {a.x * b.x, a.y * b.y, a.z * b.z}; }
+        friend inline SimdVec3f operator/(const SimdVec3f &a, const SimdVec3f &b) { return {a.x / b.x, a.y / b.y, a.z / b.z}; }
+        friend inline SimdVec3f operator-(const SimdVec3f &a) { return {-a.x, -a.y, -a.z}; }
+
+        friend inline SimdVec3f select(SimdMask<N> mask, const SimdVec3f &a, const SimdVec3f &b) {
+            return {select(mask, a.x, b.x), select(mask, a.y, b.y), select(mask, a.z, b.z)};
+        }
+        //endregion
+
+        //region Geometric functions
+        friend inline SimdFloat<N> Dot(const SimdVec3f &a, const SimdVec3f &b) {
+            return fma(a.x, b.x, fma(a.y, b.y, a.z * b.z));
+        }
+
+        friend inline SimdFloat<N> AbsDot(const SimdVec3f &a, const SimdVec3f &b) { return abs(Dot(a, b)); }
+
+        friend inline SimdVec3f Cross(const SimdVec3f &a, const SimdVec3f &b) {
+            return {fms(a.y, b.z, a.z * b.y), fms(a.z, b.x, a.x * b.z), fms(a.x, b.y, a.y * b.x)};
+        }
+
+        // Zero-length vectors stay zero, like the scalar Normalize
+        friend inline SimdVec3f Normalize(const SimdVec3f &v) {
+            SimdFloat<N> l = v.Length();
+            return select(l != SimdFloat<N>(0.0f), v / SimdVec3f(l), SimdVec3f(0.0f));
+        }
+
+        friend inline SimdVec3f Abs(const SimdVec3f &v) { return {abs(v.x), abs(v.y), abs(v.z)}; }
+        friend inline SimdVec3f min(const SimdVec3f &a, const SimdVec3f &b) { return {min(a.x, b.x), min(a.y, b.y), min(a.z, b.z)}; }
+        friend inline SimdVec3f Max(const SimdVec3f &a, const SimdVec3f &b) { return {max(a.x, b.x), max(a.y, b.y), max(a.z, b.z)}; }
+
+        friend inline SimdVec3f Lerp(const SimdVec3f &a, const SimdVec3f &b, SimdFloat<N> t) {
+            return {fma(t, b.x - a.x, a.x), fma(t, b.y - a.y, a.y), fma(t, b.z - a.z, a.z)};
+        }
+
+        friend inline SimdVec3f reflect(const SimdVec3f &v, const SimdVec3f &n) {
+            return v - SimdVec3f(SimdFloat<N>(2.0f) * Dot(v, n)) * n;
+        }
+
+        friend inline SimdVec3f refract(const SimdVec3f &uv, const SimdVec3f &n, SimdFloat<N> etaiOverEtat) {
+            SimdFloat<N> cosTheta = min(Dot(-uv, n), SimdFloat<N>(1.0f));
+            SimdVec3f perp = SimdVec3f(etaiOverEtat) * (uv + SimdVec3f(cosTheta) * n);
+            SimdVec3f parallel = SimdVec3f(-sqrt(abs(SimdFloat<N>(1.0f) - perp.LengthSquared()))) * n;
+            return perp + parallel;
+        }
+
+        // Flips n to the hemisphere of v
+        friend inline SimdVec3f faceForward(const SimdVec3f &n, const SimdVec3f &v) {
+            return select(Dot(n, v) < SimdFloat<N>(0.0f), -n, n);
+        }
+
+        // Orthonormal basis around a normalized v1 (Duff et al. 2017), same as the scalar version
+        friend inline void coordinateSystem(const SimdVec3f &v1, SimdVec3f *v2, SimdVec3f *v3) {
+            using F = SimdFloat<N>;
+            using I = SimdInt<N>;
+            F sign = asFloat((asInt(v1.z) & I(static_cast<int32_t>(0x80000000u))) | asInt(F(1.0f)));
+            F a = F(-1.0f) / (sign + v1.z);
+            F b = v1.x * v1.y * a;
+            *v2 = {fma(sign * v1.x * v1.x, a, F(1.0f)), sign * b, -sign * v1.x};
+            *v3 = {b, fma(v1.y * v1.y, a, sign), -v1.y};
+        }
+        //endregion
+    };
+
+    template<int N>
+    struct SimdVec4f {
+        SimdFloat<N> x, y, z, w;
+
+        SimdVec4f() = default;
+        SimdVec4f(SimdFloat<N> _x, SimdFloat<N> _y, SimdFloat<N> _z, SimdFloat<N> _w) : x(_x), y(_y), z(_z), w(_w) {}
+        SimdVec4f(SimdVec3f<N> v, SimdFloat<N> _w) : x(v.x), y(v.y), z(v.z), w(_w) {}
+
+        SimdVec4f(float v) : x(v), y(v), z(v), w(v) {}
+        SimdVec4f(SimdFloat<N> v) : x(v), y(v), z(v), w(v) {}
+
+        //region AoS <-> SoA
+        // See SimdVec3f
+        static inline SimdVec4f load(const Vec4f *src) {
+            SimdVec4f v;
+            loadInterleaved4(reinterpret_cast<const float *>(src), &v.x, &v.y, &v.z, &v.w);
+            return v;
+        }
+
+        static inline SimdVec4f loadPartial(const Vec4f *src, size_t count) {
+            if (count == N) return load(src);
+            Vec4f tmp[N];
+            for (size_t i = 0; i < count; ++i) tmp[i] = src[i];
+            return load(tmp);
+        }
+
+        static inline SimdVec4f loadStrided(const void *base, size_t stride, size_t count = N) {
+            ASSERT(stride % sizeof(float) == 0);
+            alignas(64) int32_t lane[N];
+            for (int i = 0; i < N; ++i) lane[i] = i;
+            SimdInt<N> i = SimdInt<N>::load(lane);
+            auto mask = i < SimdInt<N>(static_cast<int32_t>(count));
+            SimdInt<N> idx = i * SimdInt<N>(static_cast<int32_t>(stride / sizeof(float)));
+
+            auto p = static_cast<const float *>(base);
+            return {gather(p, idx, mask), gather(p + 1, idx, mask), gather(p + 2, idx, mask), gather(p + 3, idx, mask)};
+        }
+
+        inline void store(Vec4f *dst) const { storeInterleaved4(reinterpret_cast<float *>(dst), x, y, z, w); }
+
+        inline void storePartial(Vec4f *dst, size_t count) const {
+            if (count == N) return store(dst);
+            Vec4f tmp[N];
+            store(tmp);
+            for (size_t i = 0; i < count; ++i) dst[i] = tmp[i];
+        }
+        //endregion
+    };
+
+    template<int N>
+    inline SimdVec4f<N> transformVec(const SimdVec4f<N> &v, const jtx::Mat4 &m) {
+        using F = SimdFloat<N>;
+        F x = F(m.data[0][0]) * v.x + F(m.data[0][1]) * v.y + F(m.data[0][2]) * v.z + F(m.data[0][3]) * v.w;
+        F y = F(m.data[1][0]) * v.x + F(m.data[1][1]) * v.y + F(m.data[1][2]) * v.z + F(m.data[1][3]) * v.w;
+        F z = F(m.data[2][0]) * v.x + F(m.data[2][1]) * v.y + F(m.data[2][2]) * v.z + F(m.data[2][3]) * v.w;
+        F w = F(m.data[3][0]) * v.x + F(m.data[3][1]) * v.y + F(m.data[3][2]) * v.z + F(m.data[3][3]) * v.w;
+        return {x, y, z, w};
+    }
+
+    template<int N>
+    inline SimdVec3f<N> transformNormal(const SimdVec3f<N> &v, const jtx::Mat4 &m) {
+        using F = SimdFloat<N>;
+        F x = F(m.data[0][0]) * v.x + F(m.data[0][1]) * v.y + F(m.data[0][2]) * v.z;
+        F y = F(m.data[1][0]) * v.x + F(m.data[1][1]) * v.y + F(m.data[1][2]) * v.z;
+        F z = F(m.data[2][0]) * v.x + F(m.data[2][1]) * v.y + F(m.data[2][2]) * v.z;
+        return {x, y, z};
+    }
+}// namespace jtx
@@ -0,0 +1,332 @@
+/**
+ * SSE4.1 backend for the 4-wide SIMD types, included by simdfloat.hpp
+ */
+#pragma once
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "portability-simd-intrinsics"
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "google-explicit-constructor"
+
+#include <immintrin.h>
+
+namespace jtx::inline JTX_SIMD_ABI {
+    template<>
+    struct SimdMask<4> {
+        static constexpr size_t size = 4;
+
+        __m128 data;
+
+        // Sets all lanes to false
+        SimdMask() : data(_mm_setzero_ps()) {}
+        SimdMask(__m128 data) : data(data) {}
+        SimdMask(__m128i data) : data(_mm_castsi128_ps(data)) {}
+        SimdMask(bool val) : data(val ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : _mm_setzero_ps()) {}
+
+        // One bit per lane, lane 0 is the least significant bit
+        [[nodiscard]] inline int movemask() const { return _mm_movemask_ps(data); }
+
+        [[nodiscard]] inline bool any() const { return movemask() != 0; }
+        [[nodiscard]] inline bool all() const { return movemask() == 0xF; }
+        [[nodiscard]] inline bool none() const { return movemask() == 0; }
+
+        inline bool operator[](size_t i) const { return (movemask() >> i) & 1; }
+
+        inline operator __m128() const { return data; }
+
+        friend inline SimdMask operator&(SimdMask a, SimdMask b) { return _mm_and_ps(a, b); }
+        friend inline SimdMask operator|(SimdMask a, SimdMask b) { return _mm_or_ps(a, b); }
+        friend inline SimdMask operator^(SimdMask a, SimdMask b) { return _mm_xor_ps(a, b); }
+        friend inline SimdMask operator~(SimdMask a) { return _mm_xor_ps(a, SimdMask(true)); }
+    };
+
+    template<>
+    struct SimdInt<4> {
+        static constexpr size_t size = 4;
+
+        __m128i data;
+
+        // Sets all lanes to 0
+        SimdInt() : data(_mm_setzero_si128()) {}
+        SimdInt(__m128i data) : data(data) {}
+        SimdInt(int32_t val) : data(_mm_set1_epi32(val)) {}
+
+        inline int32_t &operator[](size_t i) { return reinterpret_cast<int32_t *>(&data)[i]; }
+        inline const int32_t &operator[](size_t i) const { return reinterpret_cast<const int32_t *>(&data)[i]; }
+
+        static inline SimdInt load(const int32_t *ptr) { return _mm_load_si128(reinterpret_cast<const __m128i *>(ptr)); }
+        static inline SimdInt loadu(const int32_t *ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)); }
+        inline void store(int32_t *ptr) const { _mm_store_si128(reinterpret_cast<__m128i *>(ptr), data); }
+        inline void storeu(int32_t *ptr) const { _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), data); }
+
+        inline operator __m128i() const { return data; }
+
+        inline SimdInt &operator+=(SimdInt other) { return *this = *this + other; }
+        inline SimdInt &operator-=(SimdInt other) { return *this = *this - other; }
+        inline SimdInt &operator*=(SimdInt other) { return *this = *this * other; }
+        inline SimdInt &operator&=(SimdInt other) { return *this = *this & other; }
+        inline SimdInt &operator|=(SimdInt other) { return *this = *this | other; }
+        inline SimdInt &operator^=(SimdInt other) { return *this = *this ^ other; }
+        inline SimdInt &operator<<=(int n) { return *this = *this << n; }
+        inline SimdInt &operator>>=(int n) { return *this = *this >> n; }
+
+        friend inline SimdInt operator+(SimdInt a, SimdInt b) { return _mm_add_epi32(a, b); }
+        friend inline SimdInt operator-(SimdInt a, SimdInt b) { return _mm_sub_epi32(a, b); }
+        friend inline SimdInt operator*(SimdInt a, SimdInt b) { return _mm_mullo_epi32(a, b); }
+        friend inline SimdInt operator-(SimdInt a) { return _mm_sub_epi32(_mm_setzero_si128(), a); }
+
+        friend inline SimdInt operator&(SimdInt a, SimdInt b) { return _mm_and_si128(a, b); }
+        friend inline SimdInt operator|(SimdInt a, SimdInt b) { return _mm_or_si128(a, b); }
+        friend inline SimdInt operator^(SimdInt a, SimdInt b) { return _mm_xor_si128(a, b); }
+        friend inline SimdInt operator~(SimdInt a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+
+        friend inline SimdInt operator<<(SimdInt a, int n) { return _mm_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+        // Arithmetic (sign-extending) shift
+        friend inline SimdInt operator>>(SimdInt a, int n) { return _mm_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+        // Logical (zero-filling) shift
+        friend inline SimdInt shiftRightLogical(SimdInt a, int n) { return _mm_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+
+        // Per-lane shift amounts, amounts >= 32 give 0 (or the sign for arithmetic shifts)
+#ifdef __AVX2__
+        friend inline SimdInt operator<<(SimdInt a, SimdInt n) { return _mm_sllv_epi32(a, n); }
+        friend inline SimdInt operator>>(SimdInt a, SimdInt n) { return _mm_srav_epi32(a, n); }
+        friend inline SimdInt shiftRightLogical(SimdInt a, SimdInt n) { return _mm_srlv_epi32(a, n); }
+#else
+        // Goes through memory rather than operator[], writing lanes through a pointer into data breaks strict
+        // aliasing and gets miscompiled at -O3
+        template<typename F>
+        static inline SimdInt shiftLanes(SimdInt a, SimdInt n, F f) {
+            alignas(16) int32_t x[4], s[4];
+            a.store(x);
+            n.store(s);
+            for (size_t i = 0; i < size; ++i) x[i] = f(x[i], s[i]);
+            return load(x);
+        }
+
+        friend inline SimdInt operator<<(SimdInt a, SimdInt n) {
+            return shiftLanes(a, n, [](int32_t x, int32_t s) { return uint32_t(s) < 32 ? int32_t(uint32_t(x) << s) : 0; });
+        }
+
+        friend inline SimdInt operator>>(SimdInt a, SimdInt n) {
+            return shiftLanes(a, n, [](int32_t x, int32_t s) { return x >> (uint32_t(s) < 32 ? s : 31); });
+        }
+
+        friend inline SimdInt shiftRightLogical(SimdInt a, SimdInt n) {
+            return shiftLanes(a, n, [](int32_t x, int32_t s) { return uint32_t(s) < 32 ? int32_t(uint32_t(x) >> s) : 0; });
+        }
+#endif
+
+        // ~a & b
+        friend inline SimdInt andnot(SimdInt a, SimdInt b) { return _mm_andnot_si128(a, b); }
+
+        friend inline SimdMask<4> operator==(SimdInt a, SimdInt b) { return _mm_cmpeq_epi32(a, b); }
+        friend inline SimdMask<4> operator!=(SimdInt a, SimdInt b) { return ~(a == b); }
+        friend inline SimdMask<4> operator<(SimdInt a, SimdInt b) { return _mm_cmplt_epi32(a, b); }
+        friend inline SimdMask<4> operator>(SimdInt a, SimdInt b) { return _mm_cmpgt_epi32(a, b); }
+        friend inline SimdMask<4> operator<=(SimdInt a, SimdInt b) { return ~(a > b); }
+        friend inline SimdMask<4> operator>=(SimdInt a, SimdInt b) { return ~(a < b); }
+
+        friend inline SimdInt min(SimdInt a, SimdInt b) { return _mm_min_epi32(a, b); }
+        friend inline SimdInt max(SimdInt a, SimdInt b) { return _mm_max_epi32(a, b); }
+
+        // Picks a where mask is set, b otherwise
+        friend inline SimdInt select(SimdMask<4> mask, SimdInt a, SimdInt b) {
+            return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(b), _mm_castsi128_ps(a), mask));
+        }
+    };
+
+    template<>
+    struct SimdFloat<4> {
+        static constexpr size_t size = 4;
+#ifdef __FMA__
+        static constexpr bool fusedFma = true;
+#else
+        static constexpr bool fusedFma = false;
+#endif
+
+        __m128 data;
+
+        // Sets all lanes to 0
+        SimdFloat() : data(_mm_setzero_ps()) {}
+        SimdFloat(__m128 data) : data(data) {}
+        SimdFloat(float val) : data(_mm_set1_ps(val)) {}
+
+        inline float &operator[](size_t i) { return reinterpret_cast<float *>(&data)[i]; }
+        inline const float &operator[](size_t i) const { return reinterpret_cast<const float *>(&data)[i]; }
+
+        static inline SimdFloat load(const float *ptr) { return _mm_load_ps(ptr); }
+        static inline SimdFloat loadu(const float *ptr) { return _mm_loadu_ps(ptr); }
+        inline void store(float *ptr) const { _mm_store_ps(ptr, data); }
+        inline void storeu(float *ptr) const { _mm_storeu_ps(ptr, data); }
+
+        inline operator __m128() const { return data; }
+
+        inline SimdFloat &operator+=(SimdFloat other) { return *this = *this + other; }
+        inline SimdFloat &operator-=(SimdFloat other) { return *this = *this - other; }
+        inline SimdFloat &operator*=(SimdFloat other) { return *this = *this * other; }
+        inline SimdFloat &operator/=(SimdFloat other) { return *this = *this / other; }
+
+        //region Operators
+        friend inline SimdFloat operator+(SimdFloat a, SimdFloat b) { return _mm_add_ps(a, b); }
+        friend inline SimdFloat operator-(SimdFloat a, SimdFloat b) { return _mm_sub_ps(a, b); }
+        friend inline SimdFloat operator*(SimdFloat a, SimdFloat b) { return _mm_mul_ps(a, b); }
+        friend inline SimdFloat operator/(SimdFloat a, SimdFloat b) { return _mm_div_ps(a, b); }
+        friend inline SimdFloat operator-(SimdFloat a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+        friend inline SimdMask<4> operator==(SimdFloat a, SimdFloat b) { return _mm_cmpeq_ps(a, b); }
+        friend inline SimdMask<4> operator!=(SimdFloat a, SimdFloat b) { return _mm_cmpneq_ps(a, b); }
+        friend inline SimdMask<4> operator<(SimdFloat a, SimdFloat b) { return _mm_cmplt_ps(a, b); }
+        friend inline SimdMask<4> operator<=(SimdFloat a, SimdFloat b) { return _mm_cmple_ps(a, b); }
+        friend inline SimdMask<4> operator>(SimdFloat a, SimdFloat b) { return _mm_cmpgt_ps(a, b); }
+        friend inline SimdMask<4> operator>=(SimdFloat a, SimdFloat b) { return _mm_cmpge_ps(a, b); }
+        //endregion
+
+        //region Functions
+        // Picks a where mask is set, b otherwise
+        friend inline SimdFloat select(SimdMask<4> mask, SimdFloat a, SimdFloat b) { return _mm_blendv_ps(b, a, mask); }
+
+        // a * b + c, fused when compiled with FMA support
+        friend inline SimdFloat fma(SimdFloat a, SimdFloat b, SimdFloat c) {
+#ifdef __FMA__
+            return _mm_fmadd_ps(a, b, c);
+#else
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+        }
+
+        // a * b - c, fused when compiled with FMA support
+        friend inline SimdFloat fms(SimdFloat a, SimdFloat b, SimdFloat c) {
+#ifdef __FMA__
+            return _mm_fmsub_ps(a, b, c);
+#else
+            return _mm_sub_ps(_mm_mul_ps(a, b), c);
+#endif
+        }
+
+        friend inline SimdFloat min(SimdFloat a, SimdFloat b) { return _mm_min_ps(a, b); }
+        friend inline SimdFloat max(SimdFloat a, SimdFloat b) { return _mm_max_ps(a, b); }
+        friend inline SimdFloat abs(SimdFloat a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+        friend inline SimdFloat floor(SimdFloat a) { return _mm_round_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+        friend inline SimdFloat ceil(SimdFloat a) { return _mm_round_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+        // Rounds to the nearest integer, ties to even
+        friend inline SimdFloat round(SimdFloat a) { return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        friend inline SimdFloat sqrt(SimdFloat a) { return _mm_sqrt_ps(a); }
+        friend inline SimdFloat rcpEstimate(SimdFloat a) { return _mm_rcp_ps(a); }
+        friend inline SimdFloat rsqrtEstimate(SimdFloat a) { return _mm_rsqrt_ps(a); }
+        //endregion
+    };
+
+    inline SimdFloat<4> toFloat(SimdInt<4> a) { return _mm_cvtepi32_ps(a); }
+    inline SimdInt<4> toInt(SimdFloat<4> a) { return _mm_cvttps_epi32(a); }
+    inline SimdFloat<4> asFloat(SimdInt<4> a) { return _mm_castsi128_ps(a); }
+    inline SimdInt<4> asInt(SimdFloat<4> a) { return _mm_castps_si128(a); }
+    inline SimdInt<4> roundToInt(SimdFloat<4> a) { return _mm_cvtps_epi32(a); }
+
+#ifdef __AVX2__
+    inline SimdFloat<4> gather(const float *base, SimdInt<4> idx) { return _mm_i32gather_ps(base, idx, 4); }
+
+    inline SimdFloat<4> gather(const float *base, SimdInt<4> idx, SimdMask<4> mask, SimdFloat<4> src = SimdFloat<4>()) {
+        return _mm_mask_i32gather_ps(src, base, idx, mask, 4);
+    }
+
+    inline SimdInt<4> gather(const int32_t *base, SimdInt<4> idx) {
+        return _mm_i32gather_epi32(reinterpret_cast<const int *>(base), idx, 4);
+    }
+
+    inline SimdInt<4> gather(const int32_t *base, SimdInt<4> idx, SimdMask<4> mask, SimdInt<4> src = SimdInt<4>()) {
+        return _mm_mask_i32gather_epi32(src, reinterpret_cast<const int *>(base), idx, _mm_castps_si128(mask), 4);
+    }
+#else
+    // Lanes go through aligned arrays, see SimdInt<4>::shiftLanes. Inactive lanes never touch base
+    inline SimdFloat<4> gather(const float *base, SimdInt<4> idx) {
+        alignas(16) int32_t i[4];
+        idx.store(i);
+        return _mm_setr_ps(base[i[0]], base[i[1]], base[i[2]], base[i[3]]);
+    }
+
+    inline SimdFloat<4> gather(const float *base, SimdInt<4> idx, SimdMask<4> mask, SimdFloat<4> src = SimdFloat<4>()) {
+        alignas(16) int32_t i[4];
+        alignas(16) float r[4];
+        idx.store(i);
+        src.store(r);
+        int m = mask.movemask();
+        for (int k = 0; k < 4; ++k) {
+            if ((m >> k) & 1) r[k] = base[i[k]];
+        }
+        return SimdFloat<4>::load(r);
+    }
+
+    inline SimdInt<4> gather(const int32_t *base, SimdInt<4> idx) {
+        alignas(16) int32_t i[4];
+        idx.store(i);
+        return _mm_setr_epi32(base[i[0]], base[i[1]], base[i[2]], base[i[3]]);
+    }
+
+    inline SimdInt<4> gather(const int32_t *base, SimdInt<4> idx, SimdMask<4> mask, SimdInt<4> src = SimdInt<4>()) {
+        alignas(16) int32_t i[4], r[4];
+        idx.store(i);
+        src.store(r);
+        int m = mask.movemask();
+        for (int k = 0; k < 4; ++k) {
+            if ((m >> k) & 1) r[k] = base[i[k]];
+        }
+        return SimdInt<4>::load(r);
+    }
+#endif
+
+    inline void loadInterleaved3(const float *src, SimdFloat<4> *x, SimdFloat<4> *y, SimdFloat<4> *z) {
+        __m128 a = _mm_loadu_ps(src);    // x0 y0 z0 x1
+        __m128 b = _mm_loadu_ps(src + 4);// y1 z1 x2 y2
+        __m128 c = _mm_loadu_ps(src + 8);// z2 x3 y3 z3
+
+        __m128 t = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+        *x = _mm_shuffle_ps(a, t, _MM_SHUFFLE(2, 0, 3, 0));
+
+        __m128 u = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+        __m128 v = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+        *y = _mm_shuffle_ps(u, v, _MM_SHUFFLE(2, 0, 2, 0));
+
+        u = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+        v = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+        *z = _mm_shuffle_ps(u, v, _MM_SHUFFLE(2, 0, 2, 0));
+    }
+
+    inline void storeInterleaved3(float *dst, SimdFloat<4> x, SimdFloat<4> y, SimdFloat<4> z) {
+        __m128 p = _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 0, 1, 0));// x0 x1 y0 y1
+        __m128 q = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 2, 1, 0));// z0 z1 x2 x3
+        __m128 r = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 2, 3, 2));// y2 y3 z2 z3
+
+        __m128 s = _mm_shuffle_ps(q, p, _MM_SHUFFLE(1, 1, 0, 0));
+        _mm_storeu_ps(dst, _mm_shuffle_ps(p, s, _MM_SHUFFLE(2, 0, 2, 0)));
+
+        __m128 s1 = _mm_shuffle_ps(p, q, _MM_SHUFFLE(1, 1, 3, 3));
+        __m128 s2 = _mm_shuffle_ps(q, r, _MM_SHUFFLE(0, 0, 2, 2));
+        _mm_storeu_ps(dst + 4, _mm_shuffle_ps(s1, s2, _MM_SHUFFLE(2, 0, 2, 0)));
+
+        s = _mm_shuffle_ps(r, q, _MM_SHUFFLE(3, 3, 2, 2));
+        _mm_storeu_ps(dst + 8, _mm_shuffle_ps(s, r, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+
+    inline void loadInterleaved4(const float *src, SimdFloat<4> *x, SimdFloat<4> *y, SimdFloat<4> *z, SimdFloat<4> *w) {
+        __m128 r0 = _mm_loadu_ps(src), r1 = _mm_loadu_ps(src + 4);
+        __m128 r2 = _mm_loadu_ps(src + 8), r3 = _mm_loadu_ps(src + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        *x = r0;
+        *y = r1;
+        *z = r2;
+        *w = r3;
+    }
+
+    inline void storeInterleaved4(float *dst, SimdFloat<4> x, SimdFloat<4> y, SimdFloat<4> z, SimdFloat<4> w) {
+        __m128 r0 = x, r1 = y, r2 = z, r3 = w;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(dst, r0);
+        _mm_storeu_ps(dst + 4, r1);
+        _mm_storeu_ps(dst + 8, r2);
+        _mm_storeu_ps(dst + 12, r3);
+    }
+}// namespace jtx
+
+#pragma clang diagnostic pop
+#pragma clang diagnostic pop
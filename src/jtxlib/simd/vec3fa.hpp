@@ -0,0 +1,289 @@
+#pragma once
+
+#include "simdfloat.hpp"
+#include "../math/vec3.hpp"
+#include "../math/vec4.hpp"
+
+/**
+ * Vec3fA and Vec4fA are 16-byte aligned float vectors held in a single SimdFloat<4>, so arithmetic is one
+ * register op instead of one per component. With SSE4.1 they are backed by __m128: dot products use dpps and
+ * cross products shuffles. Other targets get the portable 4-lane backend.
+ *
+ * Vec3fA's fourth lane is padding. Its value is unspecified and never affects a result, so it does not need
+ * to be kept at 0. Dot, cross, length and normalize round the same way as the Vec3f/Vec4f member functions
+ * with the Fast policy, but only when the compiler doesn't contract the scalar a * b - c * d into an fma (no
+ * FMA target, or -ffp-contract=off). With contraction the two can differ in the last bit or so.
+ * Use these for per-ray AoS math and Vec3f/Vec4f for storage; the conversions are a couple of instructions.
+ */
+namespace jtx::inline JTX_SIMD_ABI {
+    namespace simd_detail {
+        inline SimdFloat<4> set4(float x, float y, float z, float w) {
+#if defined(__SSE4_1__)
+            return _mm_setr_ps(x, y, z, w);
+#else
+            SimdFloat<4> r;
+            r[0] = x;
+            r[1] = y;
+            r[2] = z;
+            r[3] = w;
+            return r;
+#endif
+        }
+
+        // Lane i of the result is lane Ii of a
+        template<int I0, int I1, int I2, int I3>
+        inline SimdFloat<4> shuffle(SimdFloat<4> a) {
+#if defined(__SSE4_1__)
+            return _mm_shuffle_ps(a, a, _MM_SHUFFLE(I3, I2, I1, I0));
+#else
+            return set4(a[I0], a[I1], a[I2], a[I3]);
+#endif
+        }
+
+        // Dot product of the first Lanes lanes, broadcast to every lane. Sums as (p0 + p1) + (p2 + p3) like dpps
+        template<int Lanes>
+        inline SimdFloat<4> dot(SimdFloat<4> a, SimdFloat<4> b) {
+            static_assert(Lanes == 3 || Lanes == 4);
+#if defined(__SSE4_1__)
+            return _mm_dp_ps(a, b, ((1 << Lanes) - 1) << 4 | 0xF);
+#else
+            SimdFloat<4> p = a * b;
+            if constexpr (Lanes == 3) return (p[0] + p[1]) + p[2];
+            else return (p[0] + p[1]) + (p[2] + p[3]);
+#endif
+        }
+
+        // x, y, z of a x b; the padding lane is a.w * b.w - a.w * b.w
+        inline SimdFloat<4> cross(SimdFloat<4> a, SimdFloat<4> b) {
+            SimdFloat<4> aYZX = shuffle<1, 2, 0, 3>(a), bYZX = shuffle<1, 2, 0, 3>(b);
+            return shuffle<1, 2, 0, 3>(a * bYZX - aYZX * b);
+        }
+
+        // Normalizes v given its squared length broadcast to every lane, zero vectors are returned unchanged
+        template<typename P>
+        inline SimdFloat<4> normalize(SimdFloat<4> v, SimdFloat<4> l2) {
+            SimdFloat<4> n;
+            if constexpr (IsApprox<P>) n = v * rsqrt(l2);
+            else n = v / sqrt(l2);
+            return select(l2 == SimdFloat<4>(0.0f), v, n);
+        }
+    }// namespace simd_detail
+
+    class alignas(16) Vec3fA {
+    public:
+        SimdFloat<4> v;
+
+        //region Constructors
+        // Sets all components to 0
+        Vec3fA() = default;
+        Vec3fA(SimdFloat<4> v) : v(v) {}
+        Vec3fA(float x, float y, float z) : v(simd_detail::set4(x, y, z, 0.0f)) {}
+        explicit Vec3fA(float s) : v(s) {}
+
+        explicit Vec3fA(const Vec3f &other) {
+#if defined(__SSE4_1__)
+            __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(&other.x));
+            v = _mm_insert_ps(xy, _mm_load_ss(&other.z), 0x20);
+#else
+            v = simd_detail::set4(other.x, other.y, other.z, 0.0f);
+#endif
+        }
+
+        explicit operator Vec3f() const {
+            Vec3f res;
+#if defined(__SSE4_1__)
+            _mm_storel_pi(reinterpret_cast<__m64 *>(&res.x), v);
+            _mm_store_ss(&res.z, _mm_movehl_ps(v, v));
+#else
+            res = {v[0], v[1], v[2]};
+#endif
+            return res;
+        }
+        //endregion
+
+        //region Access
+        [[nodiscard]] inline float x() const { return v[0]; }
+        [[nodiscard]] inline float y() const { return v[1]; }
+        [[nodiscard]] inline float z() const { return v[2]; }
+
+        inline float &operator[](int i) {
+            ASSERT(i >= 0 && i < 3);
+            return v[i];
+        }
+
+        inline float operator[](int i) const {
+            ASSERT(i >= 0 && i < 3);
+            return v[i];
+        }
+        //endregion
+
+        //region Operators
+        friend inline Vec3fA operator+(Vec3fA a, Vec3fA b) { return a.v + b.v; }
+        friend inline Vec3fA operator-(Vec3fA a, Vec3fA b) { return a.v - b.v; }
+        friend inline Vec3fA operator*(Vec3fA a, Vec3fA b) { return a.v * b.v; }
+        friend inline Vec3fA operator/(Vec3fA a, Vec3fA b) { return a.v / b.v; }
+        friend inline Vec3fA operator*(Vec3fA a, float s) { return a.v * SimdFloat<4>(s); }
+        friend inline Vec3fA operator*(float s, Vec3fA a) { return SimdFloat<4>(s) * a.v; }
+        friend inline Vec3fA operator/(Vec3fA a, float s) { return a.v / SimdFloat<4>(s); }
+        friend inline Vec3fA operator-(Vec3fA a) { return -a.v; }
+
+        inline Vec3fA &operator+=(Vec3fA other) { return *this = *this + other; }
+        inline Vec3fA &operator-=(Vec3fA other) { return *this = *this - other; }
+        inline Vec3fA &operator*=(Vec3fA other) { return *this = *this * other; }
+        inline Vec3fA &operator/=(Vec3fA other) { return *this = *this / other; }
+        inline Vec3fA &operator*=(float s) { return *this = *this * s; }
+        inline Vec3fA &operator/=(float s) { return *this = *this / s; }
+
+        // Compares x, y, z only
+        friend inline bool operator==(Vec3fA a, Vec3fA b) { return ((a.v == b.v).movemask() & 0x7) == 0x7; }
+        friend inline bool operator!=(Vec3fA a, Vec3fA b) { return !(a == b); }
+        //endregion
+
+        //region Member functions
+        [[nodiscard]] inline float Dot(Vec3fA other) const { return simd_detail::dot<3>(v, other.v)[0]; }
+
+        [[nodiscard]] inline Vec3fA cross(Vec3fA other) const { return simd_detail::cross(v, other.v); }
+
+        [[nodiscard]] inline float LengthSquared() const { return Dot(*this); }
+
+        // P is a precision policy, see math/policy.hpp
+        template<typename P = Exact>
+        [[nodiscard]] inline float Length() const {
+            SimdFloat<4> l2 = simd_detail::dot<3>(v, v);
+            if constexpr (IsApprox<P>) return select(l2 == SimdFloat<4>(0.0f), l2, l2 * rsqrt(l2))[0];
+            else return sqrt(l2)[0];
+        }
+
+        template<typename P = Exact>
+        inline Vec3fA &Normalize() {
+            v = simd_detail::normalize<P>(v, simd_detail::dot<3>(v, v));
+            return *this;
+        }
+        //endregion
+    };
+
+    class alignas(16) Vec4fA {
+    public:
+        SimdFloat<4> v;
+
+        //region Constructors
+        // Sets all components to 0
+        Vec4fA() = default;
+        Vec4fA(SimdFloat<4> v) : v(v) {}
+        Vec4fA(float x, float y, float z, float w) : v(simd_detail::set4(x, y, z, w)) {}
+        Vec4fA(Vec3fA xyz, float w) {
+#if defined(__SSE4_1__)
+            v = _mm_insert_ps(xyz.v, _mm_set_ss(w), 0x30);
+#else
+            v = xyz.v;
+            v[3] = w;
+#endif
+        }
+        explicit Vec4fA(float s) : v(s) {}
+
+        explicit Vec4fA(const Vec4f &other) : v(SimdFloat<4>::loadu(&other.x)) {}
+
+        explicit operator Vec4f() const {
+            Vec4f res;
+            v.storeu(&res.x);
+            return res;
+        }
+
+        // Drops w
+        [[nodiscard]] inline Vec3fA xyz() const { return v; }
+        //endregion
+
+        //region Access
+        [[nodiscard]] inline float x() const { return v[0]; }
+        [[nodiscard]] inline float y() const { return v[1]; }
+        [[nodiscard]] inline float z() const { return v[2]; }
+        [[nodiscard]] inline float w() const { return v[3]; }
+
+        inline float &operator[](int i) {
+            ASSERT(i >= 0 && i < 4);
+            return v[i];
+        }
+
+        inline float operator[](int i) const {
+            ASSERT(i >= 0 && i < 4);
+            return v[i];
+        }
+        //endregion
+
+        //region Operators
+        friend inline Vec4fA operator+(Vec4fA a, Vec4fA b) { return a.v + b.v; }
+        friend inline Vec4fA operator-(Vec4fA a, Vec4fA b) { return a.v - b.v; }
+        friend inline Vec4fA operator*(Vec4fA a, Vec4fA b) { return a.v * b.v; }
+        friend inline Vec4fA operator/(Vec4fA a, Vec4fA b) { return a.v / b.v; }
+        friend inline Vec4fA operator*(Vec4fA a, float s) { return a.v * SimdFloat<4>(s); }
+        friend inline Vec4fA operator*(float s, Vec4fA a) { return SimdFloat<4>(s) * a.v; }
+        friend inline Vec4fA operator/(Vec4fA a, float s) { return a.v / SimdFloat<4>(s); }
+        friend inline Vec4fA operator-(Vec4fA a) { return -a.v; }
+
+        inline Vec4fA &operator+=(Vec4fA other) { return *this = *this + other; }
+        inline Vec4fA &operator-=(Vec4fA other) { return *this = *this - other; }
+        inline Vec4fA &operator*=(Vec4fA other) { return *this = *this * other; }
+        inline Vec4fA &operator/=(Vec4fA other) { return *this = *this / other; }
+        inline Vec4fA &operator*=(float s) { return *this = *this * s; }
+        inline Vec4fA &operator/=(float s) { return *this = *this / s; }
+
+        friend inline bool operator==(Vec4fA a, Vec4fA b) { return (a.v == b.v).all(); }
+        friend inline bool operator!=(Vec4fA a, Vec4fA b) { return !(a == b); }
+        //endregion
+
+        //region Member functions
+        // Sums as (x + y) + (z + w), which can differ from Vec4f::dot in the last bit
+        [[nodiscard]] inline float dot(Vec4fA other) const { return simd_detail::dot<4>(v, other.v)[0]; }
+
+        [[nodiscard]] inline float lenSqr() const { return dot(*this); }
+
+        template<typename P = Exact>
+        [[nodiscard]] inline float len() const {
+            SimdFloat<4> l2 = simd_detail::dot<4>(v, v);
+            if constexpr (IsApprox<P>) return select(l2 == SimdFloat<4>(0.0f), l2, l2 * rsqrt(l2))[0];
+            else return sqrt(l2)[0];
+        }
+
+        template<typename P = Exact>
+        inline Vec4fA &normalize() {
+            v = simd_detail::normalize<P>(v, simd_detail::dot<4>(v, v));
+            return *this;
+        }
+        //endregion
+    };
+
+    static_assert(sizeof(Vec3fA) == 16 && alignof(Vec3fA) == 16, "Vec3fA must fill one 16-byte register");
+    static_assert(sizeof(Vec4fA) == 16 && alignof(Vec4fA) == 16, "Vec4fA must fill one 16-byte register");
+
+    //region Functions
+    inline float Dot(Vec3fA a, Vec3fA b) { return a.Dot(b); }
+    inline float Dot(Vec4fA a, Vec4fA b) { return a.dot(b); }
+
+    inline float AbsDot(Vec3fA a, Vec3fA b) { return std::abs(a.Dot(b)); }
+
+    inline Vec3fA Cross(Vec3fA a, Vec3fA b) { return a.cross(b); }
+
+    template<typename P = Exact>
+    inline float Length(Vec3fA v) { return v.Length<P>(); }
+
+    template<typename P = Exact>
+    inline float Length(Vec4fA v) { return v.len<P>(); }
+
+    template<typename P = Exact>
+    inline Vec3fA Normalize(Vec3fA v) { return v.Normalize<P>(); }
+
+    template<typename P = Exact>
+    inline Vec4fA Normalize(Vec4fA v) { return v.normalize<P>(); }
+
+    inline Vec3fA Min(Vec3fA a, Vec3fA b) { return min(a.v, b.v); }
+    inline Vec4fA Min(Vec4fA a, Vec4fA b) { return min(a.v, b.v); }
+    inline Vec3fA Max(Vec3fA a, Vec3fA b) { return max(a.v, b.v); }
+    inline Vec4fA Max(Vec4fA a, Vec4fA b) { return max(a.v, b.v); }
+    inline Vec3fA Abs(Vec3fA a) { return abs(a.v); }
+    inline Vec4fA Abs(Vec4fA a) { return abs(a.v); }
+
+    // a * b + c, fused when compiled with FMA support
+    inline Vec3fA FMA(Vec3fA a, Vec3fA b, Vec3fA c) { return fma(a.v, b.v, c.v); }
+    inline Vec4fA FMA(Vec4fA a, Vec4fA b, Vec4fA c) { return fma(a.v, b.v, c.v); }
+    //endregion
+}// namespace jtx
@@ -0,0 +1,208 @@
+#include "epoch.hpp"
+
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace jtx {
+
+struct EpochDomain::ThreadRecord {
+    // (epoch << 1) | pinned, written by the owning thread and scanned by tryAdvance()
+    alignas(64) std::atomic<uint64_t> state{0};
+    std::atomic<bool> inUse{true};
+    ThreadRecord *next = nullptr;
+
+    // Only touched by the owning thread
+    uint32_t nesting = 0;
+    size_t sinceCollect = 0;
+    vector<Retired> retired;
+
+    explicit ThreadRecord(pmr::memory_resource *r) : retired(pmr::polymorphic_allocator<Retired>(r)) {}
+};
+
+#pragma region Domain registry
+// Lets exiting threads tell whether a domain they registered with still exists
+static std::mutex &registryMutex() {
+    static std::mutex m;
+    return m;
+}
+
+static std::unordered_set<uint64_t> &liveDomains() {
+    static std::unordered_set<uint64_t> ids;
+    return ids;
+}
+
+static std::atomic<uint64_t> nextDomainId{1};
+// Bumped by every domain destructor so thread caches know when they may hold dead entries
+static std::atomic<uint64_t> destroyedDomains{0};
+
+struct ThreadCache {
+    struct Entry {
+        EpochDomain *domain;
+        uint64_t id;
+        EpochDomain::ThreadRecord *rec;
+    };
+
+    Entry last{nullptr, 0, nullptr};
+    // Keyed by domain id, ids are never reused so a new domain at a destroyed one's address can't match
+    std::unordered_map<uint64_t, Entry> entries;
+    uint64_t seenDestroyed = 0;
+
+    // Drops the entries of domains destroyed since the last call, so a thread that cycles through many
+    // short-lived domains only keeps the ones still alive
+    void prune() {
+        uint64_t destroyed = destroyedDomains.load(std::memory_order_acquire);
+        if (destroyed == seenDestroyed) return;
+        seenDestroyed = destroyed;
+
+        std::lock_guard lock(registryMutex());
+        std::erase_if(entries, [](const auto &kv) { return !liveDomains().count(kv.first); });
+        if (!liveDomains().count(last.id)) last = {nullptr, 0, nullptr};
+    }
+
+    ~ThreadCache() {
+        std::lock_guard lock(registryMutex());
+        for (const auto &[id, e]: entries) {
+            if (liveDomains().count(id)) e.domain->release(e.rec);
+        }
+    }
+};
+
+static thread_local ThreadCache threadCache;
+#pragma endregion Domain registry
+
+EpochDomain::EpochDomain(pmr::memory_resource *resource)
+    : res(resource), id(nextDomainId.fetch_add(1)), orphans(pmr::polymorphic_allocator<Retired>(resource)) {
+    std::lock_guard lock(registryMutex());
+    liveDomains().insert(id);
+}
+
+EpochDomain::~EpochDomain() {
+    {
+        std::lock_guard lock(registryMutex());
+        liveDomains().erase(id);
+        destroyedDomains.fetch_add(1, std::memory_order_release);
+    }
+
+    ThreadRecord *rec = records.load(std::memory_order_acquire);
+    while (rec) {
+        ASSERT(rec->nesting == 0);
+        ThreadRecord *next = rec->next;
+        for (const auto &r: rec->retired) destroyRetired(r);
+        rec->~ThreadRecord();
+        res->deallocate(rec, sizeof(ThreadRecord), alignof(ThreadRecord));
+        rec = next;
+    }
+    for (const auto &r: orphans) destroyRetired(r);
+}
+
+EpochDomain::ThreadRecord *EpochDomain::localRecord() {
+    ThreadCache &cache = threadCache;
+    if (cache.last.domain == this && cache.last.id == id) return cache.last.rec;
+
+    if (auto it = cache.entries.find(id); it != cache.entries.end()) {
+        cache.last = it->second;
+        return it->second.rec;
+    }
+    cache.prune();
+
+    // Reuse a record released by an exited thread before allocating a new one
+    ThreadRecord *rec = records.load(std::memory_order_acquire);
+    for (; rec; rec = rec->next) {
+        bool expected = false;
+        if (!rec->inUse.load(std::memory_order_relaxed) &&
+            rec->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            break;
+        }
+    }
+
+    if (!rec) {
+        void *mem = res->allocate(sizeof(ThreadRecord), alignof(ThreadRecord));
+        rec = new (mem) ThreadRecord(res);
+        ThreadRecord *head = records.load(std::memory_order_relaxed);
+        do {
+            rec->next = head;
+        } while (!records.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    cache.last = {this, id, rec};
+    cache.entries.emplace(id, cache.last);
+    return rec;
+}
+
+void EpochDomain::release(ThreadRecord *rec) {
+    ASSERT(rec->nesting == 0);
+    if (!rec->retired.empty()) {
+        std::lock_guard lock(orphanMutex);
+        for (const auto &r: rec->retired) orphans.push_back(r);
+    }
+    rec->retired.clear();
+    rec->sinceCollect = 0;
+    rec->nesting = 0;
+    rec->state.store(0, std::memory_order_relaxed);
+    rec->inUse.store(false, std::memory_order_release);
+}
+
+void EpochDomain::enter() {
+    ThreadRecord *rec = localRecord();
+    if (rec->nesting++ == 0) {
+        uint64_t e = globalEpoch.load(std::memory_order_relaxed);
+        // Announcement must be visible before any load from the protected structure (xchg on x86)
+        rec->state.exchange((e << 1) | 1, std::memory_order_seq_cst);
+    }
+}
+
+void EpochDomain::exit() {
+    ThreadRecord *rec = localRecord();
+    ASSERT(rec->nesting > 0);
+    if (--rec->nesting == 0) rec->state.store(0, std::memory_order_release);
+}
+
+void EpochDomain::retire(void *p, size_t bytes, size_t alignment, void (*destroy)(void *)) {
+    if (!p) return;
+    ThreadRecord *rec = localRecord();
+    // p is already unlinked; anything pinned before this load can still see it
+    uint64_t e = globalEpoch.load(std::memory_order_seq_cst);
+    rec->retired.push_back({p, bytes, alignment, destroy, e});
+    if (++rec->sinceCollect >= COLLECT_THRESHOLD) collect();
+}
+
+bool EpochDomain::tryAdvance(uint64_t e) {
+    for (ThreadRecord *rec = records.load(std::memory_order_acquire); rec; rec = rec->next) {
+        uint64_t s = rec->state.load(std::memory_order_seq_cst);
+        if ((s & 1) && (s >> 1) != e) return false;
+    }
+    return globalEpoch.compare_exchange_strong(e, e + 1, std::memory_order_release, std::memory_order_relaxed);
+}
+
+void EpochDomain::collect() {
+    ThreadRecord *rec = localRecord();
+    rec->sinceCollect = 0;
+
+    tryAdvance(globalEpoch.load(std::memory_order_relaxed));
+    uint64_t e = globalEpoch.load(std::memory_order_acquire);
+    reclaim(rec->retired, e);
+
+    std::unique_lock lock(orphanMutex, std::try_to_lock);
+    if (lock.owns_lock() && !orphans.empty()) reclaim(orphans, e);
+}
+
+void EpochDomain::reclaim(vector<Retired> &list, uint64_t safeEpoch) {
+    // Anything retired two epochs ago can no longer be referenced by a pinned thread
+    size_t kept = 0;
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (list[i].epoch + 2 <= safeEpoch) {
+            destroyRetired(list[i]);
+        } else {
+            list[kept++] = list[i];
+        }
+    }
+    list.resize(kept);
+}
+
+void EpochDomain::destroyRetired(const Retired &r) {
+    if (r.destroy) r.destroy(r.ptr);
+    res->deallocate(r.ptr, r.bytes, r.alignment);
+}
+
+}// namespace jtx
@@ -0,0 +1,122 @@
+/**
+ * Epoch-based memory reclamation (EBR) for lock-free data structures
+ *
+ * Readers pin the domain for the duration of a critical region; writers that unlink a node hand it to
+ * retire() instead of freeing it. A retired node is only destroyed once every thread that could still
+ * hold a reference to it has left its critical region, which is detected with a global epoch that can
+ * only advance when all pinned threads have observed the current value.
+ *
+ * References:
+ *  - Fraser, "Practical lock-freedom" (2004), Section 5.2.3
+ *  - https://github.com/crossbeam-rs/crossbeam/tree/master/crossbeam-epoch
+ */
+#pragma once
+
+#include <jtxlib.hpp>
+#include <jtxlib/jstd/memory_resource.hpp>
+#include <jtxlib/util/assert.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace jtx {
+
+class EpochDomain {
+public:
+    // Number of retired pointers a thread accumulates before it tries to advance the epoch
+    static constexpr size_t COLLECT_THRESHOLD = 64;
+
+    /**
+     * Keeps the calling thread inside a critical region of the domain
+     * Pointers loaded from structures guarded by this domain are valid until the guard is destroyed
+     */
+    class Guard {
+    public:
+        JTX_HOST explicit Guard(EpochDomain &domain) : domain(&domain) { domain.enter(); }
+        JTX_HOST Guard(Guard &&other) noexcept : domain(other.domain) { other.domain = nullptr; }
+        JTX_HOST ~Guard() {
+            if (domain) domain->exit();
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+        Guard &operator=(Guard &&) = delete;
+
+    private:
+        EpochDomain *domain;
+    };
+
+    JTX_HOST explicit EpochDomain(pmr::memory_resource *resource = pmr::get_default_resource());
+    // Frees all pending pointers; no thread may be pinned when the domain is destroyed
+    JTX_HOST ~EpochDomain();
+
+    EpochDomain(const EpochDomain &) = delete;
+    EpochDomain &operator=(const EpochDomain &) = delete;
+
+    [[nodiscard]] JTX_HOST Guard pin() { return Guard(*this); }
+
+    // Critical regions may nest; only the outermost enter/exit pair announces the thread
+    JTX_HOST void enter();
+    JTX_HOST void exit();
+
+    /**
+     * Defers destruction of p until no pinned thread can reference it
+     * p must have been allocated from resource() with the given size and alignment
+     */
+    JTX_HOST void retire(void *p, size_t bytes, size_t alignment, void (*destroy)(void *) = nullptr);
+
+    template<typename T>
+    JTX_HOST void retire(T *p) {
+        retire(p, sizeof(T), alignof(T), [](void *obj) { static_cast<T *>(obj)->~T(); });
+    }
+
+    // Allocates and constructs a T from the domain's resource so it can later be retired
+    template<typename T, typename... Args>
+    [[nodiscard]] JTX_HOST T *create(Args &&...args) {
+        return allocator().template new_object<T>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Tries to advance the global epoch and frees the calling thread's retired pointers that are safe
+     * Called automatically every COLLECT_THRESHOLD retires
+     */
+    JTX_HOST void collect();
+
+    [[nodiscard]] JTX_HOST uint64_t epoch() const { return globalEpoch.load(std::memory_order_acquire); }
+
+    [[nodiscard]] JTX_HOST pmr::memory_resource *resource() const { return res; }
+
+    [[nodiscard]] JTX_HOST pmr::polymorphic_allocator<std::byte> allocator() const { return {res}; }
+
+    struct ThreadRecord;
+
+private:
+    struct Retired {
+        void *ptr;
+        size_t bytes;
+        size_t alignment;
+        void (*destroy)(void *);
+        uint64_t epoch;
+    };
+
+    JTX_HOST ThreadRecord *localRecord();
+    JTX_HOST bool tryAdvance(uint64_t e);
+    JTX_HOST void release(ThreadRecord *rec);
+    JTX_HOST void reclaim(vector<Retired> &list, uint64_t safeEpoch);
+    JTX_HOST void destroyRetired(const Retired &r);
+
+    friend struct ThreadCache;
+
+    pmr::memory_resource *res;
+    const uint64_t id;
+    alignas(64) std::atomic<uint64_t> globalEpoch{0};
+    std::atomic<ThreadRecord *> records{nullptr};
+
+    // Retired pointers left behind by threads that exited before they were safe to free
+    std::mutex orphanMutex;
+    vector<Retired> orphans;
+};
+
+}// namespace jtx
@@ -0,0 +1,175 @@
+/**
+ * Non-allocating replacements for std::function
+ *
+ * The callable is stored inside a fixed-size buffer and too-large captures are rejected at compile time,
+ * so submitting a task never touches the heap. Calls go through a single function pointer (no vtable),
+ * and move/copy/destroy through a per-type table of function pointers.
+ *
+ * InplaceFunction is copyable (requires copyable callables), MoveOnlyInplaceFunction also accepts
+ * move-only callables (e.g. lambdas capturing a unique_ptr).
+ */
+#pragma once
+
+#include <jtxlib.hpp>
+#include <jtxlib/util/assert.hpp>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace jtx {
+static constexpr size_t INPLACE_FUNCTION_DEFAULT_CAPACITY = 48;
+
+namespace detail {
+    template<bool Copyable, size_t Capacity, size_t Alignment, typename R, typename... Args>
+    class InplaceFunctionBase {
+    public:
+        //region Constructors
+        JTX_HOST InplaceFunctionBase() noexcept = default;
+        JTX_HOST InplaceFunctionBase(std::nullptr_t) noexcept {}// NOLINT(*-explicit-constructor)
+
+        template<typename F, typename Fn = std::decay_t<F>,
+                 typename = std::enable_if_t<!std::is_base_of_v<InplaceFunctionBase, Fn> &&
+                                             std::is_invocable_r_v<R, Fn &, Args...>>>
+        JTX_HOST InplaceFunctionBase(F &&f) {// NOLINT(*-explicit-constructor)
+            static_assert(sizeof(Fn) <= Capacity, "Callable does not fit in the inline buffer, increase Capacity");
+            static_assert(Alignment % alignof(Fn) == 0, "Callable is over-aligned for the inline buffer");
+            static_assert(std::is_nothrow_move_constructible_v<Fn>, "Callable must be nothrow move constructible");
+            static_assert(!Copyable || std::is_copy_constructible_v<Fn>,
+                          "InplaceFunction requires a copyable callable, use MoveOnlyInplaceFunction");
+
+            new (storage) Fn(std::forward<F>(f));
+            invoker = &invokeImpl<Fn>;
+            ops = &opsFor<Fn>;
+        }
+
+        JTX_HOST InplaceFunctionBase(InplaceFunctionBase &&other) noexcept { moveFrom(other); }
+
+        JTX_HOST InplaceFunctionBase(const InplaceFunctionBase &other) requires Copyable { copyFrom(other); }
+
+        JTX_HOST ~InplaceFunctionBase() { reset(); }
+        //endregion
+
+        //region Operators
+        JTX_HOST InplaceFunctionBase &operator=(InplaceFunctionBase &&other) noexcept {
+            if (this != &other) {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        JTX_HOST InplaceFunctionBase &operator=(const InplaceFunctionBase &other) requires Copyable {
+            if (this != &other) {
+                reset();
+                copyFrom(other);
+            }
+            return *this;
+        }
+
+        JTX_HOST InplaceFunctionBase &operator=(std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+        JTX_HOST R operator()(Args... args) const {
+            ASSERT(invoker != nullptr);
+            return invoker(const_cast<std::byte *>(storage), std::forward<Args>(args)...);
+        }
+
+        JTX_HOST explicit operator bool() const noexcept { return invoker != nullptr; }
+        //endregion
+
+        JTX_HOST void reset() noexcept {
+            if (ops) ops->destroy(storage);
+            invoker = nullptr;
+            ops = nullptr;
+        }
+
+        static constexpr size_t capacity() { return Capacity; }
+
+    private:
+        struct Ops {
+            void (*move)(std::byte *dst, std::byte *src) noexcept;
+            void (*copy)(std::byte *dst, const std::byte *src);
+            void (*destroy)(std::byte *obj) noexcept;
+        };
+
+        template<typename Fn>
+        static R invokeImpl(std::byte *obj, Args &&...args) {
+            return (*std::launder(reinterpret_cast<Fn *>(obj)))(std::forward<Args>(args)...);
+        }
+
+        template<typename Fn>
+        static void moveImpl(std::byte *dst, std::byte *src) noexcept {
+            Fn *f = std::launder(reinterpret_cast<Fn *>(src));
+            new (dst) Fn(std::move(*f));
+            f->~Fn();
+        }
+
+        template<typename Fn>
+        static void copyImpl(std::byte *dst, const std::byte *src) {
+            new (dst) Fn(*std::launder(reinterpret_cast<const Fn *>(src)));
+        }
+
+        template<typename Fn>
+        static void destroyImpl(std::byte *obj) noexcept {
+            std::launder(reinterpret_cast<Fn *>(obj))->~Fn();
+        }
+
+        template<typename Fn>
+        static constexpr auto copyFor() -> void (*)(std::byte *, const std::byte *) {
+            if constexpr (Copyable) return &copyImpl<Fn>;
+            else return nullptr;
+        }
+
+        template<typename Fn>
+        static constexpr Ops opsFor = {&moveImpl<Fn>, copyFor<Fn>(), &destroyImpl<Fn>};
+
+        JTX_HOST void moveFrom(InplaceFunctionBase &other) noexcept {
+            if (other.ops) other.ops->move(storage, other.storage);
+            invoker = other.invoker;
+            ops = other.ops;
+            other.invoker = nullptr;
+            other.ops = nullptr;
+        }
+
+        JTX_HOST void copyFrom(const InplaceFunctionBase &other) {
+            if (other.ops) other.ops->copy(storage, other.storage);
+            invoker = other.invoker;
+            ops = other.ops;
+        }
+
+        alignas(Alignment) std::byte storage[Capacity];
+        R (*invoker)(std::byte *, Args &&...) = nullptr;
+        const Ops *ops = nullptr;
+    };
+}// namespace detail
+
+template<typename Sig, size_t Capacity = INPLACE_FUNCTION_DEFAULT_CAPACITY, size_t Alignment = alignof(std::max_align_t)>
+class InplaceFunction;
+
+template<typename R, typename... Args, size_t Capacity, size_t Alignment>
+class InplaceFunction<R(Args...), Capacity, Alignment>
+    : public detail::InplaceFunctionBase<true, Capacity, Alignment, R, Args...> {
+    using Base = detail::InplaceFunctionBase<true, Capacity, Alignment, R, Args...>;
+
+public:
+    using Base::Base;
+    using Base::operator=;
+};
+
+template<typename Sig, size_t Capacity = INPLACE_FUNCTION_DEFAULT_CAPACITY, size_t Alignment = alignof(std::max_align_t)>
+class MoveOnlyInplaceFunction;
+
+template<typename R, typename... Args, size_t Capacity, size_t Alignment>
+class MoveOnlyInplaceFunction<R(Args...), Capacity, Alignment>
+    : public detail::InplaceFunctionBase<false, Capacity, Alignment, R, Args...> {
+    using Base = detail::InplaceFunctionBase<false, Capacity, Alignment, R, Args...>;
+
+public:
+    using Base::Base;
+    using Base::operator=;
+};
+}// namespace jtx
@@ -0,0 +1,173 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace jtx {
+
+thread_local ProfileThreadBuffer *detail::profileBuffer = nullptr;
+
+namespace {
+    struct ProfilerState {
+        std::mutex mutex;
+        std::vector<const char *> names;
+        // Buffers outlive their threads so records can still be exported
+        std::vector<std::unique_ptr<ProfileThreadBuffer>> buffers;
+
+        // Reference points used to convert ticks to microseconds
+        uint64_t tick0 = profilerTicks();
+        std::chrono::steady_clock::time_point time0 = std::chrono::steady_clock::now();
+    };
+
+    ProfilerState &state() {
+        static ProfilerState s;
+        return s;
+    }
+
+    // Sets tick0 at static init, before main() can start a scope, so no record starts before it
+    [[maybe_unused]] const ProfilerState &initialState = state();
+
+    struct Snapshot {
+        uint32_t tid;
+        std::vector<ProfileRecord> records;
+    };
+
+    // Copies the valid part of every ring buffer, oldest record first
+    std::vector<Snapshot> snapshot(ProfilerState &s) {
+        std::vector<Snapshot> out;
+        for (const auto &buf: s.buffers) {
+            uint64_t head = buf->head.load(std::memory_order_acquire);
+            uint64_t count = std::min<uint64_t>(head, PROFILE_BUFFER_CAPACITY);
+            Snapshot snap{buf->tid, {}};
+            snap.records.reserve(count);
+            for (uint64_t i = head - count; i < head; ++i) snap.records.push_back(buf->records[i & (PROFILE_BUFFER_CAPACITY - 1)]);
+            out.push_back(std::move(snap));
+        }
+        return out;
+    }
+
+    double ticksPerMicrosecond(ProfilerState &s) {
+#ifdef JTXLIB_HAS_RDTSC
+        // Make sure the calibration interval is long enough to be accurate
+        auto minInterval = std::chrono::milliseconds(10);
+        while (std::chrono::steady_clock::now() - s.time0 < minInterval) {}
+        uint64_t ticks = profilerTicks() - s.tick0;
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - s.time0).count();
+        return static_cast<double>(ticks) / us;
+#else
+        using Tick = std::chrono::steady_clock::duration;
+        return static_cast<double>(Tick::period::den) / (1e6 * static_cast<double>(Tick::period::num));
+#endif
+    }
+
+    void writeJsonString(FILE *dest, const char *str) {
+        std::fputc('"', dest);
+        for (const char *c = str; *c; ++c) {
+            if (*c == '"' || *c == '\\') std::fputc('\\', dest);
+            if (static_cast<unsigned char>(*c) < 0x20) std::fprintf(dest, "\\u%04x", *c);
+            else std::fputc(*c, dest);
+        }
+        std::fputc('"', dest);
+    }
+
+    template<typename T>
+    void writeRaw(FILE *dest, const T &v) {
+        std::fwrite(&v, sizeof(T), 1, dest);
+    }
+}// namespace
+
+ProfileThreadBuffer *detail::registerProfileThread() {
+    ProfilerState &s = state();
+    std::lock_guard lock(s.mutex);
+    auto buf = std::make_unique<ProfileThreadBuffer>();
+    buf->tid = static_cast<uint32_t>(s.buffers.size());
+    profileBuffer = buf.get();
+    s.buffers.push_back(std::move(buf));
+    return profileBuffer;
+}
+
+uint32_t registerProfileName(const char *name) {
+    ProfilerState &s = state();
+    std::lock_guard lock(s.mutex);
+    for (size_t i = 0; i < s.names.size(); ++i) {
+        if (std::strcmp(s.names[i], name) == 0) return static_cast<uint32_t>(i);
+    }
+    s.names.push_back(name);
+    return static_cast<uint32_t>(s.names.size() - 1);
+}
+
+bool writeChromeTrace(FILE *dest) {
+    ProfilerState &s = state();
+    std::lock_guard lock(s.mutex);
+    double tpus = ticksPerMicrosecond(s);
+    auto threads = snapshot(s);
+
+    std::fprintf(dest, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    bool first = true;
+    for (const auto &t: threads) {
+        std::fprintf(dest, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}",
+                     first ? "" : ",", t.tid, t.tid);
+        first = false;
+        for (const auto &r: t.records) {
+            double ts = static_cast<double>(static_cast<int64_t>(r.start - s.tick0)) / tpus;
+            std::fprintf(dest, ",\n{\"name\":");
+            writeJsonString(dest, r.id < s.names.size() ? s.names[r.id] : "unknown");
+            std::fprintf(dest, ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", t.tid, ts,
+                         static_cast<double>(r.duration) / tpus);
+        }
+    }
+    std::fprintf(dest, "\n]}\n");
+    return std::ferror(dest) == 0;
+}
+
+bool writeChromeTrace(const char *filename) {
+    FILE *f = std::fopen(filename, "w");
+    if (!f) return false;
+    bool ok = writeChromeTrace(f);
+    return std::fclose(f) == 0 && ok;
+}
+
+bool writeBinaryTrace(FILE *dest) {
+    ProfilerState &s = state();
+    std::lock_guard lock(s.mutex);
+    double tpus = ticksPerMicrosecond(s);
+    auto threads = snapshot(s);
+
+    std::fwrite("JTXP", 1, 4, dest);
+    writeRaw(dest, uint32_t(1));
+    writeRaw(dest, tpus);
+
+    writeRaw(dest, static_cast<uint32_t>(s.names.size()));
+    for (const char *name: s.names) {
+        auto len = static_cast<uint32_t>(std::strlen(name));
+        writeRaw(dest, len);
+        std::fwrite(name, 1, len, dest);
+    }
+
+    writeRaw(dest, static_cast<uint32_t>(threads.size()));
+    for (const auto &t: threads) {
+        writeRaw(dest, t.tid);
+        writeRaw(dest, static_cast<uint64_t>(t.records.size()));
+        if (!t.records.empty()) std::fwrite(t.records.data(), sizeof(ProfileRecord), t.records.size(), dest);
+    }
+    return std::ferror(dest) == 0;
+}
+
+bool writeBinaryTrace(const char *filename) {
+    FILE *f = std::fopen(filename, "wb");
+    if (!f) return false;
+    bool ok = writeBinaryTrace(f);
+    return std::fclose(f) == 0 && ok;
+}
+
+void clearProfile() {
+    ProfilerState &s = state();
+    std::lock_guard lock(s.mutex);
+    for (auto &buf: s.buffers) buf->head.store(0, std::memory_order_relaxed);
+}
+
+}// namespace jtx
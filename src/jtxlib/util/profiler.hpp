@@ -0,0 +1,118 @@
+/**
+ * Low-overhead scoped tracing profiler
+ *
+ * JTX_PROFILE_SCOPE("name") records the start and duration of the enclosing scope as a 16 byte record in
+ * a per-thread ring buffer. Timestamps come from the TSC on x86 (steady_clock elsewhere), so the hot path
+ * is two timestamp reads and one store without any synchronization. Once a buffer is full the oldest
+ * records are overwritten.
+ *
+ * The macro compiles to nothing unless JTXLIB_ENABLE_PROFILING is defined (CMake option of the same name).
+ * The export functions are always available and write an empty trace when profiling is disabled. They
+ * should be called while the profiled threads are idle, e.g. between frames or at shutdown.
+ *
+ * Chrome traces can be opened in chrome://tracing or https://ui.perfetto.dev
+ */
+#pragma once
+
+#include <jtxlib.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define JTXLIB_HAS_RDTSC
+#else
+#include <chrono>
+#endif
+
+namespace jtx {
+// Number of records kept per thread, must be a power of two
+static constexpr size_t PROFILE_BUFFER_CAPACITY = 1 << 16;
+
+struct ProfileRecord {
+    uint64_t start;
+    uint32_t duration;// Ticks, saturated
+    uint32_t id;
+};
+static_assert(sizeof(ProfileRecord) == 16);
+
+struct ProfileThreadBuffer {
+    ProfileRecord records[PROFILE_BUFFER_CAPACITY];
+    // Total number of records written, only modified by the owning thread
+    std::atomic<uint64_t> head{0};
+    uint32_t tid = 0;
+};
+
+namespace detail {
+    extern thread_local ProfileThreadBuffer *profileBuffer;
+    JTX_HOST ProfileThreadBuffer *registerProfileThread();
+}// namespace detail
+
+JTX_HOST JTX_INLINE uint64_t profilerTicks() {
+#ifdef JTXLIB_HAS_RDTSC
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+// Returns the id of a scope name; name must outlive the profiler (string literals)
+JTX_HOST uint32_t registerProfileName(const char *name);
+
+class ProfileScope {
+public:
+    JTX_HOST JTX_INLINE explicit ProfileScope(uint32_t id) : id(id), start(profilerTicks()) {}
+
+    JTX_HOST JTX_INLINE ~ProfileScope() {
+        uint64_t end = profilerTicks();
+        ProfileThreadBuffer *buf = detail::profileBuffer;
+        if (!buf) buf = detail::registerProfileThread();
+
+        uint64_t h = buf->head.load(std::memory_order_relaxed);
+        uint64_t d = end - start;
+        buf->records[h & (PROFILE_BUFFER_CAPACITY - 1)] = {start, d > UINT32_MAX ? UINT32_MAX : uint32_t(d), id};
+        buf->head.store(h + 1, std::memory_order_release);
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    uint32_t id;
+    uint64_t start;
+};
+
+// Writes all buffered records as Chrome trace_event JSON, returns false if the file could not be written
+JTX_HOST bool writeChromeTrace(FILE *dest);
+JTX_HOST bool writeChromeTrace(const char *filename);
+
+/**
+ * Writes all buffered records in a compact binary format (little endian):
+ *  "JTXP", u32 version, f64 ticks per microsecond
+ *  u32 name count, then per name: u32 length, bytes
+ *  u32 thread count, then per thread: u32 tid, u64 record count, ProfileRecord[count]
+ */
+JTX_HOST bool writeBinaryTrace(FILE *dest);
+JTX_HOST bool writeBinaryTrace(const char *filename);
+
+// Discards all buffered records
+JTX_HOST void clearProfile();
+
+}// namespace jtx
+
+#define JTX_PROFILE_CONCAT_(a, b) a##b
+#define JTX_PROFILE_CONCAT(a, b) JTX_PROFILE_CONCAT_(a, b)
+
+#ifdef JTXLIB_ENABLE_PROFILING
+#define JTX_PROFILE_SCOPE(name)                                                                                      \
+    static const uint32_t JTX_PROFILE_CONCAT(jtxProfileId, __LINE__) = jtx::registerProfileName(name);              \
+    jtx::ProfileScope JTX_PROFILE_CONCAT(jtxProfileScope, __LINE__)(JTX_PROFILE_CONCAT(jtxProfileId, __LINE__))
+#else
+#define JTX_PROFILE_SCOPE(name) ((void) 0)
+#endif
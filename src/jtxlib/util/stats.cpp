@@ -0,0 +1,152 @@
+#include "stats.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace jtx {
+
+// Constant-initialized, so registerers in other translation units can push during dynamic initialization
+static std::atomic<StatRegisterer *> registeredStats{nullptr};
+
+StatRegisterer::StatRegisterer(const char *title, StatKind kind, ReportFunc report)
+    : name(title), statKind(kind), report(report) {
+    next = registeredStats.load(std::memory_order_relaxed);
+    while (!registeredStats.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+static void atomicMin(std::atomic<int64_t> &a, int64_t v) {
+    int64_t cur = a.load(std::memory_order_relaxed);
+    while (v < cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
+static void atomicMax(std::atomic<int64_t> &a, int64_t v) {
+    int64_t cur = a.load(std::memory_order_relaxed);
+    while (v > cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
+void StatRegisterer::addDistribution(int64_t sum, int64_t count, int64_t minValue, int64_t maxValue) {
+    if (count == 0) return;
+    add(sum, count);
+    atomicMin(min, minValue);
+    atomicMax(max, maxValue);
+}
+
+void StatRegisterer::clear() {
+    a.store(0, std::memory_order_relaxed);
+    b.store(0, std::memory_order_relaxed);
+    min.store(std::numeric_limits<int64_t>::max(), std::memory_order_relaxed);
+    max.store(std::numeric_limits<int64_t>::lowest(), std::memory_order_relaxed);
+}
+
+void reportThreadStats() {
+    for (StatRegisterer *s = registeredStats.load(std::memory_order_acquire); s; s = s->next) s->report(*s);
+}
+
+namespace {
+    struct ThreadStatsFlusher {
+        bool armed = false;
+        ~ThreadStatsFlusher() {
+            if (armed) reportThreadStats();
+        }
+    };
+
+    thread_local ThreadStatsFlusher threadStatsFlusher;
+    // Trivially constructed, so it's still safe to read while the thread's destructors run
+    thread_local bool threadStatsRegistered = false;
+}// namespace
+
+void detail::mergeStatsOnThreadExit() {
+    if (threadStatsRegistered) return;
+    threadStatsRegistered = true;
+    threadStatsFlusher.armed = true;
+}
+
+void clearStats() {
+    for (StatRegisterer *s = registeredStats.load(std::memory_order_acquire); s; s = s->next) s->clear();
+}
+
+#pragma region Printing
+static std::string formatMemory(int64_t bytes) {
+    char buf[64];
+    auto kb = static_cast<double>(bytes) / 1024.0;
+    if (std::abs(kb) < 1024.0) std::snprintf(buf, sizeof(buf), "%9.2f kB", kb);
+    else if (std::abs(kb) < 1024.0 * 1024.0) std::snprintf(buf, sizeof(buf), "%9.2f MiB", kb / 1024.0);
+    else std::snprintf(buf, sizeof(buf), "%9.2f GiB", kb / (1024.0 * 1024.0));
+    return buf;
+}
+
+static bool formatStat(const StatRegisterer &s, int64_t a, int64_t b, int64_t min, int64_t max, std::string &out) {
+    char buf[128];
+    switch (s.kind()) {
+        case StatKind::Counter:
+            if (a == 0) return false;
+            std::snprintf(buf, sizeof(buf), "%12" PRId64, a);
+            break;
+        case StatKind::MemoryCounter:
+            if (a == 0) return false;
+            out = formatMemory(a);
+            return true;
+        case StatKind::Percent:
+            if (b == 0) return false;
+            std::snprintf(buf, sizeof(buf), "%12" PRId64 " / %12" PRId64 " (%.2f%%)", a, b,
+                          100.0 * static_cast<double>(a) / static_cast<double>(b));
+            break;
+        case StatKind::Ratio:
+            if (b == 0) return false;
+            std::snprintf(buf, sizeof(buf), "%12" PRId64 " / %12" PRId64 " (%.2fx)", a, b,
+                          static_cast<double>(a) / static_cast<double>(b));
+            break;
+        case StatKind::IntDistribution:
+            if (b == 0) return false;
+            std::snprintf(buf, sizeof(buf), "%12.3f avg [range %" PRId64 " - %" PRId64 "]",
+                          static_cast<double>(a) / static_cast<double>(b), min, max);
+            break;
+    }
+    out = buf;
+    return true;
+}
+
+void printStats(FILE *dest) {
+    reportThreadStats();
+
+    struct Line {
+        std::string_view category;
+        std::string_view title;
+        std::string value;
+    };
+    std::vector<Line> lines;
+
+    for (StatRegisterer *s = registeredStats.load(std::memory_order_acquire); s; s = s->next) {
+        std::string value;
+        if (!formatStat(*s, s->a.load(std::memory_order_relaxed), s->b.load(std::memory_order_relaxed),
+                        s->min.load(std::memory_order_relaxed), s->max.load(std::memory_order_relaxed), value))
+            continue;
+
+        std::string_view full = s->title();
+        size_t slash = full.find('/');
+        if (slash == std::string_view::npos) lines.push_back({"", full, std::move(value)});
+        else lines.push_back({full.substr(0, slash), full.substr(slash + 1), std::move(value)});
+    }
+
+    std::sort(lines.begin(), lines.end(), [](const Line &x, const Line &y) {
+        return x.category != y.category ? x.category < y.category : x.title < y.title;
+    });
+
+    std::fprintf(dest, "Statistics:\n");
+    std::string_view category;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (i == 0 || lines[i].category != category) {
+            category = lines[i].category;
+            std::fprintf(dest, "  %.*s\n", static_cast<int>(category.size()), category.data());
+        }
+        std::fprintf(dest, "    %-42.*s %s\n", static_cast<int>(lines[i].title.size()), lines[i].title.data(),
+                     lines[i].value.c_str());
+    }
+}
+#pragma endregion Printing
+
+}// namespace jtx
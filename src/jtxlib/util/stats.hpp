@@ -0,0 +1,196 @@
+/**
+ * Per-thread statistics, modeled after pbrt-v4's STAT_* macros
+ *
+ * Each macro defines thread-local variables that are updated without any synchronization in the hot path.
+ * A thread's values are merged into per-statistic atomic totals (no locks) either on demand with
+ * reportThreadStats() or automatically when the thread exits, so pooled and detached threads need no extra
+ * calls. printStats() prints a report grouped by category, where the category is the part of the title
+ * before the first '/'.
+ *
+ * Usage:
+ *  JTX_STAT_COUNTER("BVH/Nodes visited", nodesVisited);
+ *  JTX_STAT_PERCENT("BVH/Leaf hits", leafHits, leafTests);
+ *  JTX_STAT_INT_DISTRIBUTION("BVH/Primitives per leaf", primsPerLeaf);
+ *
+ *  ++nodesVisited;
+ *  JTX_STAT_REPORT_VALUE(primsPerLeaf, n);
+ *
+ * The macros must be used at namespace scope in a source file.
+ */
+#pragma once
+
+#include <jtxlib.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <type_traits>
+
+namespace jtx {
+
+enum class StatKind : uint8_t { Counter, MemoryCounter, Percent, Ratio, IntDistribution };
+
+/**
+ * Global totals of a single statistic
+ * Instances are created by the JTX_STAT_* macros and live for the whole program
+ */
+class StatRegisterer {
+public:
+    // Merges the calling thread's values into the totals and resets them
+    using ReportFunc = void (*)(StatRegisterer &);
+
+    JTX_HOST StatRegisterer(const char *title, StatKind kind, ReportFunc report);
+
+    StatRegisterer(const StatRegisterer &) = delete;
+    StatRegisterer &operator=(const StatRegisterer &) = delete;
+
+    JTX_HOST void add(int64_t value) { a.fetch_add(value, std::memory_order_relaxed); }
+
+    JTX_HOST void add(int64_t num, int64_t denom) {
+        a.fetch_add(num, std::memory_order_relaxed);
+        b.fetch_add(denom, std::memory_order_relaxed);
+    }
+
+    JTX_HOST void addDistribution(int64_t sum, int64_t count, int64_t minValue, int64_t maxValue);
+
+    // Resets the totals, values still pending in other threads are not affected
+    JTX_HOST void clear();
+
+    [[nodiscard]] const char *title() const { return name; }
+    [[nodiscard]] StatKind kind() const { return statKind; }
+
+private:
+    friend void reportThreadStats();
+    friend void printStats(FILE *dest);
+    friend void clearStats();
+
+    const char *name;
+    StatKind statKind;
+    ReportFunc report;
+    StatRegisterer *next = nullptr;
+
+    // Counter/memory: a. Percent/ratio: a / b. Distribution: sum a, count b, min, max
+    std::atomic<int64_t> a{0};
+    std::atomic<int64_t> b{0};
+    std::atomic<int64_t> min{std::numeric_limits<int64_t>::max()};
+    std::atomic<int64_t> max{std::numeric_limits<int64_t>::lowest()};
+};
+
+// Merges the calling thread's statistics into the global totals
+JTX_HOST void reportThreadStats();
+
+namespace detail {
+    // Makes the calling thread call reportThreadStats() when it exits, cheap after the first call
+    JTX_HOST void mergeStatsOnThreadExit();
+}// namespace detail
+
+/**
+ * Thread-local value of a statistic, used like an int64_t
+ * Its first use on a thread constructs it, which registers the thread's merge at exit
+ */
+class StatValue {
+public:
+    JTX_HOST explicit StatValue(int64_t initial = 0) : value(initial) { detail::mergeStatsOnThreadExit(); }
+
+    StatValue(const StatValue &) = delete;
+    StatValue &operator=(const StatValue &) = delete;
+
+    JTX_HOST operator int64_t() const { return value; }
+
+    JTX_HOST StatValue &operator=(int64_t v) {
+        value = v;
+        return *this;
+    }
+
+    JTX_HOST StatValue &operator+=(int64_t v) {
+        value += v;
+        return *this;
+    }
+
+    JTX_HOST StatValue &operator-=(int64_t v) {
+        value -= v;
+        return *this;
+    }
+
+    JTX_HOST StatValue &operator++() {
+        ++value;
+        return *this;
+    }
+
+    JTX_HOST int64_t operator++(int) { return value++; }
+
+private:
+    int64_t value;
+};
+
+// Keeps the values readable while the thread's merge runs from another thread_local's destructor
+static_assert(std::is_trivially_destructible_v<StatValue>);
+
+// Merges the calling thread's statistics and prints all non-empty statistics grouped by category
+JTX_HOST void printStats(FILE *dest = stdout);
+
+JTX_HOST void clearStats();
+
+}// namespace jtx
+
+#define JTX_STAT_CONCAT_(a, b) a##b
+#define JTX_STAT_CONCAT(a, b) JTX_STAT_CONCAT_(a, b)
+
+#define JTX_STAT_COUNTER(title, var)                                                                       \
+    static thread_local jtx::StatValue var;                                                                \
+    static jtx::StatRegisterer JTX_STAT_CONCAT(var, Registerer)(title, jtx::StatKind::Counter,             \
+                                                                [](jtx::StatRegisterer &s) {               \
+                                                                    s.add(var);                            \
+                                                                    var = 0;                               \
+                                                                })
+
+// var is a number of bytes
+#define JTX_STAT_MEMORY_COUNTER(title, var)                                                                \
+    static thread_local jtx::StatValue var;                                                                \
+    static jtx::StatRegisterer JTX_STAT_CONCAT(var, Registerer)(title, jtx::StatKind::MemoryCounter,       \
+                                                                [](jtx::StatRegisterer &s) {               \
+                                                                    s.add(var);                            \
+                                                                    var = 0;                               \
+                                                                })
+
+#define JTX_STAT_PERCENT(title, numVar, denomVar)                                                          \
+    static thread_local jtx::StatValue numVar, denomVar;                                                   \
+    static jtx::StatRegisterer JTX_STAT_CONCAT(numVar, Registerer)(title, jtx::StatKind::Percent,          \
+                                                                   [](jtx::StatRegisterer &s) {            \
+                                                                       s.add(numVar, denomVar);            \
+                                                                       numVar = 0;                         \
+                                                                       denomVar = 0;                       \
+                                                                   })
+
+#define JTX_STAT_RATIO(title, numVar, denomVar)                                                            \
+    static thread_local jtx::StatValue numVar, denomVar;                                                   \
+    static jtx::StatRegisterer JTX_STAT_CONCAT(numVar, Registerer)(title, jtx::StatKind::Ratio,            \
+                                                                   [](jtx::StatRegisterer &s) {            \
+                                                                       s.add(numVar, denomVar);            \
+                                                                       numVar = 0;                         \
+                                                                       denomVar = 0;                       \
+                                                                   })
+
+#define JTX_STAT_INT_DISTRIBUTION(title, var)                                                              \
+    static thread_local jtx::StatValue JTX_STAT_CONCAT(var, Sum), JTX_STAT_CONCAT(var, Count);             \
+    static thread_local jtx::StatValue JTX_STAT_CONCAT(var, Min){std::numeric_limits<int64_t>::max()};     \
+    static thread_local jtx::StatValue JTX_STAT_CONCAT(var, Max){std::numeric_limits<int64_t>::lowest()};  \
+    static jtx::StatRegisterer JTX_STAT_CONCAT(var, Registerer)(                                           \
+            title, jtx::StatKind::IntDistribution, [](jtx::StatRegisterer &s) {                            \
+                s.addDistribution(JTX_STAT_CONCAT(var, Sum), JTX_STAT_CONCAT(var, Count),                  \
+                                  JTX_STAT_CONCAT(var, Min), JTX_STAT_CONCAT(var, Max));                   \
+                JTX_STAT_CONCAT(var, Sum) = 0;                                                             \
+                JTX_STAT_CONCAT(var, Count) = 0;                                                           \
+                JTX_STAT_CONCAT(var, Min) = std::numeric_limits<int64_t>::max();                           \
+                JTX_STAT_CONCAT(var, Max) = std::numeric_limits<int64_t>::lowest();                        \
+            })
+
+#define JTX_STAT_REPORT_VALUE(var, value)                                                                  \
+    do {                                                                                                   \
+        int64_t jtxStatValue = (value);                                                                    \
+        JTX_STAT_CONCAT(var, Sum) += jtxStatValue;                                                         \
+        ++JTX_STAT_CONCAT(var, Count);                                                                     \
+        if (jtxStatValue < JTX_STAT_CONCAT(var, Min)) JTX_STAT_CONCAT(var, Min) = jtxStatValue;            \
+        if (jtxStatValue > JTX_STAT_CONCAT(var, Max)) JTX_STAT_CONCAT(var, Max) = jtxStatValue;            \
+    } while (false)
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <bit>
+#include <cstdint>
 #include <tuple>
 #include <jtxlib.hpp>
 #include <jtxlib/util/assert.hpp>
@@ -10,6 +13,18 @@
 */
 namespace jtx {
     namespace detail {
+        /*
+         * TAG_MASK visualization
+         * 1. 0b0000000000000000000000000000000000000000000000000000000000000001
+         * 2. 0b0000000000000000000000000000000000000000000000000000000010000000
+         * 3. 0b0000000000000000000000000000000000000000000000000000000001111111
+         * 4. 0b1111111000000000000000000000000000000000000000000000000000000000
+         */
+        static constexpr int TAG_SHIFT     = 57;
+        static constexpr int TAG_BITS      = 64 - TAG_SHIFT;
+        static constexpr uint64_t TAG_MASK = ((1ull << TAG_BITS) - 1) << TAG_SHIFT;
+        static constexpr uint64_t PTR_MASK = ~TAG_MASK;
+
         //region const dispatch
         template<typename F, typename R, typename T>
         JTX_HOSTDEV R dispatch(F &&f, const void *ptr, int tag) {
@@ -397,17 +412,10 @@ namespace jtx {
       }
 
     private:
-      /*
-       * TAG_MASK visualization
-       * 1. 0b0000000000000000000000000000000000000000000000000000000000000001
-       * 2. 0b0000000000000000000000000000000000000000000000000000000010000000
-       * 3. 0b0000000000000000000000000000000000000000000000000000000001111111
-       * 4. 0b1111111000000000000000000000000000000000000000000000000000000000
-       */
-      static constexpr int TAG_SHIFT     = 57;
-      static constexpr int TAG_BITS      = 64 - TAG_SHIFT;
-      static constexpr uint64_t TAG_MASK = ((1ull << TAG_BITS) - 1) << TAG_SHIFT;
-      static constexpr uint64_t PTR_MASK = ~TAG_MASK;
+      static constexpr int TAG_SHIFT     = detail::TAG_SHIFT;
+      static constexpr int TAG_BITS      = detail::TAG_BITS;
+      static constexpr uint64_t TAG_MASK = detail::TAG_MASK;
+      static constexpr uint64_t PTR_MASK = detail::PTR_MASK;
 
       template <typename T, typename U, typename ...Us>
       JTX_HOSTDEV static constexpr int getTagIndex() {
@@ -423,4 +431,99 @@ namespace jtx {
 
       uint64_t fptr = 0;
     };
+    /**
+     * Atomic pointer with an ABA version counter packed into the unused pointer bits.
+     *
+     * The counter is split across the same high bits TaggedPtr uses for its type tag (above TAG_SHIFT)
+     * and the low bits that are always zero due to alignof(T). Every successful compare_exchange, store
+     * or exchange bumps the counter, so a node that is popped and pushed back between a load and a CAS
+     * no longer compares equal. This avoids needing a double-width CAS for lock-free stacks/free-lists.
+     *
+     * The counter wraps after 2^VERSION_BITS updates (1024 for 8-byte aligned T); over-align node types
+     * (e.g. alignas(64)) to widen it.
+     */
+    template <typename T>
+    class AtomicTaggedPtr {
+    public:
+      static constexpr int LOW_BITS         = std::countr_zero(alignof(T));
+      static constexpr int VERSION_BITS     = LOW_BITS + detail::TAG_BITS;
+      static constexpr uint64_t LOW_MASK    = (1ull << LOW_BITS) - 1;
+      static constexpr uint64_t VERSION_MASK = (1ull << VERSION_BITS) - 1;
+
+      // Snapshot of the pointer and its version, as returned by load()
+      class Value {
+      public:
+        JTX_HOST Value() = default;
+
+        [[nodiscard]] JTX_HOST T *ptr() const {
+          return reinterpret_cast<T *>(bits & detail::PTR_MASK & ~LOW_MASK);
+        }
+
+        [[nodiscard]] JTX_HOST uint64_t version() const {
+          return ((bits >> detail::TAG_SHIFT) << LOW_BITS) | (bits & LOW_MASK);
+        }
+
+        JTX_HOST bool operator==(const Value &v) const { return bits == v.bits; }
+        JTX_HOST bool operator!=(const Value &v) const { return bits != v.bits; }
+
+      private:
+        friend class AtomicTaggedPtr;
+        JTX_HOST explicit Value(uint64_t bits) : bits(bits) {}
+
+        uint64_t bits = 0;
+      };
+
+      //region Constructors
+      JTX_HOST AtomicTaggedPtr() = default;
+      JTX_HOST explicit AtomicTaggedPtr(T *ptr) : word(pack(ptr, 0)) {}
+
+      AtomicTaggedPtr(const AtomicTaggedPtr &) = delete;
+      AtomicTaggedPtr &operator=(const AtomicTaggedPtr &) = delete;
+      //endregion
+
+      [[nodiscard]] JTX_HOST Value load(std::memory_order order = std::memory_order_seq_cst) const {
+        return Value(word.load(order));
+      }
+
+      // Stores ptr with the next version
+      JTX_HOST void store(T *ptr, std::memory_order order = std::memory_order_seq_cst) {
+        exchange(ptr, order);
+      }
+
+      // Swaps in ptr with the next version and returns the previous value
+      JTX_HOST Value exchange(T *ptr, std::memory_order order = std::memory_order_seq_cst) {
+        Value expected = load(std::memory_order_relaxed);
+        while (!compare_exchange_weak(expected, ptr, order, std::memory_order_relaxed)) {}
+        return expected;
+      }
+
+      /**
+       * Replaces the stored value with desired (and expected.version() + 1) if it still matches expected
+       * On failure, expected is updated to the current value
+       */
+      JTX_HOST bool compare_exchange_weak(Value &expected, T *desired,
+                                          std::memory_order success = std::memory_order_seq_cst,
+                                          std::memory_order failure = std::memory_order_seq_cst) {
+        return word.compare_exchange_weak(expected.bits, pack(desired, expected.version() + 1), success, failure);
+      }
+
+      JTX_HOST bool compare_exchange_strong(Value &expected, T *desired,
+                                            std::memory_order success = std::memory_order_seq_cst,
+                                            std::memory_order failure = std::memory_order_seq_cst) {
+        return word.compare_exchange_strong(expected.bits, pack(desired, expected.version() + 1), success, failure);
+      }
+
+      [[nodiscard]] JTX_HOST bool is_lock_free() const { return word.is_lock_free(); }
+
+    private:
+      JTX_HOST static uint64_t pack(T *ptr, uint64_t version) {
+        auto p = reinterpret_cast<uint64_t>(ptr);
+        ASSERT((p & detail::PTR_MASK) == p);
+        ASSERT((p & LOW_MASK) == 0);
+        version &= VERSION_MASK;
+        return p | (version & LOW_MASK) | ((version >> LOW_BITS) << detail::TAG_SHIFT);
+      }
+
+      std::atomic<uint64_t> word = 0;
+    };
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <jtxlib/simd/avxfloat.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+
+using namespace jtx;
+
+static AVXFloat iota(float start, float step) {
+    alignas(32) float v[8];
+    for (int i = 0; i < 8; ++i) v[i] = start + step * static_cast<float>(i);
+    return AVXFloat::load(v);
+}
+
+TEST_CASE("AVXFloat arithmetic", "[AVXFloat]") {
+    AVXFloat a = iota(1.0f, 1.0f);
+    AVXFloat b(2.0f);
+
+    AVXFloat sub = a - b;
+    AVXFloat div = a / b;
+    AVXFloat neg = -a;
+    AVXFloat f = fma(a, b, AVXFloat(1.0f));
+    AVXFloat g = fms(a, b, AVXFloat(1.0f));
+    for (size_t i = 0; i < AVXFloat::size; ++i) {
+        float x = static_cast<float>(i + 1);
+        REQUIRE(sub[i] == x - 2.0f);
+        REQUIRE(div[i] == x / 2.0f);
+        REQUIRE(neg[i] == -x);
+        REQUIRE(f[i] == x * 2.0f + 1.0f);
+        REQUIRE(g[i] == x * 2.0f - 1.0f);
+    }
+
+    AVXFloat c = a;
+    c += b;
+    c *= b;
+    c -= b;
+    c /= b;
+    for (size_t i = 0; i < AVXFloat::size; ++i) REQUIRE(c[i] == ((a[i] + 2.0f) * 2.0f - 2.0f) / 2.0f);
+}
+
+TEST_CASE("AVXFloat math functions", "[AVXFloat]") {
+    AVXFloat a = iota(-1.75f, 0.5f);
+
+    AVXFloat lo = min(a, AVXFloat(0.0f));
+    AVXFloat hi = max(a, AVXFloat(0.0f));
+    AVXFloat ab = abs(a);
+    AVXFloat fl = floor(a);
+    AVXFloat ce = ceil(a);
+    AVXFloat ro = round(a);
+    for (size_t i = 0; i < AVXFloat::size; ++i) {
+        REQUIRE(lo[i] == std::min(a[i], 0.0f));
+        REQUIRE(hi[i] == std::max(a[i], 0.0f));
+        REQUIRE(ab[i] == std::abs(a[i]));
+        REQUIRE(fl[i] == std::floor(a[i]));
+        REQUIRE(ce[i] == std::ceil(a[i]));
+        REQUIRE(ro[i] == std::nearbyint(a[i]));
+    }
+
+    AVXFloat p = iota(0.5f, 3.0f);
+    AVXFloat sq = sqrt(p);
+    AVXFloat r = rcp(p);
+    AVXFloat rs = rsqrt(p);
+    AVXFloat rFast = rcp<false>(p);
+    for (size_t i = 0; i < AVXFloat::size; ++i) {
+        REQUIRE(sq[i] == std::sqrt(p[i]));
+        REQUIRE_THAT(r[i], Catch::Matchers::WithinRel(1.0f / p[i], 1e-6f));
+        REQUIRE_THAT(rs[i], Catch::Matchers::WithinRel(1.0f / std::sqrt(p[i]), 1e-6f));
+        REQUIRE_THAT(rFast[i], Catch::Matchers::WithinRel(1.0f / p[i], 1e-3f));
+    }
+}
+
+TEST_CASE("AVXMask comparisons and select", "[AVXFloat]") {
+    AVXFloat a = iota(0.0f, 1.0f);
+    AVXFloat b(3.0f);
+
+    REQUIRE((a < b).movemask() == 0b00000111);
+    REQUIRE((a <= b).movemask() == 0b00001111);
+    REQUIRE((a > b).movemask() == 0b11110000);
+    REQUIRE((a >= b).movemask() == 0b11111000);
+    REQUIRE((a == b).movemask() == 0b00001000);
+    REQUIRE((a != b).movemask() == 0b11110111);
+
+    AVXMask m = a < b;
+    REQUIRE(m.any());
+    REQUIRE(!m.all());
+    REQUIRE(!m.none());
+    REQUIRE(m[0]);
+    REQUIRE(!m[7]);
+    REQUIRE((~m).movemask() == 0b11111000);
+    REQUIRE((m & (a > AVXFloat(0.0f))).movemask() == 0b00000110);
+    REQUIRE((m | (a == AVXFloat(7.0f))).movemask() == 0b10000111);
+    REQUIRE((m ^ m).none());
+    REQUIRE(AVXMask(true).all());
+
+    // NaN compares unordered
+    REQUIRE((AVXFloat(NAN) == AVXFloat(NAN)).none());
+    REQUIRE((AVXFloat(NAN) != AVXFloat(NAN)).all());
+
+    AVXFloat s = select(m, a, -a);
+    for (size_t i = 0; i < AVXFloat::size; ++i) REQUIRE(s[i] == (a[i] < 3.0f ? a[i] : -a[i]));
+}
+
+TEST_CASE("AVXVec3f load8 and store8", "[AVXFloat]") {
+    Vec3f src[8], dst[8];
+    for (int i = 0; i < 8; ++i) src[i] = {static_cast<float>(i), -static_cast<float>(i), 0.5f * static_cast<float>(i)};
+
+    AVXVec3f v = load8(src);
+    REQUIRE(v.x[5] == 5.0f);
+    REQUIRE(v.y[7] == -7.0f);
+    REQUIRE(v.z[2] == 1.0f);
+
+    store8(dst, v);
+    for (int i = 0; i < 8; ++i) REQUIRE(dst[i] == src[i]);
+}
+
+TEST_CASE("AVXMat4 inverse8 and mul8", "[AVXFloat]") {
+    Mat4 src[8], inv[8], prod[8];
+    for (int i = 0; i < 8; ++i) src[i] = jtx::rotate(15.0f * static_cast<float>(i), Vec3f(0, 1, 1)) * jtx::scale(2.0f);
+
+    AVXMat4 m = load8(src);
+    AVXMask ok;
+    store8(inv, inverse8(m, &ok));
+    store8(prod, mul8(m, inverse8(m)));
+    AVXFloat det = determinant8(m);
+
+    REQUIRE(ok.all());
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE_THAT(det[i], Catch::Matchers::WithinRel(8.0f, 1e-5f));
+        REQUIRE(inv[i].equals(*src[i].inverse(), 1e-5f));
+        REQUIRE(prod[i].equals(Mat4(1.0f), 1e-5f));
+    }
+}
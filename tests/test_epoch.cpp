@@ -0,0 +1,143 @@
+#include <jtxlib/util/epoch.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace jtx;
+
+// Forwards to new_delete_resource() and counts outstanding allocations
+class CountingResource final : public pmr::memory_resource {
+public:
+    std::atomic<int> live{0};
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        ++live;
+        return pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        --live;
+        pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const memory_resource &other) const noexcept override { return this == &other; }
+};
+
+struct Node {
+    int value;
+    std::atomic<int> *destroyed;
+
+    Node(int value, std::atomic<int> *destroyed) : value(value), destroyed(destroyed) {}
+    ~Node() { ++*destroyed; }
+};
+
+TEST_CASE("EpochDomain defers frees while pinned", "[EpochDomain]") {
+    CountingResource res;
+    std::atomic<int> destroyed{0};
+    {
+        EpochDomain domain(&res);
+        Node *n = domain.create<Node>(1, &destroyed);
+
+        SECTION("Retired node survives while a guard is held") {
+            auto guard = domain.pin();
+            domain.retire(n);
+            for (int i = 0; i < 4; ++i) domain.collect();
+            REQUIRE(destroyed == 0);
+            REQUIRE(n->value == 1);
+        }
+
+        SECTION("Retired node is freed after two epochs") {
+            domain.retire(n);
+            uint64_t e = domain.epoch();
+            domain.collect();
+            domain.collect();
+            REQUIRE(domain.epoch() >= e + 2);
+            REQUIRE(destroyed == 1);
+        }
+
+        SECTION("Nested guards") {
+            domain.enter();
+            domain.enter();
+            domain.retire(n);
+            domain.exit();
+            for (int i = 0; i < 4; ++i) domain.collect();
+            REQUIRE(destroyed == 0);
+            domain.exit();
+            for (int i = 0; i < 4; ++i) domain.collect();
+            REQUIRE(destroyed == 1);
+        }
+    }
+    REQUIRE(destroyed == 1);
+    REQUIRE(res.live == 0);
+}
+
+TEST_CASE("EpochDomain concurrent readers and writers", "[EpochDomain]") {
+    CountingResource res;
+    std::atomic<int> destroyed{0};
+    constexpr int numReaders = 3;
+    constexpr int numWriters = 2;
+    constexpr int numIters = 5000;
+    int created = 1;
+    {
+        EpochDomain domain(&res);
+        std::atomic<Node *> shared{domain.create<Node>(0, &destroyed)};
+        std::atomic<bool> done{false};
+        std::atomic<bool> corrupted{false};
+
+        std::vector<std::thread> threads;
+        for (int r = 0; r < numReaders; ++r) {
+            threads.emplace_back([&] {
+                while (!done.load()) {
+                    auto guard = domain.pin();
+                    Node *n = shared.load(std::memory_order_acquire);
+                    if (n->value < 0) corrupted = true;
+                }
+            });
+        }
+
+        std::vector<std::thread> writers;
+        for (int w = 0; w < numWriters; ++w) {
+            writers.emplace_back([&] {
+                for (int i = 1; i <= numIters; ++i) {
+                    Node *n = domain.create<Node>(i, &destroyed);
+                    auto guard = domain.pin();
+                    Node *old = shared.exchange(n, std::memory_order_acq_rel);
+                    domain.retire(old);
+                }
+            });
+        }
+        for (auto &t: writers) t.join();
+        created += numWriters * numIters;
+        done = true;
+        for (auto &t: threads) t.join();
+
+        REQUIRE_FALSE(corrupted);
+        domain.retire(shared.load());
+    }
+    REQUIRE(destroyed == created);
+    REQUIRE(res.live == 0);
+}
+
+TEST_CASE("EpochDomain threads cycling through many domains", "[EpochDomain]") {
+    CountingResource res;
+    std::atomic<int> destroyed{0};
+    EpochDomain outer(&res);
+    Node *kept = outer.create<Node>(-1, &destroyed);
+
+    // Each domain is gone before the next one is created, possibly at the same address
+    constexpr int numDomains = 2000;
+    for (int i = 0; i < numDomains; ++i) {
+        EpochDomain domain(&res);
+        auto guard = domain.pin();
+        domain.retire(domain.create<Node>(i, &destroyed));
+        auto outerGuard = outer.pin();
+        REQUIRE(kept->value == -1);
+    }
+    REQUIRE(destroyed == numDomains);
+
+    outer.retire(kept);
+    for (int i = 0; i < 4; ++i) outer.collect();
+    REQUIRE(destroyed == numDomains + 1);
+}
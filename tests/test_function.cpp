@@ -0,0 +1,86 @@
+#include <jtxlib/util/inplacefunction.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+
+using namespace jtx;
+
+struct LifetimeCounter {
+    int *alive;
+
+    explicit LifetimeCounter(int *alive) : alive(alive) { ++*alive; }
+    LifetimeCounter(const LifetimeCounter &o) : alive(o.alive) { ++*alive; }
+    LifetimeCounter(LifetimeCounter &&o) noexcept : alive(o.alive) { ++*alive; }
+    ~LifetimeCounter() { --*alive; }
+};
+
+TEST_CASE("InplaceFunction basic calls", "[InplaceFunction]") {
+    SECTION("Empty function") {
+        InplaceFunction<int(int)> f;
+        REQUIRE_FALSE(f);
+        f = nullptr;
+        REQUIRE_FALSE(f);
+    }
+
+    SECTION("Lambda with captures") {
+        int a = 3, b = 4;
+        InplaceFunction<int(int)> f = [a, b](int x) { return a * x + b; };
+        REQUIRE(f);
+        REQUIRE(f(2) == 10);
+    }
+
+    SECTION("Function pointer") {
+        InplaceFunction<int(int, int), 16> f = +[](int x, int y) { return x - y; };
+        REQUIRE(f(5, 3) == 2);
+    }
+
+    SECTION("Reference arguments") {
+        InplaceFunction<void(int &)> f = [](int &x) { x = 42; };
+        int v = 0;
+        f(v);
+        REQUIRE(v == 42);
+    }
+
+    SECTION("Mutable state persists between calls") {
+        InplaceFunction<int()> f = [n = 0]() mutable { return ++n; };
+        f();
+        REQUIRE(f() == 2);
+    }
+}
+
+TEST_CASE("InplaceFunction copy and move", "[InplaceFunction]") {
+    int alive = 0;
+    {
+        InplaceFunction<int()> f = [c = LifetimeCounter(&alive)] { return *c.alive; };
+        REQUIRE(alive == 1);
+
+        InplaceFunction<int()> copy = f;
+        REQUIRE(alive == 2);
+        REQUIRE(copy() == 2);
+
+        InplaceFunction<int()> moved = std::move(f);
+        REQUIRE_FALSE(f);
+        REQUIRE(alive == 2);
+
+        copy = nullptr;
+        REQUIRE(alive == 1);
+
+        copy = moved;
+        REQUIRE(alive == 2);
+    }
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("MoveOnlyInplaceFunction accepts move-only captures", "[InplaceFunction]") {
+    auto p = std::make_unique<int>(7);
+    MoveOnlyInplaceFunction<int()> f = [p = std::move(p)] { return *p; };
+    REQUIRE(f() == 7);
+
+    MoveOnlyInplaceFunction<int()> g = std::move(f);
+    REQUIRE_FALSE(f);
+    REQUIRE(g() == 7);
+
+    static_assert(!std::is_copy_constructible_v<MoveOnlyInplaceFunction<int()>>);
+    static_assert(std::is_copy_constructible_v<InplaceFunction<int()>>);
+    static_assert(sizeof(InplaceFunction<void(), 32>) <= 32 + 2 * sizeof(void *) + alignof(std::max_align_t));
+}
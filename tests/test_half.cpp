@@ -0,0 +1,140 @@
+#include <jtxlib/math/half.hpp>
+#include <jtxlib/simd/simdhalf.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace jtx;
+
+using Width4 = std::integral_constant<int, 4>;
+using Width8 = std::integral_constant<int, 8>;
+using Width16 = std::integral_constant<int, 16>;
+
+// Finite values, ties, denormals, overflow and special values followed by random bit patterns
+static std::vector<float> halfTestInputs() {
+    std::vector<float> v = {0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 65519.99f, 65520.0f, 1e10f, -1e10f,
+                            0x1p-14f, 0x1p-24f, 0x1p-25f, 0x1.8p-25f, 0x1p-26f, 1e-30f, 1.0f + 0x1p-11f,
+                            1.0f + 0x3p-11f, std::numeric_limits<float>::infinity(),
+                            -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(),
+                            bitsToFloat(0x7F800001u), bitsToFloat(0xFFC12345u), bitsToFloat(0x00000001u)};
+    std::mt19937 rng(3);
+    for (int i = 0; i < 20000; ++i) v.push_back(bitsToFloat(static_cast<uint32_t>(rng())));
+    return v;
+}
+
+TEST_CASE("Half conversions", "[Half]") {
+    // Every finite half survives a round trip
+    for (uint32_t h = 0; h < 0x10000u; ++h) {
+        Half x = Half::fromBits(static_cast<uint16_t>(h));
+        if (x.isNaN()) continue;
+        REQUIRE(Half(float(x)).bits() == h);
+    }
+
+    REQUIRE(float(Half(1.0f)) == 1.0f);
+    REQUIRE(Half(1.0f).bits() == 0x3C00u);
+    REQUIRE(Half(-2.0f).bits() == 0xC000u);
+    REQUIRE(Half(65504.0f).bits() == 0x7BFFu);
+    REQUIRE(float(Half::fromBits(0x0001u)) == 0x1p-24f);
+    REQUIRE(float(Half::fromBits(0x03FFu)) == 0x3FFp-24f);
+
+    // Round to nearest even
+    REQUIRE(Half(1.0f + 0x1p-11f).bits() == 0x3C00u);
+    REQUIRE(Half(1.0f + 0x3p-11f).bits() == 0x3C02u);
+    REQUIRE(Half(0x1p-25f).bits() == 0x0000u);
+    REQUIRE(Half(0x1.8p-25f).bits() == 0x0001u);
+    REQUIRE(Half(65519.0f).bits() == 0x7BFFu);
+    REQUIRE(Half(65520.0f).isInf());
+
+    REQUIRE(Half(std::numeric_limits<float>::infinity()).bits() == 0x7C00u);
+    REQUIRE(Half(-1e10f).bits() == 0xFC00u);
+    REQUIRE(Half(std::numeric_limits<float>::quiet_NaN()).isNaN());
+    REQUIRE(Half(bitsToFloat(0x7F800001u)).bits() == 0x7E00u);
+    REQUIRE(std::isnan(float(Half::fromBits(0x7C01u))));
+    REQUIRE(Half(-0.0f).bits() == 0x8000u);
+    REQUIRE(Half(-0.0f) == Half(0.0f));
+    REQUIRE(Half(std::numeric_limits<float>::quiet_NaN()) != Half(std::numeric_limits<float>::quiet_NaN()));
+    REQUIRE((-Half(3.0f)).bits() == Half(-3.0f).bits());
+
+    Vec3f v(0.25f, -1.5f, 1000.0f);
+    REQUIRE(Vec3f(Vec3h(v)) == v);
+    Vec4f w(0.25f, -1.5f, 1000.0f, 2.0f);
+    REQUIRE(Vec4f(Vec4h(w)) == w);
+}
+
+TEST_CASE("BFloat16 conversions", "[Half]") {
+    REQUIRE(BFloat16(1.0f).bits() == 0x3F80u);
+    REQUIRE(float(BFloat16(3.0e38f)) > 2.9e38f);
+    REQUIRE(BFloat16(1.0f + 0x1p-8f).bits() == 0x3F80u);
+    REQUIRE(BFloat16(1.0f + 0x3p-8f).bits() == 0x3F82u);
+    REQUIRE(BFloat16(3.4e38f).isInf());
+    REQUIRE(BFloat16(std::numeric_limits<float>::quiet_NaN()).isNaN());
+    REQUIRE(BFloat16(bitsToFloat(0x7F800001u)).isNaN());
+    REQUIRE(float(BFloat16(-0.0f)) == 0.0f);
+
+    for (uint32_t b = 0; b < 0x10000u; ++b) {
+        BFloat16 x = BFloat16::fromBits(static_cast<uint16_t>(b));
+        if (x.isNaN()) continue;
+        REQUIRE(BFloat16(float(x)).bits() == b);
+    }
+}
+
+TEST_CASE("Half batch conversions", "[Half]") {
+    std::vector<float> in = halfTestInputs();
+    std::vector<Half> halves(in.size());
+    std::vector<BFloat16> bf(in.size());
+    toHalf(in, halves);
+    toBFloat16(in, bf);
+    for (size_t i = 0; i < in.size(); ++i) {
+        REQUIRE(halves[i].bits() == floatToHalfBits(in[i]));
+        REQUIRE(bf[i].bits() == floatToBFloat16Bits(in[i]));
+    }
+
+    std::vector<float> out(in.size()), bfOut(in.size());
+    toFloat(halves, out);
+    toFloat(bf, bfOut);
+    for (size_t i = 0; i < in.size(); ++i) {
+        REQUIRE(floatToBits(out[i]) == floatToBits(halfBitsToFloat(halves[i].bits())));
+        REQUIRE(floatToBits(bfOut[i]) == floatToBits(bfloat16BitsToFloat(bf[i].bits())));
+    }
+
+    std::vector<Vec3f> v3 = {{1, 2, 3}, {-0.5f, 0.25f, 8}, {100, -7, 0}};
+    std::vector<Vec3h> h3(v3.size());
+    std::vector<Vec3f> back3(v3.size());
+    toHalf(v3, h3);
+    toFloat(h3, back3);
+    REQUIRE(back3 == v3);
+    REQUIRE(h3[1] == Vec3h(v3[1]));
+
+    std::vector<Vec4f> v4 = {{1, 2, 3, 4}, {-0.5f, 0.25f, 8, 16}};
+    std::vector<Vec4h> h4(v4.size());
+    std::vector<Vec4f> back4(v4.size());
+    toHalf(v4, h4);
+    toFloat(h4, back4);
+    REQUIRE(back4 == v4);
+}
+
+TEMPLATE_TEST_CASE("SIMD half conversions", "[Half]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+    std::vector<float> in = halfTestInputs();
+    in.resize(in.size() / N * N);
+
+    for (size_t i = 0; i < in.size(); i += N) {
+        uint16_t h[N], b[N];
+        storeHalf(h, SimdFloat<N>::loadu(in.data() + i));
+        storeBFloat16(b, SimdFloat<N>::loadu(in.data() + i));
+        alignas(64) float back[N], bfBack[N];
+        loadHalf<N>(h).store(back);
+        loadBFloat16<N>(b).store(bfBack);
+        for (int k = 0; k < N; ++k) {
+            REQUIRE(h[k] == floatToHalfBits(in[i + k]));
+            REQUIRE(b[k] == floatToBFloat16Bits(in[i + k]));
+            REQUIRE(floatToBits(back[k]) == floatToBits(halfBitsToFloat(h[k])));
+            REQUIRE(floatToBits(bfBack[k]) == floatToBits(bfloat16BitsToFloat(b[k])));
+        }
+    }
+}
@@ -0,0 +1,326 @@
+#include <jtxlib/simd/kernels.hpp>
+#include <jtxlib/math/bounds.hpp>
+#include <jtxlib/math/half.hpp>
+#include <jtxlib/math/spherical.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace jtx;
+
+// Every table the CPU can run, the scalar one is always first
+static std::vector<const KernelTable *> supportedTables() {
+    std::vector<const KernelTable *> tables;
+    for (SimdIsa isa: {SimdIsa::Scalar, SimdIsa::AVX2, SimdIsa::AVX512}) {
+        if (const KernelTable *t = simdKernels(isa)) tables.push_back(t);
+    }
+    return tables;
+}
+
+TEST_CASE("CPU feature detection", "[Kernels]") {
+    const CpuFeatures &f = cpuFeatures();
+    // Implied features must be consistent
+    if (f.avx2) REQUIRE(f.avx);
+    if (f.avx512f) REQUIRE(f.avx);
+    REQUIRE(isSupported(SimdIsa::Scalar));
+    REQUIRE(isSupported(detectSimdIsa()));
+    REQUIRE(simdKernels().isa <= detectSimdIsa());
+    REQUIRE(simdKernels(SimdIsa::Scalar) != nullptr);
+}
+
+TEST_CASE("Kernel batch transform points", "[Kernels]") {
+    Mat4 m(1, 2, 0, 3,
+           0, 1, 4, -1,
+           2, 0, 1, 0.5f,
+           0.1f, 0, 0, 1);
+    constexpr size_t n = 37;
+    std::vector<float> x(n), y(n), z(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = static_cast<float>(i) * 0.5f - 4.0f;
+        y[i] = static_cast<float>(i % 7);
+        z[i] = -static_cast<float>(i) * 0.25f;
+    }
+
+    for (const KernelTable *t: supportedTables()) {
+        INFO(toString(t->isa));
+        std::vector<float> ox(n), oy(n), oz(n);
+        t->transformPoints(m, x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            Point3f p = m.applyToPoint(Point3f(x[i], y[i], z[i]));
+            REQUIRE_THAT(ox[i], Catch::Matchers::WithinRel(p.x, 1e-5f) || Catch::Matchers::WithinAbs(p.x, 1e-5f));
+            REQUIRE_THAT(oy[i], Catch::Matchers::WithinRel(p.y, 1e-5f) || Catch::Matchers::WithinAbs(p.y, 1e-5f));
+            REQUIRE_THAT(oz[i], Catch::Matchers::WithinRel(p.z, 1e-5f) || Catch::Matchers::WithinAbs(p.z, 1e-5f));
+        }
+    }
+}
+
+TEST_CASE("Kernel batch transform vectors and packed arrays", "[Kernels]") {
+    Mat4 affine = jtx::rotate(30.0f, Vec3f(1, 2, 3)) * jtx::translate(1.0f, -2.0f, 0.5f);
+    Mat4 projective = jtx::perspective(60.0f, 1.5f, 0.1f, 100.0f);
+    constexpr size_t n = 29;
+    std::vector<Vec3f> in(n);
+    for (size_t i = 0; i < n; ++i) {
+        auto f = static_cast<float>(i);
+        in[i] = Vec3f(f * 0.5f - 4.0f, static_cast<float>(i % 5), -f * 0.25f - 1.0f);
+    }
+
+    auto near = [](const Vec3f &a, const Vec3f &b) {
+        auto close = [](float x, float y) { return std::abs(x - y) <= 1e-5f * std::max(1.0f, std::abs(y)); };
+        return close(a.x, b.x) && close(a.y, b.y) && close(a.z, b.z);
+    };
+
+    for (const KernelTable *t: supportedTables()) {
+        INFO(toString(t->isa));
+        for (const Mat4 &m: {affine, projective}) {
+            std::vector<Vec3f> points = in, vecs(n);
+            // In place for points, separate output for vectors
+            t->transformPointsAoS(m, &points[0].x, &points[0].x, n);
+            t->transformVectorsAoS(m, &in[0].x, &vecs[0].x, n);
+
+            std::vector<float> x(n), y(n), z(n);
+            for (size_t i = 0; i < n; ++i) x[i] = in[i].x, y[i] = in[i].y, z[i] = in[i].z;
+            t->transformVectors(m, x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), n);
+
+            for (size_t i = 0; i < n; ++i) {
+                REQUIRE(near(points[i], m.applyToPoint(in[i])));
+                REQUIRE(near(vecs[i], m.applyToVec(in[i])));
+                REQUIRE(near(Vec3f(x[i], y[i], z[i]), m.applyToVec(in[i])));
+            }
+        }
+    }
+}
+
+TEST_CASE("Kernel batch transform boxes", "[Kernels]") {
+    Mat4 affine = jtx::rotate(30.0f, Vec3f(1, 2, 3)) * jtx::scale(1.0f, -2.0f, 0.5f) * jtx::translate(1, 2, 3);
+    Mat4 projective = jtx::perspective(60.0f, 1.5f, 0.1f, 100.0f);
+    constexpr size_t n = 19;
+    std::vector<BBox3f> in;
+    for (size_t i = 0; i < n; ++i) {
+        auto f = static_cast<float>(i);
+        in.emplace_back(Point3f(f - 5.0f, -f, -20.0f - f), Point3f(f - 3.0f, 2.0f * f, -10.0f));
+    }
+    in[7] = BBox3f();
+
+    for (const KernelTable *t: supportedTables()) {
+        INFO(toString(t->isa));
+        std::vector<BBox3f> out(n);
+        t->transformBoxes(affine, &in[0].pmin.x, &out[0].pmin.x, n);
+        for (size_t i = 0; i < n; ++i) REQUIRE(out[i] == affine.applyToBBox(in[i]));
+
+        t->transformBoxes(projective, &in[0].pmin.x, &out[0].pmin.x, n);
+        for (size_t i = 0; i < n; ++i) REQUIRE(out[i].equals(projective.applyToBBox(in[i]), 1e-4f));
+
+        // Every tail length, from exactly sized buffers so the masked gathers can't read past the end
+        for (size_t count = 1; count < n; ++count) {
+            std::vector<BBox3f> part(in.begin(), in.begin() + static_cast<ptrdiff_t>(count)), partOut(count);
+            t->transformBoxes(affine, &part[0].pmin.x, &partOut[0].pmin.x, count);
+            for (size_t i = 0; i < count; ++i) REQUIRE(partOut[i] == affine.applyToBBox(part[i]));
+        }
+    }
+}
+
+TEST_CASE("Kernel batch matrix inverse", "[Kernels]") {
+    constexpr size_t n = 21;
+    std::vector<Mat4> in;
+    for (size_t i = 0; i < n; ++i) {
+        auto f = static_cast<float>(i);
+        in.push_back(jtx::rotate(5.0f * f, Vec3f(f, 1.0f, -1.0f)) * jtx::translate(f, 2.0f, -f) *
+                     jtx::scale(1.0f, 1.0f + 0.1f * f, 3.0f));
+    }
+    in[4] = Mat4();
+    in[17][2][2] = 0.0f, in[17][2][0] = 0.0f, in[17][2][1] = 0.0f, in[17][2][3] = 0.0f;
+
+    for (const KernelTable *t: supportedTables()) {
+        INFO(toString(t->isa));
+        std::vector<Mat4> out(n);
+        std::vector<uint8_t> ok(n);
+        REQUIRE(t->invertMatrices(in.data(), out.data(), ok.data(), n) == n - 2);
+        for (size_t i = 0; i < n; ++i) {
+            auto ref = in[i].inverse();
+            REQUIRE(static_cast<bool>(ok[i]) == ref.has_value());
+            if (ref) REQUIRE(out[i].equals(*ref, 1e-4f));
+            else REQUIRE(out[i].hasNaN());
+        }
+    }
+}
+
+TEST_CASE("Kernel ray-box intersection", "[Kernels]") {
+    constexpr size_t n = 45;
+    std::vector<float> b[6];
+    for (auto &v: b) v.resize(n);
+    std::vector<BBox3f> ref;
+    for (size_t i = 0; i < n; ++i) {
+        float f = static_cast<float>(i);
+        Point3f lo(f - 20.0f, -1.0f + 0.1f * f, -2.0f);
+        Point3f hi(f - 19.0f, 1.0f + 0.1f * f, 2.0f);
+        // A few degenerate boxes lying on the ray's origin plane
+        if (i % 11 == 0) hi.y = lo.y = 0.0f;
+        ref.emplace_back(lo, hi);
+        b[0][i] = lo.x, b[1][i] = lo.y, b[2][i] = lo.z;
+        b[3][i] = hi.x, b[4][i] = hi.y, b[5][i] = hi.z;
+    }
+    BoxesSoA boxes{b[0].data(), b[1].data(), b[2].data(), b[3].data(), b[4].data(), b[5].data()};
+
+    Point3f o(0.0f, 0.0f, 0.0f);
+    Vec3f d(1.0f, 0.0f, 0.25f);
+    float tMax = 12.0f;
+    const float origin[3] = {o.x, o.y, o.z};
+    const float invDir[3] = {1 / d.x, 1 / d.y, 1 / d.z};
+
+    size_t expectedHits = 0;
+    for (const auto &box: ref) expectedHits += box.intersectP(o, d, tMax, nullptr, nullptr);
+    REQUIRE(expectedHits > 0);
+    REQUIRE(expectedHits < n);
+
+    for (const KernelTable *t: supportedTables()) {
+        INFO(toString(t->isa));
+        std::vector<uint8_t> hit(n);
+        std::vector<float> tHit(n);
+        REQUIRE(t->intersectRayBoxes(origin, invDir, tMax, boxes, n, hit.data(), tHit.data()) == expectedHits);
+        for (size_t i = 0; i < n; ++i) {
+            float t0;
+            bool h = ref[i].intersectP(o, d, tMax, &t0, nullptr);
+            REQUIRE(static_cast<bool>(hit[i]) == h);
+            if (h) REQUIRE(tHit[i] == t0);
+        }
+    }
+}
+
+TEST_CASE("Kernel random fill", "[Kernels]") {
+    constexpr size_t n = 1003;
+    std::vector<float> ref(n);
+    simdKernels(SimdIsa::Scalar)->fillRandom(ref.data(), n, 0x1234567890ull, 0);
+
+    double sum = 0;
+    for (float u: ref) {
+        REQUIRE(u >= 0.0f);
+        REQUIRE(u < 1.0f);
+        sum += u;
+    }
+    REQUIRE(std::abs(sum / n - 0.5) < 0.05);
+
+    for (const KernelTable *t: supportedTables()) {
+        INFO(toString(t->isa));
+        std::vector<float> out(n);
+        t->fillRandom(out.data(), n, 0x1234567890ull, 0);
+        REQUIRE(out == ref);
+
+        // A sub-range with an offset reproduces the same values
+        std::vector<float> part(100);
+        t->fillRandom(part.data(), part.size(), 0x1234567890ull, 500);
+        REQUIRE(std::equal(part.begin(), part.end(), ref.begin() + 500));
+    }
+
+    std::vector<float> other(n);
+    fillRandom(other.data(), n, 42);
+    REQUIRE(other != ref);
+}
+
+TEST_CASE("Kernel half and bfloat16 conversions", "[Kernels]") {
+    // Every 16-bit pattern, the odd length exercises the tail
+    constexpr size_t n = 0x10000 - 3;
+    std::vector<uint16_t> bits(n);
+    std::vector<float> in(n);
+    for (size_t i = 0; i < n; ++i) {
+        bits[i] = static_cast<uint16_t>(i);
+        in[i] = bitsToFloat(static_cast<uint32_t>(i * 0x10001u) ^ 0x5A5A0000u);
+    }
+
+    for (const KernelTable *t: supportedTables()) {
+        INFO(toString(t->isa));
+        std::vector<float> f(n), bf(n);
+        t->halfToFloat(bits.data(), f.data(), n);
+        t->bfloat16ToFloat(bits.data(), bf.data(), n);
+        std::vector<uint16_t> h(n), b(n);
+        t->floatToHalf(in.data(), h.data(), n);
+        t->floatToBFloat16(in.data(), b.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            REQUIRE(floatToBits(f[i]) == floatToBits(halfBitsToFloat(bits[i])));
+            REQUIRE(floatToBits(bf[i]) == floatToBits(bfloat16BitsToFloat(bits[i])));
+            REQUIRE(h[i] == floatToHalfBits(in[i]));
+            REQUIRE(b[i] == floatToBFloat16Bits(in[i]));
+        }
+    }
+}
+
+TEST_CASE("Kernel octahedral encoding", "[Kernels]") {
+    // Fibonacci sphere plus the poles and axes, where the folding and sign handling matter
+    std::vector<Vec3f> dirs = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}, {0, -0.0f, -1}};
+    constexpr int count = 4093;
+    for (int i = 0; i < count; ++i) {
+        float z = 1 - 2 * (static_cast<float>(i) + 0.5f) / count;
+        float r = std::sqrt(1 - z * z);
+        float phi = static_cast<float>(i) * 2.39996323f;
+        dirs.emplace_back(r * std::cos(phi), r * std::sin(phi), z);
+    }
+    for (Vec3f &d: dirs) d.Normalize();
+    const size_t n = dirs.size();
+
+    for (const KernelTable *t: supportedTables()) {
+        INFO(toString(t->isa));
+        std::vector<OctahedralVec> oct(n);
+        std::vector<OctahedralVec8> oct8(n);
+        t->encodeOctahedral16(reinterpret_cast<const float *>(dirs.data()), reinterpret_cast<uint16_t *>(oct.data()), n);
+        t->encodeOctahedral8(reinterpret_cast<const float *>(dirs.data()), reinterpret_cast<uint8_t *>(oct8.data()), n);
+
+        std::vector<Vec3f> dec(n), dec8(n);
+        t->decodeOctahedral16(reinterpret_cast<const uint16_t *>(oct.data()), reinterpret_cast<float *>(dec.data()), n);
+        t->decodeOctahedral8(reinterpret_cast<const uint8_t *>(oct8.data()), reinterpret_cast<float *>(dec8.data()), n);
+
+        for (size_t i = 0; i < n; ++i) {
+            REQUIRE(oct[i] == OctahedralVec(dirs[i]));
+            REQUIRE(oct8[i] == OctahedralVec8(dirs[i]));
+            REQUIRE(dec[i].equals(Vec3f(oct[i]), 1e-6f));
+            REQUIRE(dec8[i].equals(Vec3f(oct8[i]), 1e-6f));
+
+            // Angular error of the round trip
+            REQUIRE(dec[i].cross(dirs[i]).Length() < 1e-4f);
+            REQUIRE(dec8[i].cross(dirs[i]).Length() < 2e-2f);
+        }
+    }
+
+    std::vector<OctahedralVec> oct(n);
+    std::vector<Vec3f> dec(n);
+    EncodeOctahedral(dirs, oct);
+    DecodeOctahedral(oct, dec);
+    REQUIRE(dec[0].equals(dirs[0], 1e-4f));
+}
+
+TEST_CASE("Kernel equal-area square-sphere mapping", "[Kernels]") {
+    // Grid over the square including the edges, center and diagonals
+    constexpr int res = 61;
+    std::vector<Point2f> square;
+    for (int j = 0; j <= res; ++j) {
+        for (int i = 0; i <= res; ++i) square.emplace_back(static_cast<float>(i) / res, static_cast<float>(j) / res);
+    }
+    const size_t n = square.size();
+
+    std::vector<Point2f> outside = {{-0.25f, 0.5f}, {1.25f, 0.25f}, {0.5f, -0.5f}, {0.75f, 1.5f}, {-0.1f, 1.2f},
+                                    {1.3f, -0.4f}, {0.5f, 0.5f}};
+
+    for (const KernelTable *t: supportedTables()) {
+        INFO(toString(t->isa));
+        std::vector<Vec3f> dirs(n);
+        std::vector<Point2f> back(n);
+        t->equalAreaSquareToSphere(reinterpret_cast<const float *>(square.data()), reinterpret_cast<float *>(dirs.data()), n);
+        t->equalAreaSphereToSquare(reinterpret_cast<const float *>(dirs.data()), reinterpret_cast<float *>(back.data()), n);
+
+        for (size_t i = 0; i < n; ++i) {
+            Vec3f d = EqualAreaSquareToSphere(square[i]);
+            REQUIRE(dirs[i].equals(d, 1e-6f));
+            Point2f p = EqualAreaSphereToSquare(d);
+            REQUIRE(back[i].equals(p, 1e-5f));
+        }
+
+        std::vector<Point2f> wrapped = outside;
+        t->wrapEqualAreaSquare(reinterpret_cast<const float *>(wrapped.data()), reinterpret_cast<float *>(wrapped.data()),
+                               wrapped.size());
+        for (size_t i = 0; i < outside.size(); ++i) REQUIRE(wrapped[i] == WrapEqualAreaSquare(outside[i]));
+    }
+
+    std::vector<Vec3f> dirs(n);
+    EqualAreaSquareToSphere(square, dirs);
+    REQUIRE(dirs[n / 2].equals(EqualAreaSquareToSphere(square[n / 2]), 1e-6f));
+}
@@ -4,6 +4,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include <vector>
+
 TEST_CASE("Mat4 default constructor is identity matrix", "[Mat4]") {
     jtx::Mat4 mat{1.0f};
     for (int i = 0; i < 4; i++) {
@@ -176,6 +178,62 @@ TEST_CASE("Mat4 inverse", "[Mat4]") {
     REQUIRE(mat * inv == identity);
 }
 
+TEST_CASE("Mat4 mulFast and inverseFast", "[Mat4]") {
+    jtx::Mat4 a{2, 1, 0, 3, 4, -1, 2, 0, -3, 2, 1, 5, 1, 0, -2, 3};
+    jtx::Mat4 b = jtx::rotate(30.0f, jtx::Vec3f{1, 2, 3}) * jtx::translate(1.0f, -2.0f, 0.5f);
+    jtx::Mat4 identity{1.0f};
+
+    SECTION("mulFast matches mul") {
+        REQUIRE(jtx::mulFast(identity, a) == a);
+        REQUIRE(a.mulFast(b).equals(a.mul(b), T_EPS));
+        REQUIRE(b.mulFast(a).equals(b.mul(a), T_EPS));
+    }
+
+    SECTION("inverseFast matches inverse") {
+        jtx::Mat4 mat{1, 1, 1, -1, 1, 1, -1, 1, 1, -1, 1, 1, -1, 1, 1, 1};
+        REQUIRE(jtx::inverseFast(mat).value() == jtx::invert(mat));
+
+        for (const jtx::Mat4 &m: {a, b, jtx::perspective(60.0f, 1.5f, 0.1f, 100.0f)}) {
+            auto inv = m.inverseFast();
+            REQUIRE(inv.has_value());
+            REQUIRE(inv->equals(m.inverse().value(), T_EPS));
+            REQUIRE(m.mul(*inv).equals(identity, T_EPS));
+        }
+    }
+
+    SECTION("Singular matrix") {
+        jtx::Mat4 m{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+        m[3][3] = 0.0f;
+        m[2][0] = m[2][1] = m[2][2] = m[2][3] = 0.0f;
+        REQUIRE_FALSE(m.inverseFast().has_value());
+    }
+}
+
+TEST_CASE("Mat4 rounding policies", "[Mat4]") {
+    jtx::Mat4 a{2, 1, 0, 3, 4, -1, 2, 0, -3, 2, 1, 5, 1, 0, -2, 3};
+    jtx::Mat4 b = jtx::rotate(30.0f, jtx::Vec3f{1, 2, 3}) * jtx::translate(1.0f, -2.0f, 0.5f);
+
+    // Small integers are exact either way
+    REQUIRE(a.determinant<jtx::Fast>() == -85.0f);
+    REQUIRE(a.mul<jtx::Fast>(a) == a.mul<jtx::Precise>(a));
+    REQUIRE(a.mul<jtx::Fast>(b).equals(a.mulFast(b), T_EPS));
+    REQUIRE(jtx::mul<jtx::Fast>(b, jtx::Vec4f(1, 2, 3, 1)).equals(b.mul(jtx::Vec4f(1, 2, 3, 1)), T_EPS));
+
+    jtx::Mat4 mat{1, 1, 1, -1, 1, 1, -1, 1, 1, -1, 1, 1, -1, 1, 1, 1};
+    REQUIRE(mat.inverse<jtx::Fast>().value() == jtx::invert(mat));
+    REQUIRE(jtx::inverse<jtx::Fast>(b).value().equals(b.inverse().value(), T_EPS));
+
+    // det = (1 + 2^-12)^2 - (1 + 2^-11) = 2^-24, only the compensated products keep it
+    const float x = 1.0f + 0x1p-12f;
+    jtx::Mat4 m = jtx::Mat4::identity();
+    m[0][0] = m[1][1] = x;
+    m[0][1] = 1.0f + 0x1p-11f;
+    m[1][0] = 1.0f;
+    REQUIRE(m.determinant() == 0x1p-24f);
+    REQUIRE(m.determinant<jtx::Precise>() == 0x1p-24f);
+    REQUIRE(m.inverse().has_value());
+}
+
 TEST_CASE("Mat4 Linear LS", "[Mat4]") {
     // TODO: write linear LS equation
 }
@@ -366,6 +424,68 @@ TEST_CASE("Transform matrix constructor", "[Transform]") {
     }
 }
 
+TEST_CASE("Transform fast construction and composition", "[Transform]") {
+    jtx::Mat4 m = jtx::rotate(45.0f, jtx::Vec3f{0, 1, 1}) * jtx::scale(2.0f, 3.0f, 4.0f);
+    jtx::Transform t = jtx::Transform::fromMatrixFast(m);
+    jtx::Transform ref{m};
+    REQUIRE(t.getMatrix() == m);
+    REQUIRE(t.getInverseMatrix().equals(ref.getInverseMatrix(), T_EPS));
+
+    jtx::Transform composed = t.mulFast(jtx::Transform::translate(1.0f, 2.0f, 3.0f));
+    jtx::Transform composedRef = ref * jtx::Transform::translate(1.0f, 2.0f, 3.0f);
+    REQUIRE(composed.getMatrix().equals(composedRef.getMatrix(), T_EPS));
+    REQUIRE(composed.getInverseMatrix().equals(composedRef.getInverseMatrix(), T_EPS));
+
+    jtx::Mat4 singular{1.0f};
+    singular[1][1] = 0.0f;
+    REQUIRE(jtx::Transform::fromMatrixFast(singular).getInverseMatrix().hasNaN());
+}
+
+TEST_CASE("Transform batch apply", "[Transform]") {
+    jtx::Transform t = jtx::Transform::rotate(40.0f, jtx::Vec3f{1, 1, 0}) * jtx::Transform::scale(1.0f, 2.0f, 0.5f) *
+                       jtx::Transform::translate(3.0f, 0.0f, -1.0f);
+    std::vector<jtx::Vec3f> in;
+    for (int i = 0; i < 21; ++i) in.emplace_back(static_cast<float>(i) - 10.0f, 0.5f * static_cast<float>(i), 1.0f);
+
+    std::vector<jtx::Point3f> points(in.size());
+    std::vector<jtx::Vec3f> vecs(in.size());
+    std::vector<jtx::Normal3f> normals(in.size());
+    t.applyToPoints(in, points);
+    t.applyToVecs(in, vecs);
+    t.applyToNormals(in, normals);
+
+    std::vector<float> x, y, z;
+    for (const auto &v: in) x.push_back(v.x), y.push_back(v.y), z.push_back(v.z);
+    t.applyToNormals(x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), in.size());
+
+    for (size_t i = 0; i < in.size(); ++i) {
+        REQUIRE(points[i].equals(t.applyToPoint(in[i]), T_EPS));
+        REQUIRE(vecs[i].equals(t.applyToVec(in[i]), T_EPS));
+        REQUIRE(normals[i].equals(t.applyToNormal(in[i]), T_EPS));
+        REQUIRE(jtx::Vec3f(x[i], y[i], z[i]).equals(t.applyToNormal(in[i]), T_EPS));
+    }
+}
+
+TEST_CASE("Transform applyToBBox matches the corners", "[Transform]") {
+    jtx::Transform t = jtx::Transform::rotate(25.0f, jtx::Vec3f{0, 1, 2}) * jtx::Transform::scale(2.0f, -1.0f, 3.0f) *
+                       jtx::Transform::translate(-1.0f, 4.0f, 0.5f);
+    std::vector<jtx::BBox3f> boxes{{jtx::Point3f{1, 2, 3}, jtx::Point3f{4, 5, 6}},
+                                   {jtx::Point3f{-1, -1, -1}, jtx::Point3f{1, 1, 1}},
+                                   {jtx::Point3f{0, 0, 0}, jtx::Point3f{0, 0, 0}}};
+
+    for (const auto &b: boxes) {
+        jtx::BBox3f ref;
+        for (int i = 0; i < 8; ++i) ref = ref.merge(t.applyToPoint(b.corner(i)));
+        REQUIRE(t.applyToBBox(b).equals(ref, T_EPS));
+    }
+
+    boxes.emplace_back();
+    std::vector<jtx::BBox3f> out(boxes.size());
+    t.applyToBBoxes(boxes, out);
+    for (size_t i = 0; i < boxes.size(); ++i) REQUIRE(out[i] == t.applyToBBox(boxes[i]));
+    REQUIRE(out.back() == jtx::BBox3f());
+}
+
 TEST_CASE("Transform isIdentity", "[Transform]") {
     jtx::Mat4 m{1.0f};
     jtx::Mat4 mInv{1.0f};
@@ -569,3 +689,26 @@ TEST_CASE("Transform lookAt", "[Transform]") {
     REQUIRE(mat1_inv.has_value());
     REQUIRE(mat1_inv.value().equals(mat2.getInverseMatrix(), T_EPS));
 }
+
+// Everything below is evaluated by the compiler, the REQUIREs only check it against the runtime path
+TEST_CASE("Transform constant evaluation", "[Transform]") {
+    constexpr jtx::Mat4 m = jtx::translate(1.0f, 2.0f, 3.0f) * jtx::scale(2.0f, 2.0f, 2.0f);
+    static_assert(m.data[0][0] == 2.0f && m.data[0][3] == 1.0f && m.data[2][3] == 3.0f && m.data[3][3] == 1.0f);
+    static_assert(m.applyToPoint(jtx::Point3f(1.0f, 1.0f, 1.0f)) == jtx::Point3f(3.0f, 4.0f, 5.0f));
+
+    constexpr jtx::Transform t = jtx::Transform::translate(1.0f, 2.0f, 3.0f) * jtx::Transform::rotateZ(1.0f, 0.0f);
+    static_assert(t.applyToPoint(jtx::Point3f(1.0f, 0.0f, 0.0f)) == jtx::Point3f(1.0f, 3.0f, 3.0f));
+    static_assert((t * t.inverse()).isIdentity());
+    static_assert(jtx::Transform::scale(2.0f, 4.0f, 8.0f).getInverseMatrix() == jtx::scale(0.5f, 0.25f, 0.125f));
+
+    // Matches the runtime composition bit for bit, including the error-free products in mul()
+    constexpr float s = 0.1f, c = 0.99498743710662f;
+    constexpr jtx::Mat4 r = jtx::rotateX(s, c) * jtx::rotateY(-s, c) * jtx::translate(0.3f, -0.7f, 1.1f);
+    volatile float vs = s, vc = c;
+    jtx::Mat4 rr = jtx::rotateX(vs, vc) * jtx::rotateY(-vs, vc) * jtx::translate(0.3f, -0.7f, 1.1f);
+    REQUIRE(r == rr);
+    REQUIRE(jtx::rotateX(90.0f).equals(jtx::rotateX(1.0f, 0.0f), T_EPS));
+
+    constexpr jtx::BBox3f b = jtx::BBox3f(jtx::Point3f(1, 2, 3), jtx::Point3f(-1, 0, 5)).merge(jtx::Point3f(0, 4, 0));
+    static_assert(b.pmin == jtx::Point3f(-1, 0, 0) && b.pmax == jtx::Point3f(1, 4, 5) && b.volume() == 40.0f);
+}
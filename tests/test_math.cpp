@@ -1,4 +1,5 @@
 #include <jtxlib/math/math.hpp>
+#include <jtxlib/math/vecmath.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "./tconstants.h"
@@ -16,4 +17,135 @@ TEST_CASE("Fast exp gives sames result as std::exp", "[Math]") {
     float result = jtx::fastExp(2.5f);
 
     REQUIRE_THAT(result, Catch::Matchers::WithinRel(ref, T_EPS));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Approx rsqrt is close to 1 / sqrt", "[Math]") {
+    for (float v: {1e-20f, 0.001f, 0.5f, 1.0f, 2.0f, 3.0f, 1234.5f, 1e20f}) {
+        float ref = 1 / std::sqrt(v);
+        REQUIRE(jtx::Rsqrt(v) == ref);
+        REQUIRE_THAT(jtx::Rsqrt<jtx::Approx>(v), Catch::Matchers::WithinRel(ref, 5e-7f));
+    }
+    REQUIRE(jtx::Rsqrt<jtx::Approx>(4.0) == 0.5);
+}
+
+TEST_CASE("Normalize and length precision policies", "[Math]") {
+    jtx::Vec3f v(3.0f, -4.0f, 12.0f);
+    REQUIRE(v.Length() == 13.0f);
+    REQUIRE_THAT(v.Length<jtx::Approx>(), Catch::Matchers::WithinRel(13.0f, 5e-7f));
+    REQUIRE(jtx::Normalize(v) == v / 13.0f);
+    REQUIRE(jtx::Normalize<jtx::Approx>(v).equals(v / 13.0f, 1e-6f));
+    REQUIRE(jtx::Normalize<jtx::Approx>(jtx::Vec3f(0.0f)) == jtx::Vec3f(0.0f));
+    REQUIRE(jtx::Vec3f(0.0f).Length<jtx::Approx>() == 0.0f);
+
+    // Lengths keep the precision of the vector
+    jtx::Vec3d d(1.0, 1.0, 1.0);
+    REQUIRE(std::is_same_v<decltype(d.Length()), double>);
+    REQUIRE(d.Length() == std::sqrt(3.0));
+
+    jtx::Vec4f w(1.0f, 2.0f, 2.0f, 4.0f);
+    REQUIRE_THAT(jtx::Normalize<jtx::Approx>(w).len(), Catch::Matchers::WithinRel(1.0f, 1e-6f));
+    jtx::Vec2f u(3.0f, 4.0f);
+    REQUIRE(jtx::Normalize(u) == jtx::Vec2f(0.6f, 0.8f));
+
+    jtx::Frame f(jtx::Vec3f(1.0f, 0.01f, 0.0f), jtx::Vec3f(0.0f, 1.0f, 0.0f), jtx::Vec3f(0.02f, 0.0f, 1.01f));
+    for (const jtx::Frame &o: {f.orthonormalized(), f.orthonormalized<jtx::Approx>()}) {
+        REQUIRE_THAT(o.x.Length(), Catch::Matchers::WithinRel(1.0f, 1e-6f));
+        REQUIRE_THAT(o.z.Length(), Catch::Matchers::WithinRel(1.0f, 1e-6f));
+        REQUIRE_THAT(o.x.Dot(o.z), Catch::Matchers::WithinAbs(0.0f, 1e-6f));
+        REQUIRE_THAT(o.y.Length(), Catch::Matchers::WithinRel(1.0f, 1e-6f));
+    }
+}
+
+TEST_CASE("fma rounds once", "[Math]") {
+    // (1 + 2^-12)^2 = 1 + 2^-11 + 2^-24, a separate multiply rounds the last term away
+    float a = 1.0f + 0x1p-12f, c = 1.0f + 0x1p-11f;
+    REQUIRE(jtx::fma(a, a, -c) == 0x1p-24f);
+    REQUIRE(jtx::fma(3, 4, 5) == 17);
+
+    // Vector fma and mulAdd only fuse when the target has FMA
+#if defined(JTX_HAS_FAST_FMA)
+    REQUIRE(jtx::mulAdd(a, a, -c) == 0x1p-24f);
+    jtx::Vec3f v = jtx::fma(jtx::Vec3f(a), jtx::Vec3f(a), jtx::Vec3f(-c));
+    REQUIRE(v == jtx::Vec3f(0x1p-24f));
+#endif
+    REQUIRE(jtx::mulAdd(3, 4, 5) == 17);
+    REQUIRE(jtx::fma(jtx::Vec3f(1, 2, 3), jtx::Vec3f(2), jtx::Vec3f(1)) == jtx::Vec3f(3, 5, 7));
+
+    // So the error-free product recovers it
+    jtx::FloatEFT p = jtx::twoProd(a, a);
+    REQUIRE(p.v == c);
+    REQUIRE(p.err == 0x1p-24f);
+}
+
+TEST_CASE("Lerp hits its endpoints", "[Math]") {
+    REQUIRE(jtx::Lerp(0.1f, 0.7f, 0.0f) == 0.1f);
+    REQUIRE(jtx::Lerp(0.1f, 0.7f, 1.0f) == 0.7f);
+    REQUIRE(jtx::Lerp(2.0f, 4.0f, 0.5f) == 3.0f);
+
+    jtx::Vec3f a(0.1f, -3.0f, 1e6f), b(0.7f, 5.0f, -1e-6f);
+    REQUIRE(jtx::Lerp(a, b, 0.0f) == a);
+    REQUIRE(jtx::Lerp(a, b, 1.0f) == b);
+    REQUIRE(jtx::Lerp(jtx::Vec2f(0, 2), jtx::Vec2f(2, 4), 0.5f) == jtx::Vec2f(1, 3));
+    REQUIRE(jtx::Lerp(jtx::Vec4f(0, 2, 4, 6), jtx::Vec4f(2, 4, 6, 8), 0.5f) == jtx::Vec4f(1, 3, 5, 7));
+}
+
+TEST_CASE("Vector operators are component-wise", "[Math]") {
+    jtx::Vec2f a2(1, 2), b2(4, 8);
+    REQUIRE(a2 + b2 == jtx::Vec2f(5, 10));
+    REQUIRE(1.0f - a2 == jtx::Vec2f(0, -1));
+    REQUIRE(b2 / a2 == jtx::Vec2f(4, 4));
+    REQUIRE(-a2 == jtx::Vec2f(-1, -2));
+
+    jtx::Vec3i a3(1, 2, 3), b3(4, 5, 6);
+    REQUIRE(a3 * b3 == jtx::Vec3i(4, 10, 18));
+    REQUIRE(b3 - a3 == jtx::Vec3i(3));
+    REQUIRE(12 / a3 == jtx::Vec3i(12, 6, 4));
+    REQUIRE(a3 != b3);
+
+    jtx::Vec4f a4(1, 2, 3, 4);
+    a4 += 1.0f;
+    a4 *= jtx::Vec4f(2, 2, 2, 0.5f);
+    a4 /= 2.0f;
+    REQUIRE(a4 == jtx::Vec4f(2, 3, 4, 1.25f));
+    REQUIRE(a4++ == jtx::Vec4f(2, 3, 4, 1.25f));
+    REQUIRE(--a4 == jtx::Vec4f(2, 3, 4, 1.25f));
+}
+
+TEST_CASE("Rounding policies", "[Math]") {
+    // (1 + 2^-12)^2 - (1 + 2^-11) = 2^-24, which a plain product rounds away
+    constexpr float a = 1.0f + 0x1p-12f, c = 1.0f + 0x1p-11f;
+
+    jtx::Vec3f u(a, c, 0.0f), v(1.0f, a, 0.0f);
+    REQUIRE(jtx::Cross<jtx::Precise>(u, v) == jtx::Vec3f(0.0f, 0.0f, 0x1p-24f));
+    REQUIRE(u.cross<jtx::Precise>(v) == jtx::Cross<jtx::Precise>(u, v));
+    REQUIRE(jtx::Cross(u, v) == jtx::Cross<jtx::DefaultRounding>(u, v));
+    REQUIRE(jtx::Cross<jtx::Fast>(jtx::Vec3f(1, 0, 0), jtx::Vec3f(0, 1, 0)) == jtx::Vec3f(0, 0, 1));
+
+    REQUIRE(jtx::Dot<jtx::Precise>(jtx::Vec3f(a, -c, 0.0f), jtx::Vec3f(a, 1.0f, 2.0f)) == 0x1p-24f);
+    REQUIRE(jtx::Dot<jtx::Precise>(jtx::Vec2f(a, -c), jtx::Vec2f(a, 1.0f)) == 0x1p-24f);
+    REQUIRE(jtx::Dot<jtx::Precise>(jtx::Vec4f(a, -c, 0, 0), jtx::Vec4f(a, 1, 0, 0)) == 0x1p-24f);
+    REQUIRE(jtx::Dot<jtx::Fast>(jtx::Vec3i(1, 2, 3), jtx::Vec3i(4, 5, 6)) == 32);
+    REQUIRE(jtx::Dot<jtx::Precise>(jtx::Vec3i(1, 2, 3), jtx::Vec3i(4, 5, 6)) == 32);
+
+    static_assert(jtx::sumOfProducts<jtx::Precise>(a, a, -c, 1.0f) == 0x1p-24f);
+    static_assert(jtx::differenceOfProducts<jtx::Precise>(a, a, c, 1.0f) == 0x1p-24f);
+}
+
+TEST_CASE("Estrin and Horner polynomial evaluation agree", "[Math]") {
+    static_assert(jtx::evalPolynomialEstrin(2.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f) == 129.0f);
+    static_assert(jtx::evalPolynomial(2.0f, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f}) == 129.0f);
+    static_assert(jtx::evalPolynomialEstrin(3, {1, 1, 1}) == 13);
+    static_assert(jtx::evalPolynomialEstrin(0.5, 4.0) == 4.0);
+
+    for (int i = 0; i <= 100; ++i) {
+        float b = static_cast<float>(i) / 100.0f;
+        float horner = jtx::evalPolynomial(b, jtx::EQUAL_AREA_ATAN_COEFFS);
+        REQUIRE(horner == jtx::evalPolynomial(b, jtx::EQUAL_AREA_ATAN_COEFFS[0], jtx::EQUAL_AREA_ATAN_COEFFS[1],
+                                              jtx::EQUAL_AREA_ATAN_COEFFS[2], jtx::EQUAL_AREA_ATAN_COEFFS[3],
+                                              jtx::EQUAL_AREA_ATAN_COEFFS[4], jtx::EQUAL_AREA_ATAN_COEFFS[5],
+                                              jtx::EQUAL_AREA_ATAN_COEFFS[6]));
+        REQUIRE_THAT(jtx::evalPolynomialEstrin(b, jtx::EQUAL_AREA_ATAN_COEFFS),
+                     Catch::Matchers::WithinAbs(horner, 1e-7f));
+        REQUIRE_THAT(horner, Catch::Matchers::WithinAbs(std::atan(b) * 2 / jtx::JTX_PI, 1e-5));
+    }
+}
@@ -0,0 +1,71 @@
+#include <jtxlib/util/profiler.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace jtx;
+
+static std::string readAll(FILE *f) {
+    std::rewind(f);
+    std::string out;
+    char buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    return out;
+}
+
+static size_t countOccurrences(const std::string &s, const std::string &pattern) {
+    size_t count = 0;
+    for (size_t pos = s.find(pattern); pos != std::string::npos; pos = s.find(pattern, pos + 1)) ++count;
+    return count;
+}
+
+TEST_CASE("Profiler chrome trace", "[Profiler]") {
+    clearProfile();
+    uint32_t outer = registerProfileName("Outer \"scope\"");
+    uint32_t inner = registerProfileName("Inner");
+    REQUIRE(registerProfileName("Inner") == inner);
+    REQUIRE(outer != inner);
+
+    std::thread worker([&] {
+        ProfileScope a(outer);
+        for (int i = 0; i < 3; ++i) ProfileScope b(inner);
+    });
+    worker.join();
+
+    FILE *f = std::tmpfile();
+    REQUIRE(writeChromeTrace(f));
+    std::string json = readAll(f);
+    std::fclose(f);
+
+    REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(countOccurrences(json, "\"name\":\"Inner\"") == 3);
+    REQUIRE(countOccurrences(json, "\"name\":\"Outer \\\"scope\\\"\"") == 1);
+    REQUIRE(countOccurrences(json, "\"ph\":\"X\"") == 4);
+}
+
+TEST_CASE("Profiler ring buffer keeps latest records", "[Profiler]") {
+    clearProfile();
+    uint32_t id = registerProfileName("Ring");
+    for (size_t i = 0; i < PROFILE_BUFFER_CAPACITY + 10; ++i) ProfileScope s(id);
+
+    FILE *f = std::tmpfile();
+    REQUIRE(writeBinaryTrace(f));
+    std::string bin = readAll(f);
+    std::fclose(f);
+
+    REQUIRE(bin.substr(0, 4) == "JTXP");
+    // This thread's buffer holds exactly PROFILE_BUFFER_CAPACITY records
+    REQUIRE(bin.size() >= PROFILE_BUFFER_CAPACITY * sizeof(ProfileRecord));
+
+#ifdef JTXLIB_ENABLE_PROFILING
+    clearProfile();
+    { JTX_PROFILE_SCOPE("Macro"); }
+    f = std::tmpfile();
+    REQUIRE(writeChromeTrace(f));
+    REQUIRE(readAll(f).find("\"name\":\"Macro\"") != std::string::npos);
+    std::fclose(f);
+#endif
+}
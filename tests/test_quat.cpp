@@ -149,4 +149,22 @@ TEST_CASE("Quaternion scalar division assignment operator", "[Quaternion]") {
     REQUIRE(q.v.x == 1.0f);
     REQUIRE(q.v.y == 2.0f);
     REQUIRE(q.v.z == 3.0f);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Quaternion normalization policies", "[Quaternion]") {
+    jtx::Quaternion q{1.0f, jtx::Vec3f{2.0f, -2.0f, 4.0f}};
+    REQUIRE(q.len() == 5.0f);
+    REQUIRE(jtx::Normalize(q).equals({0.2f, jtx::Vec3f{0.4f, -0.4f, 0.8f}}, 1e-7f));
+    REQUIRE(jtx::Normalize<jtx::Approx>(q).equals(jtx::Normalize(q), 1e-6f));
+
+    q.normalize<jtx::Approx>();
+    REQUIRE_THAT(q.len(), Catch::Matchers::WithinRel(1.0f, 1e-6f));
+}
+
+TEST_CASE("Quaternion constant evaluation", "[Quaternion]") {
+    constexpr jtx::Quaternion q(0.5f, 0.5f, 0.5f, 0.5f);
+    static_assert(q * q.conjugate() == jtx::Quaternion());
+    static_assert(q * q.inverse() == jtx::Quaternion());
+    static_assert(jtx::Quaternion::pure({1, 0, 0}) * jtx::Quaternion::pure({0, 1, 0}) == jtx::Quaternion(0, 0, 0, 1));
+    REQUIRE(q.dot(q) == 1.0f);
+}
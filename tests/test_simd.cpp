@@ -0,0 +1,358 @@
+#include <jtxlib/simd/simdmat4.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+using namespace jtx;
+
+// Runs with whichever backend the test target is compiled for, e.g. scalar for baseline builds
+using Width4 = std::integral_constant<int, 4>;
+using Width8 = std::integral_constant<int, 8>;
+using Width16 = std::integral_constant<int, 16>;
+
+template<int N>
+static SimdFloat<N> iota(float start, float step) {
+    alignas(64) float v[N];
+    for (int i = 0; i < N; ++i) v[i] = start + step * static_cast<float>(i);
+    return SimdFloat<N>::load(v);
+}
+
+TEMPLATE_TEST_CASE("SimdFloat arithmetic and functions", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+    using F = SimdFloat<N>;
+
+    F a = iota<N>(-3.75f, 0.5f);
+    F sum = a + 1.0f;
+    F prod = 2.0f * a;
+    F quot = a / 4.0f;
+    F f = fma(a, F(2.0f), F(1.0f));
+    F lo = min(a, 0.0f);
+    F ab = abs(a);
+    F fl = floor(a);
+    F ro = round(a);
+    F neg = -a;
+    for (int i = 0; i < N; ++i) {
+        REQUIRE(sum[i] == a[i] + 1.0f);
+        REQUIRE(prod[i] == 2.0f * a[i]);
+        REQUIRE(quot[i] == a[i] / 4.0f);
+        REQUIRE(f[i] == a[i] * 2.0f + 1.0f);
+        REQUIRE(lo[i] == std::min(a[i], 0.0f));
+        REQUIRE(ab[i] == std::abs(a[i]));
+        REQUIRE(fl[i] == std::floor(a[i]));
+        REQUIRE(ro[i] == std::nearbyint(a[i]));
+        REQUIRE(neg[i] == -a[i]);
+    }
+
+    F p = iota<N>(0.25f, 1.5f);
+    F r = rcp(p);
+    F rs = rsqrt(p);
+    F sq = sqrt(p);
+    for (int i = 0; i < N; ++i) {
+        REQUIRE(sq[i] == std::sqrt(p[i]));
+        REQUIRE_THAT(r[i], Catch::Matchers::WithinRel(1.0f / p[i], 1e-6f));
+        REQUIRE_THAT(rs[i], Catch::Matchers::WithinRel(1.0f / std::sqrt(p[i]), 1e-6f));
+    }
+}
+
+TEMPLATE_TEST_CASE("SimdMask comparisons and select", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+    using F = SimdFloat<N>;
+    using M = SimdMask<N>;
+
+    F a = iota<N>(0.0f, 1.0f);
+    M m = a < 2.0f;
+    REQUIRE(m.movemask() == 0b11);
+    REQUIRE((a >= 2.0f).movemask() == ((1 << N) - 4));
+    REQUIRE((~m).movemask() == ((1 << N) - 4));
+    REQUIRE((m | (a == 3.0f)).movemask() == 0b1011);
+    REQUIRE((m & (a > 0.0f)).movemask() == 0b10);
+    REQUIRE(m.any());
+    REQUIRE(!m.all());
+    REQUIRE(M(true).all());
+    REQUIRE(M().none());
+    REQUIRE(m[1]);
+    REQUIRE(!m[2]);
+
+    F s = select(m, a, F(-1.0f));
+    for (int i = 0; i < N; ++i) REQUIRE(s[i] == (i < 2 ? a[i] : -1.0f));
+}
+
+TEMPLATE_TEST_CASE("SimdInt operations and conversions", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+    using I = SimdInt<N>;
+    using F = SimdFloat<N>;
+
+    alignas(64) int32_t v[N];
+    for (int i = 0; i < N; ++i) v[i] = i - 2;
+    I a = I::load(v);
+
+    I sum = a + 3;
+    I prod = a * a;
+    I shl = a << 2;
+    I shr = a >> 1;
+    I x = (a & 6) | (a ^ 1);
+    I lo = min(a, 0);
+    I sel = select(a < 0, -a, a);
+    for (int i = 0; i < N; ++i) {
+        REQUIRE(sum[i] == v[i] + 3);
+        REQUIRE(prod[i] == v[i] * v[i]);
+        REQUIRE(shl[i] == v[i] * 4);
+        REQUIRE(shr[i] == (v[i] >> 1));
+        REQUIRE(x[i] == ((v[i] & 6) | (v[i] ^ 1)));
+        REQUIRE(lo[i] == std::min(v[i], 0));
+        REQUIRE(sel[i] == std::abs(v[i]));
+    }
+    REQUIRE((a == 0).movemask() == 1 << 2);
+    REQUIRE((a != 0).movemask() == ((1 << N) - 1 - (1 << 2)));
+    REQUIRE((a <= -2).movemask() == 1);
+
+    F f = toFloat(a) + 0.75f;
+    I t = toInt(f);
+    for (int i = 0; i < N; ++i) {
+        REQUIRE(f[i] == static_cast<float>(v[i]) + 0.75f);
+        REQUIRE(t[i] == static_cast<int32_t>(static_cast<float>(v[i]) + 0.75f));
+    }
+    REQUIRE(asInt(F(1.0f))[0] == 0x3F800000);
+    REQUIRE(asFloat(I(0x40000000))[0] == 2.0f);
+}
+
+TEMPLATE_TEST_CASE("SimdInt shifts and gathers", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+    using I = SimdInt<N>;
+    using F = SimdFloat<N>;
+
+    alignas(64) int32_t v[N], s[N];
+    for (int i = 0; i < N; ++i) {
+        v[i] = (i & 1) ? -1000 * i : 1000 * i + 7;
+        s[i] = i * 3;// reaches >= 32 for wide backends
+    }
+    I a = I::load(v), n = I::load(s);
+
+    I srl = shiftRightLogical(a, 4);
+    I vshl = a << n, vsra = a >> n, vsrl = shiftRightLogical(a, n);
+    I an = andnot(I(0xF), a);
+    for (int i = 0; i < N; ++i) {
+        auto u = static_cast<uint32_t>(v[i]);
+        REQUIRE(srl[i] == static_cast<int32_t>(u >> 4));
+        REQUIRE(vshl[i] == (s[i] < 32 ? static_cast<int32_t>(u << s[i]) : 0));
+        REQUIRE(vsra[i] == (v[i] >> std::min(s[i], 31)));
+        REQUIRE(vsrl[i] == (s[i] < 32 ? static_cast<int32_t>(u >> s[i]) : 0));
+        REQUIRE(an[i] == (v[i] & ~0xF));
+    }
+
+    I c = a;
+    c += 5;
+    c *= 2;
+    c ^= 3;
+    c <<= 1;
+    c >>= 2;
+    for (int i = 0; i < N; ++i) REQUIRE(c[i] == ((((v[i] + 5) * 2) ^ 3) << 1) >> 2);
+
+    alignas(64) float h[N];
+    for (int i = 0; i < N; ++i) h[i] = static_cast<float>(i) + (i & 1 ? 0.5f : -0.5f);
+    I r = roundToInt(F::load(h));
+    for (int i = 0; i < N; ++i) REQUIRE(r[i] == static_cast<int32_t>(std::nearbyint(h[i])));
+
+    // Reversed indices into a table, masked-off lanes use an out-of-range index that must not be read
+    float table[N];
+    int32_t itable[N];
+    alignas(64) int32_t idx[N];
+    for (int i = 0; i < N; ++i) {
+        table[i] = 10.0f * static_cast<float>(i);
+        itable[i] = -i;
+        idx[i] = (i % 3 == 0) ? 1 << 28 : N - 1 - i;
+    }
+    I gi = I::load(idx);
+    auto valid = gi < N;
+
+    F g = gather(table, select(valid, gi, I(0)));
+    F gm = gather(table, gi, valid, F(-1.0f));
+    I gmi = gather(itable, gi, valid, I(7));
+    for (int i = 0; i < N; ++i) {
+        bool on = i % 3 != 0;
+        REQUIRE(g[i] == (on ? table[idx[i]] : 0.0f));
+        REQUIRE(gm[i] == (on ? table[idx[i]] : -1.0f));
+        REQUIRE(gmi[i] == (on ? itable[idx[i]] : 7));
+    }
+}
+
+TEMPLATE_TEST_CASE("SimdVec4f transform", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+    Mat4 m = Mat4(1.0f);
+    m[0][3] = 2.0f;
+    m[1][1] = 3.0f;
+
+    SimdVec4f<N> v(iota<N>(0.0f, 1.0f), SimdFloat<N>(1.0f), SimdFloat<N>(2.0f), SimdFloat<N>(1.0f));
+    SimdVec4f<N> r = transformVec(v, m);
+    SimdVec3f<N> n = transformNormal(SimdVec3f<N>(v), m);
+    for (int i = 0; i < N; ++i) {
+        REQUIRE(r.x[i] == static_cast<float>(i) + 2.0f);
+        REQUIRE(r.y[i] == 3.0f);
+        REQUIRE(r.z[i] == 2.0f);
+        REQUIRE(r.w[i] == 1.0f);
+        REQUIRE(n.x[i] == static_cast<float>(i));
+    }
+}
+
+TEMPLATE_TEST_CASE("SimdVec AoS <-> SoA transposes", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+
+    std::vector<Vec3f> v3(N);
+    std::vector<Vec4f> v4(N);
+    for (int i = 0; i < N; ++i) {
+        auto f = static_cast<float>(i);
+        v3[i] = {f, 100.0f + f, 200.0f + f};
+        v4[i] = {f, 100.0f + f, 200.0f + f, 300.0f + f};
+    }
+
+    auto a = SimdVec3f<N>::load(v3.data());
+    auto b = SimdVec4f<N>::load(v4.data());
+    for (int i = 0; i < N; ++i) {
+        REQUIRE((a.x[i] == v3[i].x && a.y[i] == v3[i].y && a.z[i] == v3[i].z));
+        REQUIRE((b.x[i] == v4[i].x && b.y[i] == v4[i].y && b.z[i] == v4[i].z && b.w[i] == v4[i].w));
+    }
+
+    std::vector<Vec3f> out3(N);
+    std::vector<Vec4f> out4(N);
+    a.store(out3.data());
+    b.store(out4.data());
+    REQUIRE(out3 == v3);
+    REQUIRE(out4 == v4);
+
+    // Tails stay within count, the vectors are allocated exactly so ASan catches overruns
+    const size_t count = N - 1;
+    std::vector<Vec3f> tail3(v3.begin(), v3.begin() + count);
+    std::vector<Vec4f> tail4(v4.begin(), v4.begin() + count);
+    auto pa = SimdVec3f<N>::loadPartial(tail3.data(), count);
+    auto pb = SimdVec4f<N>::loadPartial(tail4.data(), count);
+    REQUIRE((pa.x[count] == 0.0f && pb.w[count] == 0.0f));
+    std::vector<Vec3f> tailOut3(count);
+    std::vector<Vec4f> tailOut4(count);
+    pa.storePartial(tailOut3.data(), count);
+    pb.storePartial(tailOut4.data(), count);
+    REQUIRE(tailOut3 == tail3);
+    REQUIRE(tailOut4 == tail4);
+
+    // Interleaved vertex data
+    struct Vertex {
+        Point3f p;
+        float u;
+        Vec4f c;
+    };
+    std::vector<Vertex> verts(count);
+    for (size_t i = 0; i < count; ++i) verts[i] = {v3[i], 0.5f, v4[i]};
+    auto sp = SimdVec3f<N>::loadStrided(&verts[0].p, sizeof(Vertex), count);
+    auto sc = SimdVec4f<N>::loadStrided(&verts[0].c, sizeof(Vertex), count);
+    for (size_t i = 0; i < count; ++i) {
+        REQUIRE((sp.x[i] == v3[i].x && sp.y[i] == v3[i].y && sp.z[i] == v3[i].z));
+        REQUIRE((sc.x[i] == v4[i].x && sc.w[i] == v4[i].w));
+    }
+    REQUIRE((sp.x[count] == 0.0f && sc.w[count] == 0.0f));
+}
+
+TEMPLATE_TEST_CASE("SimdVec3f geometric functions", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+    using V = SimdVec3f<N>;
+    using Catch::Matchers::WithinAbs;
+
+    std::vector<Vec3f> as(N), bs(N);
+    for (int i = 0; i < N; ++i) {
+        auto f = static_cast<float>(i);
+        as[i] = {f - 3.0f, 0.5f * f + 1.0f, (i & 1) ? -2.0f : 1.5f};
+        bs[i] = {0.25f * f, -1.0f, f - 5.0f};
+    }
+    as[0] = {};// Normalize keeps zero vectors
+
+    V a = V::load(as.data()), b = V::load(bs.data());
+    auto check = [](const V &v, int i, const Vec3f &expected) {
+        REQUIRE_THAT(v.x[i], WithinAbs(expected.x, 1e-5f));
+        REQUIRE_THAT(v.y[i], WithinAbs(expected.y, 1e-5f));
+        REQUIRE_THAT(v.z[i], WithinAbs(expected.z, 1e-5f));
+    };
+
+    SimdFloat<N> dot = Dot(a, b), len = a.Length();
+    V cross = Cross(a, b), norm = Normalize(a), lerp = Lerp(a, b, 0.25f);
+    V refl = reflect(a, Normalize(b)), refr = refract(Normalize(a), Normalize(b), 0.75f);
+    V ff = faceForward(b, a), ab = Abs(a), lo = min(a, b), hi = Max(a, b);
+    V sum = 2.0f * a + b / 4.0f - dot;
+    for (int i = 0; i < N; ++i) {
+        const Vec3f &va = as[i], &vb = bs[i];
+        REQUIRE_THAT(dot[i], WithinAbs(jtx::Dot(va, vb), 1e-5f));
+        REQUIRE_THAT(len[i], WithinAbs(va.Length(), 1e-5f));
+        check(cross, i, jtx::Cross(va, vb));
+        check(norm, i, jtx::Normalize(va));
+        check(lerp, i, jtx::Lerp(va, vb, 0.25f));
+        check(refl, i, jtx::reflect(va, jtx::Normalize(vb)));
+        if (i != 0) check(refr, i, jtx::refract(jtx::Normalize(va), jtx::Normalize(vb), 0.75f));
+        check(ff, i, jtx::faceForward(vb, va));
+        check(ab, i, jtx::Abs(va));
+        check(lo, i, jtx::min(va, vb));
+        check(hi, i, jtx::Max(va, vb));
+        check(sum, i, 2.0f * va + vb / 4.0f - jtx::Dot(va, vb));
+    }
+
+    V n = Normalize(b), s, t;
+    coordinateSystem(n, &s, &t);
+    for (int i = 0; i < N; ++i) {
+        Vec3f es, et;
+        jtx::coordinateSystem(jtx::Normalize(bs[i]), &es, &et);
+        check(s, i, es);
+        check(t, i, et);
+    }
+    REQUIRE_THAT(Dot(s, t)[N - 1], WithinAbs(0.0f, 1e-6f));
+    REQUIRE_THAT(Dot(s, n)[N - 1], WithinAbs(0.0f, 1e-6f));
+}
+
+TEMPLATE_TEST_CASE("SimdMat4 determinant, inverse and mul", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+
+    // A mix of rotations, scales, projections and one singular matrix per block
+    std::vector<Mat4> mats;
+    for (int i = 0; i < N; ++i) {
+        auto f = static_cast<float>(i);
+        Mat4 m = jtx::rotate(10.0f + 20.0f * f, Vec3f(1.0f, f, 2.0f)) * jtx::scale(1.0f + f, 2.0f, 0.5f) *
+                 jtx::translate(f, -1.0f, 3.0f);
+        if (i % 3 == 1) m = jtx::perspective(30.0f + f, 1.5f, 0.1f, 10.0f + f) * m;
+        mats.push_back(m);
+    }
+    mats[N - 2] = jtx::scale(1.0f, 0.0f, 1.0f);
+
+    SimdMat4<N> m = SimdMat4<N>::load(mats.data());
+    SimdMask<N> ok;
+    std::vector<Mat4> inv(N), prod(N);
+    inverse(m, &ok).store(inv.data());
+    mul(m, m).store(prod.data());
+    SimdFloat<N> det = determinant(m);
+
+    // Relative, the projections have large entries. The scalar reference's EFT helpers always use a fused fma,
+    // the SIMD version's only when built with FMA
+    auto near = [](const Mat4 &a, const Mat4 &b) {
+        for (int r = 0; r < 4; ++r) {
+            for (int c = 0; c < 4; ++c) {
+                if (std::abs(a[r][c] - b[r][c]) > 1e-5f * std::max(1.0f, std::abs(b[r][c]))) return false;
+            }
+        }
+        return true;
+    };
+
+    for (int i = 0; i < N; ++i) {
+        INFO(i);
+        REQUIRE_THAT(det[i], Catch::Matchers::WithinRel(mats[i].determinant(), 1e-4f) ||
+                             Catch::Matchers::WithinAbs(mats[i].determinant(), 1e-6f));
+        REQUIRE(near(prod[i], mats[i].mul(mats[i])));
+        auto ref = mats[i].inverse();
+        REQUIRE(ok[i] == ref.has_value());
+        if (ref) REQUIRE(near(inv[i], *ref));
+        else REQUIRE(inv[i].hasNaN());
+    }
+
+    // Partial loads pad with the identity, partial stores leave the rest alone
+    std::vector<Mat4> out(N, Mat4(2.0f));
+    inverse(SimdMat4<N>::loadPartial(mats.data(), 1)).storePartial(out.data(), 1);
+    REQUIRE(out[0].equals(*mats[0].inverse(), 1e-4f));
+    REQUIRE(out[1] == Mat4(2.0f));
+}
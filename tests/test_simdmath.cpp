@@ -0,0 +1,129 @@
+#include <jtxlib/math/math.hpp>
+#include <jtxlib/simd/simdmath.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+using namespace jtx;
+
+using Width4 = std::integral_constant<int, 4>;
+using Width8 = std::integral_constant<int, 8>;
+using Width16 = std::integral_constant<int, 16>;
+
+// Distance in ULPs between a result and the double-precision reference rounded to float
+static int64_t ulpDistance(float result, double reference) {
+    auto ordered = [](float f) {
+        int32_t i;
+        std::memcpy(&i, &f, sizeof(i));
+        return i < 0 ? -static_cast<int64_t>(i & 0x7FFFFFFF) : static_cast<int64_t>(i);
+    };
+    auto ref = static_cast<float>(reference);
+    if (std::isnan(ref) || std::isnan(result)) return std::isnan(ref) == std::isnan(result) ? 0 : INT64_MAX;
+    return std::abs(ordered(result) - ordered(ref));
+}
+
+// Max ULP error of fn against ref over random inputs in [lo, hi]
+template<int N, typename Fn, typename Ref>
+static int64_t maxUlp(float lo, float hi, Fn fn, Ref ref) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(lo, hi);
+    int64_t worst = 0;
+    for (int it = 0; it < 20000 / N; ++it) {
+        alignas(64) float x[N], y[N];
+        for (int i = 0; i < N; ++i) x[i] = dist(rng);
+        fn(SimdFloat<N>::load(x)).store(y);
+        for (int i = 0; i < N; ++i) worst = std::max(worst, ulpDistance(y[i], ref(static_cast<double>(x[i]))));
+    }
+    return worst;
+}
+
+TEMPLATE_TEST_CASE("SIMD exp, log and pow", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+    using F = SimdFloat<N>;
+
+    REQUIRE(maxUlp<N>(-87.0f, 88.0f, [](F x) { return exp(x); }, [](double x) { return std::exp(x); }) <= 1);
+    REQUIRE(maxUlp<N>(-103.0f, -88.0f, [](F x) { return exp(x); }, [](double x) { return std::exp(x); }) <= 1);
+    REQUIRE(maxUlp<N>(1e-6f, 1e6f, [](F x) { return log(x); }, [](double x) { return std::log(x); }) <= 1);
+    REQUIRE(maxUlp<N>(0.5f, 2.0f, [](F x) { return log(x); }, [](double x) { return std::log(x); }) <= 1);
+    REQUIRE(maxUlp<N>(0.0f, 10.0f, [](F x) { return pow(x, 2.2f); },
+                      [](double x) { return std::pow(x, static_cast<double>(2.2f)); }) <= 16);
+
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    REQUIRE(exp(F(-inf))[0] == 0.0f);
+    REQUIRE(exp(F(inf))[0] == inf);
+    REQUIRE(exp(F(100.0f))[0] == inf);
+    REQUIRE(std::isnan(exp(F(NAN))[0]));
+    REQUIRE(log(F(0.0f))[0] == -inf);
+    REQUIRE(log(F(inf))[0] == inf);
+    REQUIRE(log(F(1e-42f))[0] == std::log(1e-42f));
+    REQUIRE(std::isnan(log(F(-1.0f))[0]));
+
+    REQUIRE(pow(F(-2.0f), 3.0f)[0] == -8.0f);
+    REQUIRE(pow(F(-2.0f), 2.0f)[0] == 4.0f);
+    REQUIRE(std::isnan(pow(F(-2.0f), 0.5f)[0]));
+    REQUIRE(pow(F(0.0f), 0.0f)[0] == 1.0f);
+    REQUIRE(pow(F(0.0f), -1.0f)[0] == inf);
+    REQUIRE(pow(F(-0.0f), -1.0f)[0] == -inf);
+    REQUIRE(pow(F(1.0f), F(NAN))[0] == 1.0f);
+}
+
+TEMPLATE_TEST_CASE("SIMD polynomial evaluation", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+    using F = SimdFloat<N>;
+
+    alignas(64) float x[N], horner[N], estrin[N], twoToF[N];
+    for (int i = 0; i < N; ++i) x[i] = static_cast<float>(i) / N;
+    F t = F::load(x);
+    evalPolynomial(t, EQUAL_AREA_ATAN_COEFFS).store(horner);
+    evalPolynomialEstrin(t, EQUAL_AREA_ATAN_COEFFS).store(estrin);
+    evalPolynomialEstrin(t, 1.0f, 0.695556856f, 0.226173572f, 0.0781455737f).store(twoToF);
+
+    for (int i = 0; i < N; ++i) {
+        // Same operations as the scalar versions, so identical whenever both sides fuse
+#if defined(JTX_HAS_FAST_FMA)
+        if constexpr (F::fusedFma) {
+            REQUIRE(horner[i] == jtx::evalPolynomial(x[i], EQUAL_AREA_ATAN_COEFFS));
+            REQUIRE(estrin[i] == jtx::evalPolynomialEstrin(x[i], EQUAL_AREA_ATAN_COEFFS));
+            REQUIRE(twoToF[i] == jtx::evalPolynomialEstrin(x[i], 1.0f, 0.695556856f, 0.226173572f, 0.0781455737f));
+        }
+#endif
+        REQUIRE(std::abs(estrin[i] - horner[i]) <= 1e-6f);
+        REQUIRE(std::abs(twoToF[i] - std::exp2(x[i])) <= 2e-4f);
+    }
+}
+
+TEMPLATE_TEST_CASE("SIMD trigonometric functions", "[Simd]", Width4, Width8, Width16) {
+    constexpr int N = TestType::value;
+    using F = SimdFloat<N>;
+
+    // See simdmath.hpp for the bounds without a fused fma
+    constexpr int64_t trigUlp = F::fusedFma ? 2 : 256;
+    REQUIRE(maxUlp<N>(-8192.0f, 8192.0f, [](F x) { return sin(x); }, [](double x) { return std::sin(x); }) <= trigUlp);
+    REQUIRE(maxUlp<N>(-8192.0f, 8192.0f, [](F x) { return cos(x); }, [](double x) { return std::cos(x); }) <= trigUlp);
+    REQUIRE(maxUlp<N>(-4.0f, 4.0f, [](F x) { return sin(x); }, [](double x) { return std::sin(x); }) <= 2);
+    REQUIRE(maxUlp<N>(-1.0f, 1.0f, [](F x) { return asin(x); }, [](double x) { return std::asin(x); }) <= 2);
+    REQUIRE(maxUlp<N>(-1.0f, 1.0f, [](F x) { return acos(x); }, [](double x) { return std::acos(x); }) <= 1);
+    REQUIRE(maxUlp<N>(-10.0f, 10.0f, [](F x) { return atan2(x, F(1.0f) - x); },
+                      [](double x) { return std::atan2(x, static_cast<double>(1.0f - static_cast<float>(x))); }) <= 3);
+
+    F s, c;
+    sincos(F(-0.0f), &s, &c);
+    REQUIRE((s[0] == 0.0f && std::signbit(s[0])));
+    REQUIRE(c[0] == 1.0f);
+    REQUIRE(std::isnan(sin(F(INFINITY))[0]));
+    REQUIRE(std::isnan(acos(F(1.5f))[0]));
+
+    // Quadrants and signed zeros
+    const float ys[] = {0.0f, -0.0f, 1.0f, -1.0f, 0.0f, INFINITY, -INFINITY, 3.0f};
+    const float xs[] = {0.0f, -0.0f, -1.0f, -1.0f, -2.0f, INFINITY, -INFINITY, 0.0f};
+    for (int i = 0; i < 8; ++i) {
+        float r = atan2(F(ys[i]), F(xs[i]))[0];
+        REQUIRE(ulpDistance(r, std::atan2(static_cast<double>(ys[i]), static_cast<double>(xs[i]))) <= 1);
+        REQUIRE(std::signbit(r) == std::signbit(std::atan2(ys[i], xs[i])));
+    }
+}
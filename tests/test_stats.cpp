@@ -0,0 +1,81 @@
+#include <jtxlib/util/stats.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace jtx;
+
+JTX_STAT_COUNTER("Test/Counter", testCounter);
+JTX_STAT_MEMORY_COUNTER("Test/Memory", testMemory);
+JTX_STAT_PERCENT("Test/Percent", testHits, testTests);
+JTX_STAT_INT_DISTRIBUTION("Test/Distribution", testDist);
+
+// Prints into a temporary file and returns the report
+static std::string captureStats() {
+    FILE *f = std::tmpfile();
+    printStats(f);
+    std::rewind(f);
+    std::string out;
+    char buf[256];
+    while (std::fgets(buf, sizeof(buf), f)) out += buf;
+    std::fclose(f);
+    return out;
+}
+
+TEST_CASE("Stats merge on demand", "[Stats]") {
+    clearStats();
+    testCounter += 5;
+    testMemory += 2048;
+    ++testHits;
+    testTests += 4;
+    JTX_STAT_REPORT_VALUE(testDist, 2);
+    JTX_STAT_REPORT_VALUE(testDist, 8);
+
+    std::string report = captureStats();
+    REQUIRE(testCounter == 0);
+    REQUIRE(report.find("Test\n") != std::string::npos);
+    REQUIRE(report.find("Counter") != std::string::npos);
+    REQUIRE(report.find("2.00 kB") != std::string::npos);
+    REQUIRE(report.find("(25.00%)") != std::string::npos);
+    REQUIRE(report.find("5.000 avg [range 2 - 8]") != std::string::npos);
+}
+
+TEST_CASE("Stats merge at thread exit", "[Stats]") {
+    clearStats();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < 1000; ++i) ++testCounter;
+            JTX_STAT_REPORT_VALUE(testDist, t);
+        });
+    }
+    for (auto &t: threads) t.join();
+
+    std::string report = captureStats();
+    REQUIRE(report.find("4000") != std::string::npos);
+    REQUIRE(report.find("1.500 avg [range 0 - 3]") != std::string::npos);
+    REQUIRE(report.find("Memory") == std::string::npos);
+}
+
+TEST_CASE("Stats merge from detached threads", "[Stats]") {
+    clearStats();
+    std::atomic<int> exited{0};
+    for (int t = 0; t < 2; ++t) {
+        std::thread([&exited] {
+            // Constructed before the statistic, so it's destroyed after the thread's stats were merged
+            struct OnExit {
+                std::atomic<int> *count;
+                ~OnExit() { ++*count; }
+            };
+            thread_local OnExit onExit{nullptr};
+            onExit.count = &exited;
+            testMemory += 1024;
+        }).detach();
+    }
+    while (exited.load() < 2) std::this_thread::yield();
+
+    REQUIRE(captureStats().find("2.00 kB") != std::string::npos);
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <jtxlib/util/taggedptr.hpp>
+#include <thread>
+#include <vector>
 
 // Simple CRTP class to test tagged pointer dispatch
 using namespace jtx;
@@ -70,4 +72,101 @@ TEST_CASE("TaggedPtr dispatch", "[TaggedPtr]") {
     auto i = ptr.dispatch(code);
     REQUIRE(i == 1);
   }
-}
\ No newline at end of file
+}
+
+struct alignas(16) StackNode {
+  StackNode *next = nullptr;
+  int value = 0;
+};
+
+// Treiber stack, the main use case for AtomicTaggedPtr
+struct TestStack {
+  AtomicTaggedPtr<StackNode> head;
+
+  void push(StackNode *n) {
+    auto old = head.load(std::memory_order_relaxed);
+    do {
+      n->next = old.ptr();
+    } while (!head.compare_exchange_weak(old, n, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  StackNode *pop() {
+    auto old = head.load(std::memory_order_acquire);
+    while (old.ptr() && !head.compare_exchange_weak(old, old.ptr()->next, std::memory_order_acquire, std::memory_order_acquire)) {}
+    return old.ptr();
+  }
+};
+
+TEST_CASE("AtomicTaggedPtr packing", "[AtomicTaggedPtr]") {
+  StackNode a, b;
+  AtomicTaggedPtr<StackNode> ptr{&a};
+
+  SECTION("Version bits") {
+    REQUIRE(AtomicTaggedPtr<StackNode>::LOW_BITS == 4);
+    REQUIRE(AtomicTaggedPtr<StackNode>::VERSION_BITS == 11);
+    REQUIRE(ptr.is_lock_free());
+  }
+
+  SECTION("Load returns pointer and version 0") {
+    auto v = ptr.load();
+    REQUIRE(v.ptr() == &a);
+    REQUIRE(v.version() == 0);
+  }
+
+  SECTION("Successful CAS bumps version") {
+    auto v = ptr.load();
+    REQUIRE(ptr.compare_exchange_strong(v, &b));
+    auto n = ptr.load();
+    REQUIRE(n.ptr() == &b);
+    REQUIRE(n.version() == 1);
+  }
+
+  SECTION("Version carries from low bits into high bits") {
+    for (int i = 0; i < 40; ++i) ptr.store(i % 2 ? &a : &b);
+    auto v = ptr.load();
+    REQUIRE(v.ptr() == &a);
+    REQUIRE(v.version() == 40);
+  }
+
+  SECTION("ABA: stale snapshot fails even if the pointer matches") {
+    auto stale = ptr.load();
+    ptr.store(&b);
+    ptr.store(&a);
+    REQUIRE(ptr.load().ptr() == stale.ptr());
+    REQUIRE_FALSE(ptr.compare_exchange_strong(stale, &b));
+    REQUIRE(stale.version() == 2);
+    REQUIRE(ptr.compare_exchange_strong(stale, &b));
+  }
+}
+
+TEST_CASE("AtomicTaggedPtr concurrent stack", "[AtomicTaggedPtr]") {
+  constexpr int numThreads = 4;
+  constexpr int numNodes = 256;
+  constexpr int numIters = 10000;
+
+  std::vector<StackNode> nodes(numNodes);
+  TestStack stack;
+  for (int i = 0; i < numNodes; ++i) {
+    nodes[i].value = i;
+    stack.push(&nodes[i]);
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < numIters; ++i) {
+        if (StackNode *n = stack.pop()) stack.push(n);
+      }
+    });
+  }
+  for (auto &t : threads) t.join();
+
+  std::vector<bool> seen(numNodes, false);
+  int count = 0;
+  while (StackNode *n = stack.pop()) {
+    REQUIRE_FALSE(seen[n->value]);
+    seen[n->value] = true;
+    ++count;
+  }
+  REQUIRE(count == numNodes);
+}
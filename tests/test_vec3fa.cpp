@@ -0,0 +1,95 @@
+#include <jtxlib/simd/vec3fa.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace jtx;
+
+// Bit-exact against the scalar Fast path unless the compiler can contract its products into fmas
+static bool sameRounding(float simd, float scalar) {
+#if defined(__FMA__)
+    return std::abs(simd - scalar) <= 1e-5f * std::max(100.0f, std::abs(scalar));
+#else
+    return simd == scalar;
+#endif
+}
+
+static bool sameRounding(const Vec3f &simd, const Vec3f &scalar) {
+    return sameRounding(simd.x, scalar.x) && sameRounding(simd.y, scalar.y) && sameRounding(simd.z, scalar.z);
+}
+
+static Vec3f randomVec3(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    return {dist(rng), dist(rng), dist(rng)};
+}
+
+TEST_CASE("Vec3fA matches Vec3f", "[Vec3fA]") {
+    std::mt19937 rng(7);
+    for (int i = 0; i < 1000; ++i) {
+        Vec3f a = randomVec3(rng), b = randomVec3(rng);
+        Vec3fA va(a), vb(b);
+
+        REQUIRE(Vec3f(va) == a);
+        REQUIRE(va.x() == a.x);
+        REQUIRE(va[2] == a.z);
+
+        REQUIRE(Vec3f(va + vb) == a + b);
+        REQUIRE(Vec3f(va - vb) == a - b);
+        REQUIRE(Vec3f(va * vb) == a * b);
+        REQUIRE(Vec3f(va / vb) == a / b);
+        REQUIRE(Vec3f(va * 2.5f) == a * 2.5f);
+        REQUIRE(Vec3f(va / 3.0f) == a / 3.0f);
+        REQUIRE(Vec3f(-va) == -a);
+
+        // Same rounding as the scalar member functions
+        REQUIRE(sameRounding(Dot(va, vb), a.Dot<jtx::Fast>(b)));
+        REQUIRE(sameRounding(Vec3f(Cross(va, vb)), a.cross<jtx::Fast>(b)));
+        REQUIRE(sameRounding(va.LengthSquared(), a.LengthSquared()));
+        REQUIRE(sameRounding(Length(va), a.Length()));
+        REQUIRE(sameRounding(Vec3f(Normalize(va)), Vec3f(a).Normalize()));
+        REQUIRE(Vec3f(Normalize<jtx::Approx>(va)).equals(Vec3f(a).Normalize(), 1e-6f));
+        REQUIRE_THAT(Length<jtx::Approx>(va), Catch::Matchers::WithinRel(a.Length(), 1e-6f));
+
+        REQUIRE(Vec3f(Min(va, vb)) == Vec3f(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)));
+        REQUIRE(Vec3f(Abs(-va)) == Vec3f(std::abs(a.x), std::abs(a.y), std::abs(a.z)));
+    }
+
+    REQUIRE(Vec3f(Vec3fA()) == Vec3f(0.0f));
+    REQUIRE(Normalize(Vec3fA()) == Vec3fA());
+    REQUIRE(Length<jtx::Approx>(Vec3fA()) == 0.0f);
+    REQUIRE(Cross(Vec3fA(1, 0, 0), Vec3fA(0, 1, 0)) == Vec3fA(0, 0, 1));
+}
+
+TEST_CASE("Vec3fA ignores the padding lane", "[Vec3fA]") {
+    Vec3fA a(1, 2, 3), b(4, 5, 6);
+    a.v[3] = 100.0f;
+    b.v[3] = -7.0f;
+    REQUIRE(Dot(a, b) == 32.0f);
+    REQUIRE(a.LengthSquared() == 14.0f);
+    REQUIRE(Cross(a, b) == Vec3fA(-3, 6, -3));
+    REQUIRE(a == Vec3fA(1, 2, 3));
+    REQUIRE(Vec3f(a / Vec3fA()) == Vec3f(1.0f / 0.0f));
+}
+
+TEST_CASE("Vec4fA", "[Vec3fA]") {
+    Vec4f a(1, -2, 3, 0.5f), b(4, 5, -6, 2);
+    Vec4fA va(a), vb(b);
+
+    REQUIRE(Vec4f(va) == a);
+    REQUIRE(va.w() == 0.5f);
+    REQUIRE(Vec4f(va + vb) == a + b);
+    REQUIRE(Vec4f(va * vb) == a * b);
+    REQUIRE(Vec4f(va / 2.0f) == a / 2.0f);
+    REQUIRE(Dot(va, vb) == a.dot(b));
+    REQUIRE(va.lenSqr() == a.lenSqr());
+    REQUIRE(Length(va) == a.len());
+    REQUIRE(Vec4f(Normalize(va)).equals(Vec4f(a).normalize(), 1e-6f));
+    REQUIRE(Normalize(Vec4fA()) == Vec4fA());
+
+    Vec4fA p(Vec3fA(1, 2, 3), 1.0f);
+    REQUIRE(p == Vec4fA(1, 2, 3, 1));
+    REQUIRE(p.xyz() == Vec3fA(1, 2, 3));
+}